@@ -0,0 +1,6 @@
+// Print 1M lines, run with the output redirected to a file or a pipe.
+const count = 1000000;
+
+const name = 'item';
+for (let i = 0; i < count; ++i)
+  console.log(name, i, 'value');
@@ -0,0 +1,44 @@
+// Write about 100MB of JSON to a file, then read it back and parse it.
+import * as fs from 'node:fs';
+
+interface Point {
+  x: number;
+  y: number;
+}
+
+interface Item {
+  id: number;
+  name: string;
+  active: boolean;
+  tags: string[];
+  points: Point[];
+}
+
+const count = 450000;
+
+const items: Item[] = [];
+for (let i = 0; i < count; ++i) {
+  const points: Point[] = [];
+  for (let j = 0; j < 4; ++j)
+    points.push({x: i * 0.5 + j, y: j - i / 3});
+  items.push({
+    id: i,
+    name: `item "${i}"`,
+    active: i % 3 == 0,
+    tags: [ 'json', `tag${i % 100}` ],
+    points: points,
+  });
+}
+fs.writeFileSync('items.json', JSON.stringify(items));
+
+const parsed: Item[] = JSON.parse(fs.readFileSync('items.json', 'utf8'));
+let active = 0;
+let ordered = 0;
+for (const item of parsed) {
+  if (item.active)
+    active++;
+  if (item.points.length == 4 && item.points[3].x > item.points[0].x)
+    ordered++;
+}
+
+console.log(parsed.length, active, ordered);
@@ -0,0 +1,29 @@
+// Insert, look up and delete 10M number keys, and 1M string keys.
+const count = 10000000;
+
+const numbers = new Map<number, number>();
+for (let i = 0; i < count; ++i)
+  numbers.set(i * 7, i);
+let sum = 0;
+for (let i = 0; i < count; ++i) {
+  const value = numbers.get(i * 7);
+  if (value !== undefined)
+    sum += value;
+}
+for (let i = 0; i < count; i += 2)
+  numbers.delete(i * 7);
+let found = 0;
+for (let i = 0; i < count; ++i) {
+  if (numbers.has(i * 7))
+    found++;
+}
+
+const strings = new Set<string>();
+for (let i = 0; i < count / 10; ++i)
+  strings.add(`key${i}`);
+for (let i = 0; i < count / 10; ++i) {
+  if (strings.has(`key${i * 2}`))
+    found++;
+}
+
+console.log(sum, found, numbers.size, strings.size);
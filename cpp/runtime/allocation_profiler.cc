@@ -0,0 +1,145 @@
+#include "runtime/allocation_profiler.h"
+
+#if defined(COMPILETS_ALLOCATION_PROFILER)
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace compilets {
+
+namespace {
+
+struct AllocationStats {
+  size_t count = 0;
+  size_t bytes = 0;
+};
+
+using AllocationSite = std::pair<void*, const AllocationType*>;
+
+class AllocationProfiler {
+ public:
+  static AllocationProfiler* Get() {
+    // Leaked intentionally so the data outlives static destructors.
+    static AllocationProfiler* profiler = []() {
+      auto* p = new AllocationProfiler;
+      ::atexit(DumpAllocationProfile);
+      return p;
+    }();
+    return profiler;
+  }
+
+  void Record(const AllocationType* type, size_t size, void* site) {
+    AllocationStats& by_type = types_[type];
+    by_type.count++;
+    by_type.bytes += size;
+    AllocationStats& by_site = sites_[{site, type}];
+    by_site.count++;
+    by_site.bytes += size;
+  }
+
+  void Dump() {
+    if (dumped_)
+      return;
+    dumped_ = true;
+    WriteReport();
+    const char* path = ::getenv("COMPILETS_ALLOCATION_PROFILE");
+    WritePprof(path ? path : "compilets-allocations.heap");
+  }
+
+ private:
+  // Print allocations grouped by type and by site, largest first.
+  void WriteReport() {
+    std::vector<std::pair<const AllocationType*, AllocationStats>> types(
+        types_.begin(), types_.end());
+    std::sort(types.begin(), types.end(), [](const auto& a, const auto& b) {
+      return a.second.bytes > b.second.bytes;
+    });
+    AllocationStats total;
+    for (const auto& [type, stats] : types) {
+      total.count += stats.count;
+      total.bytes += stats.bytes;
+    }
+    fprintf(stderr, "Allocations by type: %zu objects, %zu bytes\n",
+            total.count, total.bytes);
+    fprintf(stderr, "%12s %14s  %s\n", "count", "bytes", "type");
+    for (const auto& [type, stats] : types) {
+      fprintf(stderr, "%12zu %14zu  %.*s\n", stats.count, stats.bytes,
+              static_cast<int>(type->name.size()), type->name.data());
+    }
+
+    std::vector<std::pair<AllocationSite, AllocationStats>> sites(
+        sites_.begin(), sites_.end());
+    std::sort(sites.begin(), sites.end(), [](const auto& a, const auto& b) {
+      return a.second.bytes > b.second.bytes;
+    });
+    fprintf(stderr, "\nAllocations by site:\n");
+    fprintf(stderr, "%12s %14s  %-18s  %s\n", "count", "bytes", "site", "type");
+    for (const auto& [site, stats] : sites) {
+      fprintf(stderr, "%12zu %14zu  %-18p  %.*s\n", stats.count, stats.bytes,
+              site.first,
+              static_cast<int>(site.second->name.size()),
+              site.second->name.data());
+    }
+  }
+
+  // Write the sites in the legacy heap profile format understood by pprof,
+  // e.g. "pprof --text ./app compilets-allocations.heap". Objects are never
+  // reported as freed so the in-use and allocated numbers are identical.
+  void WritePprof(const char* path) {
+    std::map<void*, AllocationStats> sites;
+    AllocationStats total;
+    for (const auto& [site, stats] : sites_) {
+      sites[site.first].count += stats.count;
+      sites[site.first].bytes += stats.bytes;
+      total.count += stats.count;
+      total.bytes += stats.bytes;
+    }
+    FILE* file = fopen(path, "w");
+    if (!file) {
+      fprintf(stderr, "Failed to write allocation profile to %s\n", path);
+      return;
+    }
+    fprintf(file, "heap profile: %zu: %zu [%zu: %zu] @ heapprofile\n",
+            total.count, total.bytes, total.count, total.bytes);
+    for (const auto& [site, stats] : sites) {
+      fprintf(file, "%zu: %zu [%zu: %zu] @ 0x%" PRIxPTR "\n",
+              stats.count, stats.bytes, stats.count, stats.bytes,
+              reinterpret_cast<uintptr_t>(site));
+    }
+    // pprof needs the memory mappings to symbolize the addresses.
+    fprintf(file, "\nMAPPED_LIBRARIES:\n");
+    std::ifstream maps("/proc/self/maps");
+    for (std::string line; std::getline(maps, line);)
+      fprintf(file, "%s\n", line.c_str());
+    fclose(file);
+    fprintf(stderr, "\nAllocation profile written to %s\n", path);
+  }
+
+  bool dumped_ = false;
+  std::unordered_map<const AllocationType*, AllocationStats> types_;
+  std::map<AllocationSite, AllocationStats> sites_;
+};
+
+}  // namespace
+
+void RecordAllocation(const AllocationType* type, size_t size, void* site) {
+  AllocationProfiler::Get()->Record(type, size, site);
+}
+
+void DumpAllocationProfile() {
+  AllocationProfiler::Get()->Dump();
+}
+
+}  // namespace compilets
+
+#endif  // defined(COMPILETS_ALLOCATION_PROFILER)
@@ -0,0 +1,75 @@
+#ifndef CPP_RUNTIME_ALLOCATION_PROFILER_H_
+#define CPP_RUNTIME_ALLOCATION_PROFILER_H_
+
+// The allocation profiler is only compiled in when the runtime is built with
+// the "compilets_allocation_profiler=true" GN arg, otherwise the macros below
+// expand to nothing and the allocation helpers are untouched.
+#if defined(COMPILETS_ALLOCATION_PROFILER)
+
+#include <stddef.h>
+
+#include <string_view>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define COMPILETS_RETURN_ADDRESS() _ReturnAddress()
+#define COMPILETS_NOINLINE __declspec(noinline)
+#else
+#define COMPILETS_RETURN_ADDRESS() __builtin_return_address(0)
+#define COMPILETS_NOINLINE __attribute__((noinline))
+#endif
+
+namespace compilets {
+
+// Identifies a C++ type being allocated, there is one instance per type.
+struct AllocationType {
+  std::string_view name;
+};
+
+// Extract the name of T from the compiler's pretty function name, so the
+// profiler does not depend on RTTI.
+template<typename T>
+constexpr std::string_view GetTypeName() {
+#if defined(_MSC_VER) && !defined(__clang__)
+  std::string_view name = __FUNCSIG__;
+  name.remove_prefix(name.find("GetTypeName<") + 12);
+  return name.substr(0, name.rfind(">(void)"));
+#else
+  // Clang: "... GetTypeName() [T = Foo]".
+  // GCC: "... GetTypeName() [with T = Foo; std::string_view = ...]".
+  std::string_view name = __PRETTY_FUNCTION__;
+  name.remove_prefix(name.find("T = ") + 4);
+  size_t end = name.find(';');
+  return name.substr(0, end != std::string_view::npos ? end : name.rfind(']'));
+#endif
+}
+
+template<typename T>
+inline const AllocationType* GetAllocationType() {
+  static const AllocationType type{GetTypeName<T>()};
+  return &type;
+}
+
+// Record an allocation of |size| bytes of |type| made at |site|, which is the
+// return address of the allocation helper.
+void RecordAllocation(const AllocationType* type, size_t size, void* site);
+
+// Write the report to stderr and the pprof profile to disk, this is called
+// automatically on exit.
+void DumpAllocationProfile();
+
+}  // namespace compilets
+
+#define COMPILETS_ALLOCATION_SITE COMPILETS_NOINLINE
+#define COMPILETS_RECORD_ALLOCATION(T, size) \
+  compilets::RecordAllocation(compilets::GetAllocationType<T>(), size, \
+                              COMPILETS_RETURN_ADDRESS())
+
+#else
+
+#define COMPILETS_ALLOCATION_SITE
+#define COMPILETS_RECORD_ALLOCATION(T, size)
+
+#endif  // defined(COMPILETS_ALLOCATION_PROFILER)
+
+#endif  // CPP_RUNTIME_ALLOCATION_PROFILER_H_
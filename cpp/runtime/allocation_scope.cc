@@ -0,0 +1,32 @@
+#include "runtime/allocation_scope.h"
+
+#include "cppgc/explicit-management.h"
+#include "cppgc/internal/logging.h"
+
+namespace compilets {
+
+namespace {
+
+AllocationScope* g_current_scope = nullptr;
+
+}  // namespace
+
+AllocationScope::AllocationScope() : parent_(g_current_scope) {
+  g_current_scope = this;
+}
+
+AllocationScope::~AllocationScope() {
+  // Scopes are always nested in blocks.
+  CPPGC_DCHECK(g_current_scope == this);
+  g_current_scope = parent_;
+  // Free in reverse order so the memory at the end of the linear allocation
+  // buffer can be reused directly.
+  cppgc::HeapHandle& heap_handle = State::Get()->GetHeapHandle();
+  for (auto it = objects_.rbegin(); it != objects_.rend(); ++it) {
+    Object* object = it->Get();
+    it->Clear();
+    cppgc::subtle::FreeUnreferencedObject(heap_handle, *object);
+  }
+}
+
+}  // namespace compilets
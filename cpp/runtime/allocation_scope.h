@@ -0,0 +1,41 @@
+#ifndef CPP_RUNTIME_ALLOCATION_SCOPE_H_
+#define CPP_RUNTIME_ALLOCATION_SCOPE_H_
+
+#include <vector>
+
+#include "cppgc/persistent.h"
+#include "runtime/object.h"
+
+namespace compilets {
+
+// Frees the tracked objects when the scope ends, instead of leaving them to
+// the next garbage collection.
+//
+// The objects are still allocated on the GC heap so they can reference and be
+// traced like any other object, the translator only tracks the objects that
+// are proven to be unreachable once the scope ends. In debug builds the freed
+// memory is zapped by cppgc so escaped references fail loudly.
+class AllocationScope {
+ public:
+  AllocationScope();
+  ~AllocationScope();
+
+  AllocationScope(const AllocationScope&) = delete;
+  AllocationScope& operator=(const AllocationScope&) = delete;
+
+  template<typename T>
+  T* Track(T* object) {
+    objects_.emplace_back(object);
+    return object;
+  }
+
+ private:
+  AllocationScope* parent_;
+  // Keep the objects alive until the scope ends, so a garbage collection in
+  // the middle can not free them twice.
+  std::vector<cppgc::Persistent<Object>> objects_;
+};
+
+}  // namespace compilets
+
+#endif  // CPP_RUNTIME_ALLOCATION_SCOPE_H_
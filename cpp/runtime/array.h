@@ -296,7 +296,10 @@ class Array<T, std::enable_if_t<HasCppgcMember<T>::value>> final
 
 // Helper to create the Array from literal.
 template<typename T>
-inline Array<T>* MakeArray(sane::vector<T> elements) {
+COMPILETS_ALLOCATION_SITE inline Array<T>* MakeArray(
+    sane::vector<T> elements) {
+  COMPILETS_RECORD_ALLOCATION(Array<T>,
+                              sizeof(Array<T>) + elements.size() * sizeof(T));
   return cppgc::MakeGarbageCollected<Array<T>>(GetAllocationHandle(),
                                                std::move(elements));
 }
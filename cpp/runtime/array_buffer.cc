@@ -0,0 +1,184 @@
+#include "runtime/array_buffer.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <cmath>
+#include <new>
+#include <stdexcept>
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#endif
+
+#include "runtime/type_traits.h"
+
+namespace compilets {
+
+namespace internal {
+
+// static
+std::shared_ptr<BackingStore> BackingStore::Allocate(size_t length) {
+  // Always allocate so data() is never null.
+  void* data = calloc(std::max<size_t>(length, 1), 1);
+  if (!data)
+    throw std::bad_alloc();
+  return std::shared_ptr<BackingStore>(
+      new BackingStore(static_cast<uint8_t*>(data), length, Kind::kAllocated));
+}
+
+// static
+std::shared_ptr<BackingStore> BackingStore::MapFile(int fd, size_t length) {
+#if defined(_WIN32)
+  return nullptr;
+#else
+  if (length == 0)
+    return nullptr;
+  void* data = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+                    0);
+  if (data == MAP_FAILED)
+    return nullptr;
+  // The file is usually read from the start to the end.
+  madvise(data, length, MADV_SEQUENTIAL);
+  return std::shared_ptr<BackingStore>(
+      new BackingStore(static_cast<uint8_t*>(data), length, Kind::kMapped));
+#endif
+}
+
+// static
+std::shared_ptr<BackingStore> BackingStore::Wrap(uint8_t* data,
+                                                 size_t length,
+                                                 Deleter deleter,
+                                                 void* hint) {
+  std::shared_ptr<BackingStore> store(
+      new BackingStore(data, length, Kind::kExternal));
+  store->deleter_ = deleter;
+  store->hint_ = hint;
+  return store;
+}
+
+BackingStore::BackingStore(uint8_t* data, size_t length, Kind kind)
+    : data_(data), length_(length), kind_(kind) {}
+
+BackingStore::~BackingStore() {
+  switch (kind_) {
+    case Kind::kAllocated:
+      free(data_);
+      break;
+    case Kind::kMapped:
+#if !defined(_WIN32)
+      munmap(data_, length_);
+#endif
+      break;
+    case Kind::kExternal:
+      if (deleter_)
+        deleter_(data_, length_, hint_);
+      break;
+  }
+}
+
+void BackingStore::Shrink(size_t length) {
+  if (kind_ != Kind::kAllocated || length >= length_)
+    return;
+  if (void* data = realloc(data_, std::max<size_t>(length, 1)))
+    data_ = static_cast<uint8_t*>(data);
+  length_ = length;
+}
+
+size_t ToByteLength(double length) {
+  if (!(length >= 0) || length > 9007199254740991 ||
+      std::floor(length) != length) {
+    throw std::range_error("Invalid array length");
+  }
+  return static_cast<size_t>(length);
+}
+
+uint8_t ToUint8(double value) {
+  if (!std::isfinite(value))
+    return 0;
+  return static_cast<int64_t>(std::fmod(std::trunc(value), 256)) & 0xFF;
+}
+
+}  // namespace internal
+
+namespace {
+
+// Resolve the relative index like Array.prototype.slice does.
+size_t ToRelativeIndex(double index, size_t size) {
+  if (std::isnan(index))
+    return 0;
+  if (index < 0)
+    return static_cast<size_t>(std::max(size + index, 0.0));
+  return static_cast<size_t>(std::min(index, static_cast<double>(size)));
+}
+
+}  // namespace
+
+ArrayBuffer::ArrayBuffer(std::shared_ptr<internal::BackingStore> store)
+    : byteLength(static_cast<double>(store->length())),
+      store_(std::move(store)) {}
+
+ArrayBuffer* ArrayBuffer::slice(double begin) {
+  return slice(begin, byteLength);
+}
+
+ArrayBuffer* ArrayBuffer::slice(double begin, double end) {
+  size_t first = ToRelativeIndex(begin, size());
+  size_t last = std::max(first, ToRelativeIndex(end, size()));
+  auto* result = MakeObject<ArrayBuffer>(last - first);
+  std::copy(data() + first, data() + last, result->data());
+  return result;
+}
+
+Uint8Array::Uint8Array(ArrayBuffer* buffer)
+    : Uint8Array(buffer, 0, buffer->byteLength) {}
+
+Uint8Array::Uint8Array(ArrayBuffer* buffer, double byteOffset)
+    : Uint8Array(buffer, byteOffset, buffer->byteLength - byteOffset) {}
+
+Uint8Array::Uint8Array(ArrayBuffer* buffer, double byteOffset, double length)
+    : buffer(buffer),
+      byteOffset(byteOffset),
+      byteLength(length),
+      length(length),
+      offset_(internal::ToByteLength(byteOffset)),
+      size_(internal::ToByteLength(length)) {
+  if (offset_ + size_ > buffer->size())
+    throw std::range_error("Invalid typed array length");
+}
+
+Uint8Array* Uint8Array::fill(double value) {
+  std::fill_n(data(), size(), internal::ToUint8(value));
+  return this;
+}
+
+Uint8Array* Uint8Array::subarray(double begin) {
+  return subarray(begin, length);
+}
+
+Uint8Array* Uint8Array::subarray(double begin, double end) {
+  auto [first, last] = GetRange(begin, end);
+  return MakeObject<Uint8Array>(buffer.Get(), offset_ + first, last - first);
+}
+
+void Uint8Array::Trace(cppgc::Visitor* visitor) const {
+  TraceMember(visitor, buffer);
+}
+
+std::pair<size_t, size_t> Uint8Array::GetRange(double begin,
+                                               double end) const {
+  size_t first = ToRelativeIndex(begin, size_);
+  return {first, std::max(first, ToRelativeIndex(end, size_))};
+}
+
+std::u16string ToStringImpl(Uint8Array* array) {
+  std::u16string result;
+  for (size_t i = 0; i < array->size(); ++i) {
+    if (i > 0)
+      result += u',';
+    result += ToStringImpl(static_cast<double>(array->data()[i]));
+  }
+  return result;
+}
+
+}  // namespace compilets
@@ -0,0 +1,219 @@
+#ifndef CPP_RUNTIME_ARRAY_BUFFER_H_
+#define CPP_RUNTIME_ARRAY_BUFFER_H_
+
+#include <stdint.h>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "runtime/object.h"
+
+namespace compilets {
+
+namespace internal {
+
+// The memory of array buffers, which is either allocated, mapped from a file,
+// or owned by others like the JavaScript engine.
+class BackingStore {
+ public:
+  // Called when the store is destroyed, for freeing memory owned by others.
+  using Deleter = void (*)(uint8_t* data, size_t length, void* hint);
+
+  // Allocate zero-filled memory.
+  static std::shared_ptr<BackingStore> Allocate(size_t length);
+  // Map the file with copy-on-write pages, returns nullptr if the file can
+  // not be mapped. The file descriptor can be closed after mapping.
+  static std::shared_ptr<BackingStore> MapFile(int fd, size_t length);
+  // Use the memory without copying, the |deleter| is called with |hint| when
+  // the store is destroyed.
+  static std::shared_ptr<BackingStore> Wrap(uint8_t* data,
+                                            size_t length,
+                                            Deleter deleter,
+                                            void* hint);
+
+  ~BackingStore();
+
+  BackingStore& operator=(const BackingStore&) = delete;
+  BackingStore(const BackingStore&) = delete;
+
+  uint8_t* data() const { return data_; }
+  size_t length() const { return length_; }
+  bool is_mapped() const { return kind_ == Kind::kMapped; }
+  Deleter deleter() const { return deleter_; }
+  void* hint() const { return hint_; }
+
+  // Shrink the allocated memory to |length|, which does nothing for mapped
+  // and wrapped memory.
+  void Shrink(size_t length);
+
+ private:
+  enum class Kind { kAllocated, kMapped, kExternal };
+
+  BackingStore(uint8_t* data, size_t length, Kind kind);
+
+  uint8_t* data_;
+  size_t length_;
+  Kind kind_;
+  Deleter deleter_ = nullptr;
+  void* hint_ = nullptr;
+};
+
+// Convert the number to a length, throws RangeError for invalid values.
+size_t ToByteLength(double length);
+
+// Convert the number like ToUint8 does, which wraps around.
+uint8_t ToUint8(double value);
+
+// Checked access to the elements of Uint8Array. Like JS, assigned numbers are
+// converted with ToUint8, writing out of range is ignored, and reading out of
+// range returns NaN, which is undefined converted to number.
+class ByteElements {
+ public:
+  // Returned for element access that is assigned to.
+  class Reference {
+   public:
+    explicit Reference(uint8_t* element) : element_(element) {}
+
+    operator double() const {
+      return element_ ? *element_ : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    Reference& operator=(double value) {
+      if (element_)
+        *element_ = ToUint8(value);
+      return *this;
+    }
+    Reference& operator=(const Reference& other) {
+      return *this = static_cast<double>(other);
+    }
+    Reference& operator+=(double value) { return *this = *this + value; }
+    Reference& operator-=(double value) { return *this = *this - value; }
+    Reference& operator*=(double value) { return *this = *this * value; }
+    Reference& operator/=(double value) { return *this = *this / value; }
+    Reference& operator++() { return *this += 1; }
+    Reference& operator--() { return *this -= 1; }
+    double operator++(int) {
+      double old = *this;
+      ++*this;
+      return old;
+    }
+    double operator--(int) {
+      double old = *this;
+      --*this;
+      return old;
+    }
+
+   private:
+    uint8_t* element_;
+  };
+
+  ByteElements(uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  Reference operator[](double index) const { return Reference(At(index)); }
+
+  double get(double index) const {
+    uint8_t* element = At(index);
+    return element ? *element : std::numeric_limits<double>::quiet_NaN();
+  }
+
+  size_t size() const { return size_; }
+
+ private:
+  // Return nullptr unless the index is an integer in range.
+  uint8_t* At(double index) const {
+    if (!(index >= 0 && index < size_) || std::trunc(index) != index)
+      return nullptr;
+    return data_ + static_cast<size_t>(index);
+  }
+
+  uint8_t* data_;
+  size_t size_;
+};
+
+}  // namespace internal
+
+// Fixed-length raw binary data.
+class ArrayBuffer final : public Object {
+ public:
+  // new ArrayBuffer(length)
+  template<typename N,
+           typename = std::enable_if_t<std::is_arithmetic_v<N>>>
+  explicit ArrayBuffer(N length)
+      : ArrayBuffer(internal::BackingStore::Allocate(
+            internal::ToByteLength(length))) {}
+
+  explicit ArrayBuffer(std::shared_ptr<internal::BackingStore> store);
+
+  ArrayBuffer* slice(double begin);
+  ArrayBuffer* slice(double begin, double end);
+
+  uint8_t* data() const { return store_->data(); }
+  size_t size() const { return store_->length(); }
+  const std::shared_ptr<internal::BackingStore>& store() const {
+    return store_;
+  }
+
+  double byteLength = 0;
+
+ private:
+  std::shared_ptr<internal::BackingStore> store_;
+};
+
+// A view of bytes in an ArrayBuffer.
+class Uint8Array : public Object {
+ public:
+  // new Uint8Array(length)
+  template<typename N,
+           typename = std::enable_if_t<std::is_arithmetic_v<N>>>
+  explicit Uint8Array(N length)
+      : Uint8Array(MakeObject<ArrayBuffer>(length)) {}
+
+  explicit Uint8Array(ArrayBuffer* buffer);
+  Uint8Array(ArrayBuffer* buffer, double byteOffset);
+  Uint8Array(ArrayBuffer* buffer, double byteOffset, double length);
+
+  Uint8Array* fill(double value);
+  Uint8Array* subarray(double begin);
+  Uint8Array* subarray(double begin, double end);
+
+  // Used for element access.
+  internal::ByteElements value() const { return {data(), size()}; }
+
+  uint8_t* data() const { return buffer->data() + offset_; }
+  size_t size() const { return size_; }
+  std::string_view view() const {
+    return {reinterpret_cast<const char*>(data()), size()};
+  }
+
+  void Trace(cppgc::Visitor* visitor) const override;
+
+  cppgc::Member<ArrayBuffer> buffer;
+  double byteOffset = 0;
+  double byteLength = 0;
+  double length = 0;
+
+ protected:
+  // Return the [begin, end) range of subarray, with negative numbers counted
+  // from the end.
+  std::pair<size_t, size_t> GetRange(double begin, double end) const;
+
+ private:
+  size_t offset_;
+  size_t size_;
+};
+
+// Convert ArrayBuffer to string.
+inline std::u16string ToStringImpl(ArrayBuffer* buffer) {
+  return u"[object ArrayBuffer]";
+}
+
+// Convert Uint8Array to string, which is the same with arrays.
+std::u16string ToStringImpl(Uint8Array* array);
+
+}  // namespace compilets
+
+#endif  // CPP_RUNTIME_ARRAY_BUFFER_H_
@@ -0,0 +1,27 @@
+#include "runtime/buffer.h"
+
+namespace compilets {
+
+namespace nodejs {
+
+// static
+Buffer* Buffer::alloc(double size) {
+  return MakeObject<Buffer>(size);
+}
+
+Buffer* Buffer::subarray(double begin) {
+  return subarray(begin, length);
+}
+
+Buffer* Buffer::subarray(double begin, double end) {
+  auto [first, last] = GetRange(begin, end);
+  return MakeObject<Buffer>(buffer.Get(), byteOffset + first, last - first);
+}
+
+String Buffer::toString() const {
+  return String::FromUTF8(view());
+}
+
+}  // namespace nodejs
+
+}  // namespace compilets
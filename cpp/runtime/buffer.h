@@ -0,0 +1,38 @@
+#ifndef CPP_RUNTIME_BUFFER_H_
+#define CPP_RUNTIME_BUFFER_H_
+
+#include <string>
+
+#include "runtime/array_buffer.h"
+#include "runtime/string.h"
+
+namespace compilets {
+
+namespace nodejs {
+
+// The Buffer of Node.js, which is a Uint8Array with more methods.
+class Buffer final : public Uint8Array {
+ public:
+  // Buffer.alloc(size)
+  static Buffer* alloc(double size);
+
+  using Uint8Array::Uint8Array;
+
+  // Unlike Uint8Array, the subarray of Buffer is also a Buffer.
+  Buffer* subarray(double begin);
+  Buffer* subarray(double begin, double end);
+
+  // Decode the bytes as UTF-8.
+  String toString() const;
+};
+
+}  // namespace nodejs
+
+// Buffers are converted to the decoded text.
+inline std::u16string ToStringImpl(nodejs::Buffer* buffer) {
+  return buffer->toString().value();
+}
+
+}  // namespace compilets
+
+#endif  // CPP_RUNTIME_BUFFER_H_
@@ -1 +1,229 @@
 #include "runtime/console.h"
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <charconv>
+#include <exception>
+
+#include "runtime/process.h"
+#include "simdutf/simdutf.h"
+
+namespace compilets {
+
+namespace internal {
+
+namespace {
+
+bool IsTerminal(int fd) {
+#if defined(_WIN32)
+  return _isatty(fd);
+#else
+  return isatty(fd);
+#endif
+}
+
+std::terminate_handler g_previous_terminate_handler = nullptr;
+
+// Uncaught exceptions end the process with std::terminate, which does not run
+// the destructors of static objects, so the output is flushed there.
+[[noreturn]] void FlushAndTerminate() {
+  OutputStream::Stdout().Flush();
+  if (g_previous_terminate_handler)
+    g_previous_terminate_handler();
+  abort();
+}
+
+}  // namespace
+
+// static
+OutputStream& OutputStream::Stdout() {
+  // Destroyed at exit, which flushes the remaining output.
+  static OutputStream stream(1, IsTerminal(1));
+  [[maybe_unused]] static bool installed = [] {
+    g_previous_terminate_handler = std::set_terminate(&FlushAndTerminate);
+    return true;
+  }();
+  return stream;
+}
+
+// static
+OutputStream& OutputStream::Stderr() {
+  // Like Node.js, writing to stderr is synchronous.
+  static OutputStream stream(2, true);
+  return stream;
+}
+
+OutputStream::OutputStream(int fd, bool line_buffered)
+    : fd_(fd), line_buffered_(line_buffered) {
+  buffer_.reserve(kBufferSize);
+}
+
+OutputStream::~OutputStream() {
+  Flush();
+}
+
+void OutputStream::Write(std::string_view str) {
+  if (buffer_.size() + str.size() > kBufferSize)
+    Flush();
+  buffer_.append(str);
+}
+
+void OutputStream::Write(std::u16string_view str) {
+  size_t length = simdutf::utf8_length_from_utf16(str.data(), str.size());
+  if (buffer_.size() + length > kBufferSize)
+    Flush();
+  size_t offset = buffer_.size();
+  buffer_.resize(offset + length);
+  simdutf::convert_utf16_to_utf8(str.data(), str.size(), &buffer_[offset]);
+}
+
+void OutputStream::Write(double value) {
+  char buffer[kNumberToCharsSize];
+  Write(std::string_view(buffer, NumberToChars(value, buffer)));
+}
+
+void OutputStream::Write(int64_t value) {
+  char buffer[24];
+  auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  Write(std::string_view(buffer, result.ptr - buffer));
+}
+
+void OutputStream::EndLine() {
+  buffer_.push_back('\n');
+  if (line_buffered_ || buffer_.size() >= kBufferSize)
+    Flush();
+}
+
+void OutputStream::Flush() {
+  const char* data = buffer_.data();
+  size_t remaining = buffer_.size();
+  while (remaining > 0) {
+#if defined(_WIN32)
+    int written = _write(fd_, data, static_cast<unsigned>(remaining));
+#else
+    ssize_t written = write(fd_, data, remaining);
+#endif
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      // Nothing can be done when the output is closed.
+      break;
+    }
+    data += written;
+    remaining -= written;
+  }
+  buffer_.clear();
+}
+
+}  // namespace internal
+
+namespace nodejs {
+
+namespace {
+
+// Print the duration like Node.js does, for example "1.5ms", "1.500s" and
+// "1:02.500 (m:ss.mmm)".
+void WriteDuration(internal::OutputStream& stream, double ms) {
+  char buffer[64];
+  int length;
+  if (ms >= 60 * 1000) {
+    int64_t minutes = static_cast<int64_t>(ms / (60 * 1000));
+    int64_t hours = minutes / 60;
+    double seconds = (ms - minutes * 60 * 1000) / 1000;
+    if (hours > 0) {
+      length = snprintf(buffer, sizeof(buffer),
+                        "%lld:%02lld:%06.3f (h:mm:ss.mmm)",
+                        static_cast<long long>(hours),
+                        static_cast<long long>(minutes % 60),
+                        seconds);
+    } else {
+      length = snprintf(buffer, sizeof(buffer), "%lld:%06.3f (m:ss.mmm)",
+                        static_cast<long long>(minutes), seconds);
+    }
+  } else if (ms >= 1000) {
+    length = snprintf(buffer, sizeof(buffer), "%.3fs", ms / 1000);
+  } else {
+    // Trailing zeros are removed for milliseconds.
+    length = snprintf(buffer, sizeof(buffer), "%.3f", ms);
+    while (buffer[length - 1] == '0')
+      --length;
+    if (buffer[length - 1] == '.')
+      --length;
+    buffer[length++] = 'm';
+    buffer[length++] = 's';
+  }
+  stream.Write(std::string_view(buffer, length));
+}
+
+void WriteWarning(std::string_view before,
+                  std::u16string_view label,
+                  std::string_view after) {
+  internal::OutputStream::Stdout().Flush();
+  internal::OutputStream& stream = internal::OutputStream::Stderr();
+  stream.Write(before);
+  stream.Write(label);
+  stream.Write(after);
+  stream.EndLine();
+}
+
+}  // namespace
+
+void Console::StartTimer(String label) {
+  auto it = std::find_if(timers_.begin(), timers_.end(), [&](const Timer& t) {
+    return t.label.value() == label.value();
+  });
+  if (it != timers_.end()) {
+    WriteWarning("Warning: Label '", label.value(),
+                 "' already exists for console.time()");
+    return;
+  }
+  timers_.push_back({std::move(label), internal::MonotonicNow()});
+}
+
+void Console::EndTimer(std::u16string_view label) {
+  std::optional<int64_t> start = FindTimer(label, "timeEnd", true);
+  if (!start)
+    return;
+  internal::OutputStream& stream = internal::OutputStream::Stdout();
+  WriteElapsed(stream, label, *start);
+  stream.EndLine();
+}
+
+std::optional<int64_t> Console::FindTimer(std::u16string_view label,
+                                          const char* method,
+                                          bool remove) {
+  auto it = std::find_if(timers_.begin(), timers_.end(), [&](const Timer& t) {
+    return t.label.value() == label;
+  });
+  if (it == timers_.end()) {
+    WriteWarning("Warning: No such label '", label,
+                 std::string("' for console.") + method + "()");
+    return std::nullopt;
+  }
+  int64_t start = it->start;
+  if (remove)
+    timers_.erase(it);
+  return start;
+}
+
+// static
+void Console::WriteElapsed(internal::OutputStream& stream,
+                           std::u16string_view label,
+                           int64_t start) {
+  stream.Write(label);
+  stream.Write(std::string_view(": "));
+  WriteDuration(stream, (internal::MonotonicNow() - start) / 1e6);
+}
+
+}  // namespace nodejs
+
+}  // namespace compilets
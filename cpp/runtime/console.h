@@ -1,19 +1,94 @@
 #ifndef CPP_RUNTIME_CONSOLE_H_
 #define CPP_RUNTIME_CONSOLE_H_
 
-#include <iostream>
+#include <stdint.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 #include "runtime/object.h"
 #include "runtime/string.h"
 
-namespace compilets::nodejs {
+namespace compilets {
+
+namespace internal {
+
+// Buffered UTF-8 writer of stdout or stderr.
+//
+// Values are transcoded straight into the buffer, which is written with one
+// syscall when it is full, when a line ends and the file is a terminal, and
+// when the process exits.
+class OutputStream {
+ public:
+  static OutputStream& Stdout();
+  static OutputStream& Stderr();
+
+  OutputStream(int fd, bool line_buffered);
+  ~OutputStream();
+
+  OutputStream& operator=(const OutputStream&) = delete;
+  OutputStream(const OutputStream&) = delete;
+
+  void Write(std::string_view str);
+  void Write(std::u16string_view str);
+  void Write(double value);
+  // Integers, which are BigInt values, are printed with all digits.
+  void Write(int64_t value);
+
+  template<typename T>
+  void WriteValue(const T& value) {
+    Visit([this]<typename U>(const U& arg) {
+      if constexpr (std::is_same_v<U, String>)
+        WriteString(arg);
+      else if constexpr (std::is_convertible_v<const U&, std::u16string_view>)
+        Write(std::u16string_view(arg));
+      else if constexpr (std::is_floating_point_v<U>)
+        Write(static_cast<double>(arg));
+      else if constexpr (std::is_integral_v<U> && !std::is_same_v<U, bool>)
+        Write(static_cast<int64_t>(arg));
+      else
+        Write(std::u16string_view(ToString(arg)));
+    }, value);
+  }
+
+  // Lazily decoded strings are copied as UTF-8 without decoding.
+  void WriteString(const String& str) {
+    if (const std::string* utf8 = str.undecoded_utf8())
+      Write(std::string_view(*utf8));
+    else
+      Write(std::u16string_view(str.value()));
+  }
+
+  // Finish a line, which is flushed immediately if the stream is line
+  // buffered.
+  void EndLine();
+
+  void Flush();
+
+  void set_line_buffered(bool line_buffered) {
+    line_buffered_ = line_buffered;
+  }
+
+ private:
+  static constexpr size_t kBufferSize = 64 * 1024;
+
+  int fd_;
+  bool line_buffered_;
+  std::string buffer_;
+};
+
+}  // namespace internal
+
+namespace nodejs {
 
 class Console : public Object {
  public:
   template<typename... Args>
   void log(Args&&... args) {
-    ((std::cout << ToString(std::forward<Args>(args)) << ' '), ...);
-    std::cout << std::endl;
+    Print(internal::OutputStream::Stdout(), std::forward<Args>(args)...);
   }
 
   template<typename... Args>
@@ -23,16 +98,92 @@ class Console : public Object {
 
   template<typename... Args>
   void error(Args&&... args) {
-    ((std::cerr << ToString(std::forward<Args>(args)) << ' '), ...);
-    std::cout << std::endl;
+    // Keep the order of messages when both streams go to the same file.
+    internal::OutputStream::Stdout().Flush();
+    Print(internal::OutputStream::Stderr(), std::forward<Args>(args)...);
   }
 
   template<typename... Args>
   void warn(Args&&... args) {
     error(std::forward<Args>(args)...);
   }
+
+  // Timers measured with the monotonic clock, only time() allocates.
+  void time() { StartTimer(String(kDefaultLabel)); }
+
+  template<typename T>
+  void time(const T& label) { StartTimer(String(label)); }
+
+  void timeEnd() { EndTimer(kDefaultLabel); }
+
+  template<typename T>
+  void timeEnd(const T& label) { EndTimer(ToLabel(label)); }
+
+  void timeLog() { LogTimer(kDefaultLabel); }
+
+  template<typename T, typename... Args>
+  void timeLog(const T& label, Args&&... args) {
+    LogTimer(ToLabel(label), args...);
+  }
+
+ private:
+  static constexpr char16_t kDefaultLabel[] = u"default";
+
+  struct Timer {
+    String label;
+    int64_t start;
+  };
+
+  static std::u16string_view ToLabel(const String& label) {
+    return label.value();
+  }
+
+  template<size_t N>
+  static std::u16string_view ToLabel(const char16_t (&label)[N]) {
+    return std::u16string_view(label, N - 1);
+  }
+
+  void StartTimer(String label);
+  void EndTimer(std::u16string_view label);
+
+  template<typename... Args>
+  void LogTimer(std::u16string_view label, const Args&... args) {
+    std::optional<int64_t> start = FindTimer(label, "timeLog", false);
+    if (!start)
+      return;
+    internal::OutputStream& stream = internal::OutputStream::Stdout();
+    WriteElapsed(stream, label, *start);
+    ((stream.Write(std::string_view(" ")), stream.WriteValue(args)), ...);
+    stream.EndLine();
+  }
+
+  // Return the start time of the timer, or print a warning if not found.
+  std::optional<int64_t> FindTimer(std::u16string_view label,
+                                   const char* method,
+                                   bool remove);
+  // Print "label: 1.234ms" without ending the line.
+  static void WriteElapsed(internal::OutputStream& stream,
+                           std::u16string_view label,
+                           int64_t start);
+
+  // Print arguments separated by spaces, like util.format does.
+  template<typename Arg, typename... Args>
+  static void Print(internal::OutputStream& stream,
+                    Arg&& arg, Args&&... args) {
+    stream.WriteValue(arg);
+    ((stream.Write(std::string_view(" ")), stream.WriteValue(args)), ...);
+    stream.EndLine();
+  }
+
+  static void Print(internal::OutputStream& stream) {
+    stream.EndLine();
+  }
+
+  std::vector<Timer> timers_;
 };
 
-}  // namespace compilets::nodejs
+}  // namespace nodejs
+
+}  // namespace compilets
 
 #endif  // CPP_RUNTIME_CONSOLE_H_
@@ -0,0 +1,52 @@
+#include "runtime/coroutine.h"
+
+#include <new>
+
+namespace compilets {
+
+namespace internal {
+
+namespace {
+
+// Frames are rounded up to multiples of the size class, and larger frames are
+// not pooled.
+constexpr size_t kSizeClass = 64;
+constexpr size_t kMaxPooledSize = 2048;
+
+struct FreeListNode {
+  FreeListNode* next;
+};
+
+FreeListNode* g_free_lists[kMaxPooledSize / kSizeClass] = {};
+
+inline size_t GetSizeClassIndex(size_t size) {
+  return (size - 1) / kSizeClass;
+}
+
+}  // namespace
+
+void* AllocateFrame(size_t size) {
+  if (size > kMaxPooledSize)
+    return ::operator new(size);
+  size_t index = GetSizeClassIndex(size);
+  FreeListNode* node = g_free_lists[index];
+  if (!node)
+    return ::operator new((index + 1) * kSizeClass);
+  g_free_lists[index] = node->next;
+  return node;
+}
+
+void FreeFrame(void* frame, size_t size) {
+  if (size > kMaxPooledSize) {
+    ::operator delete(frame);
+    return;
+  }
+  size_t index = GetSizeClassIndex(size);
+  FreeListNode* node = static_cast<FreeListNode*>(frame);
+  node->next = g_free_lists[index];
+  g_free_lists[index] = node;
+}
+
+}  // namespace internal
+
+}  // namespace compilets
@@ -0,0 +1,16 @@
+#ifndef CPP_RUNTIME_COROUTINE_H_
+#define CPP_RUNTIME_COROUTINE_H_
+
+#include <stddef.h>
+
+namespace compilets::internal {
+
+// Coroutine frames of generators and async functions are taken from free lists
+// of size classes, so coroutines created in a loop reuse the frames of the
+// ones already freed.
+void* AllocateFrame(size_t size);
+void FreeFrame(void* frame, size_t size);
+
+}  // namespace compilets::internal
+
+#endif  // CPP_RUNTIME_COROUTINE_H_
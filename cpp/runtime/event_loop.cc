@@ -0,0 +1,149 @@
+#include "runtime/event_loop.h"
+
+#include <errno.h>
+
+#include <cmath>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <unistd.h>
+#else
+#include <thread>
+#endif
+
+#include "cppgc/internal/logging.h"
+
+namespace compilets {
+
+EventLoop::EventLoop() {
+#if defined(__linux__)
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  CPPGC_CHECK(epoll_fd_ >= 0);
+#endif
+}
+
+EventLoop::~EventLoop() {
+#if defined(__linux__)
+  close(epoll_fd_);
+#endif
+}
+
+void EventLoop::PostMicrotask(std::coroutine_handle<> handle) {
+  microtasks_.push_back(handle);
+}
+
+uint64_t EventLoop::AddTimer(double delay, Callback callback, bool repeat) {
+  // Node.js treats invalid and too small delays as 1ms.
+  if (!(delay >= 1))
+    delay = 1;
+  auto interval = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double, std::milli>(delay));
+  uint64_t id = next_timer_id_++;
+  timers_.push({Clock::now() + interval, id});
+  timer_tasks_[id] = {std::move(callback), interval, repeat};
+  return id;
+}
+
+void EventLoop::RemoveTimer(uint64_t id) {
+  timer_tasks_.erase(id);
+}
+
+bool EventLoop::Watch(int fd, uint32_t events, WatchCallback callback) {
+#if defined(__linux__)
+  epoll_event event = {};
+  event.events = events;
+  event.data.fd = fd;
+  int op = watchers_.contains(fd) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+  if (epoll_ctl(epoll_fd_, op, fd, &event) != 0)
+    return false;
+  watchers_[fd] = std::move(callback);
+  return true;
+#else
+  return false;
+#endif
+}
+
+void EventLoop::Unwatch(int fd) {
+#if defined(__linux__)
+  if (watchers_.erase(fd) > 0)
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+#endif
+}
+
+void EventLoop::Run() {
+  RunMicrotasks();
+  while (!timer_tasks_.empty() || !watchers_.empty()) {
+    Poll(GetTimeout());
+    RunTimers();
+  }
+}
+
+void EventLoop::RunMicrotasks() {
+  while (!microtasks_.empty()) {
+    std::coroutine_handle<> handle = microtasks_.front();
+    microtasks_.pop_front();
+    handle.resume();
+  }
+}
+
+void EventLoop::RunTimers() {
+  Clock::time_point now = Clock::now();
+  while (!timers_.empty() && timers_.top().deadline <= now) {
+    uint64_t id = timers_.top().id;
+    timers_.pop();
+    auto it = timer_tasks_.find(id);
+    if (it == timer_tasks_.end())
+      continue;
+    // The callback may remove its own timer, so it must not be called from
+    // inside the map.
+    Callback callback;
+    if (it->second.repeat) {
+      callback = it->second.callback;
+      timers_.push({now + it->second.interval, id});
+    } else {
+      callback = std::move(it->second.callback);
+      timer_tasks_.erase(it);
+    }
+    callback();
+    RunMicrotasks();
+  }
+}
+
+int EventLoop::GetTimeout() {
+  while (!timers_.empty() && !timer_tasks_.contains(timers_.top().id))
+    timers_.pop();
+  if (timers_.empty())
+    return -1;
+  auto delay = timers_.top().deadline - Clock::now();
+  if (delay <= Clock::duration::zero())
+    return 0;
+  return static_cast<int>(std::ceil(
+      std::chrono::duration<double, std::milli>(delay).count()));
+}
+
+void EventLoop::Poll(int timeout) {
+#if defined(__linux__)
+  constexpr int kMaxEvents = 64;
+  epoll_event events[kMaxEvents];
+  int count = epoll_wait(epoll_fd_, events, kMaxEvents, timeout);
+  if (count < 0) {
+    CPPGC_CHECK(errno == EINTR);
+    return;
+  }
+  for (int i = 0; i < count; ++i) {
+    // Previous callbacks may have unwatched the descriptor.
+    auto it = watchers_.find(events[i].data.fd);
+    if (it == watchers_.end())
+      continue;
+    WatchCallback callback = it->second;
+    callback(events[i].events);
+    RunMicrotasks();
+  }
+#else
+  // Only timers are supported without epoll.
+  if (timeout > 0)
+    std::this_thread::sleep_for(std::chrono::milliseconds(timeout));
+#endif
+}
+
+}  // namespace compilets
@@ -0,0 +1,98 @@
+#ifndef CPP_RUNTIME_EVENT_LOOP_H_
+#define CPP_RUNTIME_EVENT_LOOP_H_
+
+#include <stdint.h>
+
+#include <chrono>
+#include <coroutine>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace compilets {
+
+// The event loop of executables, which runs timers, I/O watchers, and the
+// microtasks queued by promises.
+//
+// Like Node.js, the microtask queue is drained after the top-level statements
+// and after every callback. When nothing is due the loop blocks in epoll_wait
+// until the nearest timer expires or a watched file descriptor becomes ready,
+// and the loop quits when there is no timer or watcher left.
+class EventLoop {
+ public:
+  using Callback = std::function<void()>;
+  using WatchCallback = std::function<void(uint32_t events)>;
+
+  EventLoop();
+  ~EventLoop();
+
+  EventLoop& operator=(const EventLoop&) = delete;
+  EventLoop(const EventLoop&) = delete;
+
+  // Queue the coroutine to be resumed after the current callback returns.
+  void PostMicrotask(std::coroutine_handle<> handle);
+
+  // Call the callback after |delay| milliseconds, and repeatedly after every
+  // |delay| milliseconds if |repeat| is true. Returns the ID for removing.
+  uint64_t AddTimer(double delay, Callback callback, bool repeat = false);
+  void RemoveTimer(uint64_t id);
+
+  // Call the callback when the file descriptor is ready for the epoll events,
+  // returns false if the descriptor can not be watched.
+  bool Watch(int fd, uint32_t events, WatchCallback callback);
+  void Unwatch(int fd);
+
+  // Run until there is nothing left to wait for.
+  void Run();
+
+  // Resume the queued coroutines, including the ones queued while running.
+  void RunMicrotasks();
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Timer {
+    Clock::time_point deadline;
+    // Timers with the same deadline run in the order they are added.
+    uint64_t id;
+
+    bool operator>(const Timer& other) const {
+      if (deadline == other.deadline)
+        return id > other.id;
+      return deadline > other.deadline;
+    }
+  };
+
+  struct TimerTask {
+    Callback callback;
+    Clock::duration interval;
+    bool repeat;
+  };
+
+  // Run the timers whose deadlines have passed.
+  void RunTimers();
+  // Return the milliseconds until the nearest timer expires, or -1 if there
+  // is no timer.
+  int GetTimeout();
+  // Wait for the watched file descriptors until timeout.
+  void Poll(int timeout);
+
+  std::deque<std::coroutine_handle<>> microtasks_;
+
+  // Removed timers are only erased from |timer_tasks_|, and are dropped from
+  // the heap when they reach the top.
+  std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers_;
+  std::unordered_map<uint64_t, TimerTask> timer_tasks_;
+  uint64_t next_timer_id_ = 1;
+
+  std::unordered_map<int, WatchCallback> watchers_;
+#if defined(__linux__)
+  int epoll_fd_ = -1;
+#endif
+};
+
+}  // namespace compilets
+
+#endif  // CPP_RUNTIME_EVENT_LOOP_H_
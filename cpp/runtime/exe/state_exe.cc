@@ -1,12 +1,16 @@
 #include "runtime/exe/state_exe.h"
 
+#include "runtime/process.h"
+#include "runtime/runtime.h"
+
 namespace compilets {
 
-StateExe::StateExe()
+StateExe::StateExe(int argc, const char** argv)
     : platform_(std::make_shared<cppgc::DefaultPlatform>()) {
   cppgc::InitializeProcess(platform_->GetPageAllocator());
   heap_ = cppgc::Heap::Create(platform_);
   InitializeObjects();
+  nodejs::process->SetArgv(argc, argv);
 }
 
 StateExe::~StateExe() {
@@ -25,4 +29,20 @@ cppgc::AllocationHandle& StateExe::GetAllocationHandle() {
   return heap_->GetAllocationHandle();
 }
 
+cppgc::HeapHandle& StateExe::GetHeapHandle() {
+  return heap_->GetHeapHandle();
+}
+
+EventLoop* StateExe::GetEventLoop() {
+  return &event_loop_;
+}
+
+void StateExe::PostMicrotask(std::coroutine_handle<> handle) {
+  event_loop_.PostMicrotask(handle);
+}
+
+void StateExe::RunEventLoop() {
+  event_loop_.Run();
+}
+
 }  // namespace compilets
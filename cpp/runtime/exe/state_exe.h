@@ -3,22 +3,32 @@
 
 #include "cppgc/default-platform.h"
 #include "cppgc/heap.h"
+#include "runtime/event_loop.h"
 #include "runtime/state.h"
 
 namespace compilets {
 
 class StateExe : public State {
  public:
-  StateExe();
+  StateExe(int argc, const char** argv);
   ~StateExe();
 
   // State:
   void PreciseGC() override;
   cppgc::AllocationHandle& GetAllocationHandle() override;
+  cppgc::HeapHandle& GetHeapHandle() override;
+  EventLoop* GetEventLoop() override;
+  void PostMicrotask(std::coroutine_handle<> handle) override;
+
+  // Run the event loop after the top-level statements of main script.
+  void RunEventLoop();
 
  private:
   std::shared_ptr<cppgc::DefaultPlatform> platform_;
   std::unique_ptr<cppgc::Heap> heap_;
+  // The pending callbacks hold persistent handles, the loop must be destroyed
+  // before the heap.
+  EventLoop event_loop_;
 };
 
 }  // namespace compilets
@@ -0,0 +1,280 @@
+#include "runtime/fs.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace compilets {
+
+namespace nodejs {
+
+namespace fs {
+
+namespace {
+
+#if defined(_WIN32)
+using ssize_t = int;
+#endif
+
+[[noreturn]] void ThrowError(const char* syscall, const std::string& path) {
+  throw std::system_error(errno, std::generic_category(),
+                          std::string(syscall) + " '" + path + "'");
+}
+
+int OpenFile(const std::string& path, int flags) {
+#if defined(_WIN32)
+  return _open(path.c_str(), flags | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+  return open(path.c_str(), flags | O_CLOEXEC, 0666);
+#endif
+}
+
+void CloseFile(int fd) {
+#if defined(_WIN32)
+  _close(fd);
+#else
+  close(fd);
+#endif
+}
+
+// Read into |data| until it is full or the end of file, returns -1 on error.
+ssize_t ReadFully(int fd, uint8_t* data, size_t size) {
+  size_t total = 0;
+  while (total < size) {
+#if defined(_WIN32)
+    int n = _read(fd, data + total, static_cast<unsigned>(size - total));
+#else
+    ssize_t n = read(fd, data + total, size - total);
+#endif
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      return -1;
+    }
+    if (n == 0)
+      break;
+    total += n;
+  }
+  return total;
+}
+
+bool WriteFully(int fd, const char* data, size_t size) {
+  while (size > 0) {
+#if defined(_WIN32)
+    int n = _write(fd, data, static_cast<unsigned>(size));
+#else
+    ssize_t n = write(fd, data, size);
+#endif
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    data += n;
+    size -= n;
+  }
+  return true;
+}
+
+// Read the whole file into memory, large files are mapped instead.
+std::shared_ptr<internal::BackingStore> ReadFile(const String& path) {
+  std::string file = path.ToUTF8();
+  int fd = OpenFile(file, O_RDONLY);
+  if (fd < 0)
+    ThrowError("open", file);
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    int error = errno;
+    CloseFile(fd);
+    errno = error;
+    ThrowError("fstat", file);
+  }
+  // Regular files have known sizes, while files like pipes and /proc entries
+  // must be read until the end.
+  bool is_regular = S_ISREG(st.st_mode) && st.st_size > 0;
+  size_t size = is_regular ? static_cast<size_t>(st.st_size) : 64 * 1024;
+  if (is_regular && size >= kMapFileThreshold) {
+    if (auto store = internal::BackingStore::MapFile(fd, size)) {
+      CloseFile(fd);
+      return store;
+    }
+  }
+  auto store = internal::BackingStore::Allocate(size);
+  size_t total = 0;
+  while (true) {
+    ssize_t n = ReadFully(fd, store->data() + total, size - total);
+    if (n < 0) {
+      int error = errno;
+      CloseFile(fd);
+      errno = error;
+      ThrowError("read", file);
+    }
+    total += n;
+    if (total < size || is_regular)
+      break;
+    // Buffer is full and there may be more.
+    auto larger = internal::BackingStore::Allocate(size * 2);
+    std::copy_n(store->data(), total, larger->data());
+    store = std::move(larger);
+    size *= 2;
+  }
+  CloseFile(fd);
+  store->Shrink(total);
+  return store;
+}
+
+void WriteFile(const String& path, std::string_view data) {
+  std::string file = path.ToUTF8();
+  int fd = OpenFile(file, O_WRONLY | O_CREAT | O_TRUNC);
+  if (fd < 0)
+    ThrowError("open", file);
+  if (!WriteFully(fd, data.data(), data.size())) {
+    int error = errno;
+    CloseFile(fd);
+    errno = error;
+    ThrowError("write", file);
+  }
+  CloseFile(fd);
+}
+
+int ToFd(double fd) {
+  if (!(fd >= 0) || fd > INT32_MAX || static_cast<int>(fd) != fd)
+    throw std::range_error("The fd must be a valid file descriptor");
+  return static_cast<int>(fd);
+}
+
+}  // namespace
+
+Buffer* readFileSync(const String& path) {
+  return MakeObject<Buffer>(MakeObject<ArrayBuffer>(ReadFile(path)));
+}
+
+String readFileSync(const String& path, const String& encoding) {
+  if (encoding.value() != u"utf8" && encoding.value() != u"utf-8")
+    throw std::invalid_argument("Unknown encoding: " + encoding.ToUTF8());
+  auto store = ReadFile(path);
+  return String::FromUTF8(
+      {reinterpret_cast<const char*>(store->data()), store->length()});
+}
+
+void writeFileSync(const String& path, const String& data) {
+  WriteFile(path, data.ToUTF8());
+}
+
+void writeFileSync(const String& path, Buffer* data) {
+  WriteFile(path, data->view());
+}
+
+Array<String>* readdirSync(const String& path) {
+  std::string dir = path.ToUTF8();
+  std::error_code ec;
+  std::filesystem::directory_iterator it(
+      std::u8string(dir.begin(), dir.end()), ec);
+  if (ec)
+    throw std::system_error(ec, "scandir '" + dir + "'");
+  sane::vector<String> names;
+  for (const auto& entry : it) {
+    std::u8string name = entry.path().filename().u8string();
+    names.push_back(String::FromUTF8(
+        {reinterpret_cast<const char*>(name.data()), name.size()}));
+  }
+  std::sort(names.begin(), names.end(), [](const String& a, const String& b) {
+    return a.value() < b.value();
+  });
+  return MakeArray<String>(std::move(names));
+}
+
+bool existsSync(const String& path) {
+  struct stat st;
+  return stat(path.ToUTF8().c_str(), &st) == 0;
+}
+
+double openSync(const String& path) {
+  return openSync(path, u"r");
+}
+
+double openSync(const String& path, const String& flags) {
+  const std::u16string& f = flags.value();
+  int mode;
+  if (f == u"r")
+    mode = O_RDONLY;
+  else if (f == u"r+")
+    mode = O_RDWR;
+  else if (f == u"w")
+    mode = O_WRONLY | O_CREAT | O_TRUNC;
+  else if (f == u"w+")
+    mode = O_RDWR | O_CREAT | O_TRUNC;
+  else if (f == u"a")
+    mode = O_WRONLY | O_CREAT | O_APPEND;
+  else if (f == u"a+")
+    mode = O_RDWR | O_CREAT | O_APPEND;
+  else
+    throw std::invalid_argument("Invalid flags: " + flags.ToUTF8());
+  std::string file = path.ToUTF8();
+  int fd = OpenFile(file, mode);
+  if (fd < 0)
+    ThrowError("open", file);
+  return fd;
+}
+
+double readSync(double fd, Buffer* buffer) {
+  return readSync(fd, buffer, 0, buffer->length);
+}
+
+double readSync(double fd, Buffer* buffer, double offset, double length) {
+  return readSync(fd, buffer, offset, length, -1);
+}
+
+double readSync(double fd, Buffer* buffer, double offset, double length,
+                double position) {
+  if (!(offset >= 0) || !(length >= 0) || offset + length > buffer->length)
+    throw std::range_error("The offset and length are out of buffer's range");
+  int file = ToFd(fd);
+  uint8_t* data = buffer->data() + static_cast<size_t>(offset);
+  size_t size = static_cast<size_t>(length);
+  while (true) {
+#if defined(_WIN32)
+    if (position >= 0 &&
+        _lseeki64(file, static_cast<int64_t>(position), SEEK_SET) < 0) {
+      throw std::system_error(errno, std::generic_category(), "read");
+    }
+    int n = _read(file, data, static_cast<unsigned>(size));
+#else
+    ssize_t n = position >= 0 ? pread(file, data, size,
+                                      static_cast<off_t>(position))
+                              : read(file, data, size);
+#endif
+    if (n >= 0)
+      return n;
+    if (errno != EINTR)
+      throw std::system_error(errno, std::generic_category(), "read");
+  }
+}
+
+void closeSync(double fd) {
+#if defined(_WIN32)
+  int result = _close(ToFd(fd));
+#else
+  int result = close(ToFd(fd));
+#endif
+  if (result != 0)
+    throw std::system_error(errno, std::generic_category(), "close");
+}
+
+}  // namespace fs
+
+}  // namespace nodejs
+
+}  // namespace compilets
@@ -0,0 +1,49 @@
+#ifndef CPP_RUNTIME_FS_H_
+#define CPP_RUNTIME_FS_H_
+
+#include "runtime/array.h"
+#include "runtime/buffer.h"
+#include "runtime/string.h"
+
+namespace compilets {
+
+namespace nodejs {
+
+// The synchronous APIs of the node:fs module.
+//
+// Errors are thrown as std::system_error, whose message contains the syscall
+// and the path like Node.js.
+namespace fs {
+
+// Files larger than this are mapped into memory instead of being read.
+inline constexpr size_t kMapFileThreshold = 1024 * 1024;
+
+Buffer* readFileSync(const String& path);
+// Only the "utf8" encoding is supported, and the text is decoded directly
+// from the mapped file.
+String readFileSync(const String& path, const String& encoding);
+
+void writeFileSync(const String& path, const String& data);
+void writeFileSync(const String& path, Buffer* data);
+
+// The names of entries in the directory, sorted.
+Array<String>* readdirSync(const String& path);
+
+bool existsSync(const String& path);
+
+// Reading files in chunks.
+double openSync(const String& path);
+double openSync(const String& path, const String& flags);
+double readSync(double fd, Buffer* buffer);
+double readSync(double fd, Buffer* buffer, double offset, double length);
+double readSync(double fd, Buffer* buffer, double offset, double length,
+                double position);
+void closeSync(double fd);
+
+}  // namespace fs
+
+}  // namespace nodejs
+
+}  // namespace compilets
+
+#endif  // CPP_RUNTIME_FS_H_
@@ -1,41 +1,117 @@
 #ifndef CPP_RUNTIME_FUNCTION_H_
 #define CPP_RUNTIME_FUNCTION_H_
 
-#include <functional>
-#include <vector>
+#include <tuple>
+#include <utility>
 
 #include "runtime/object.h"
 
 namespace compilets {
 
-// Holds the lambda function and its closure.
 template<typename Sig>
-class Function final : public Object {
+class Function;
+
+// Base class of function objects, calls are dispatched through a plain
+// function pointer set by the concrete FunctionImpl.
+template<typename R, typename... Args>
+class Function<R(Args...)> : public Object {
  public:
-  Function(std::function<Sig> lambda,
-           std::vector<cppgc::Member<Object>> closure)
-    : closure_(std::move(closure)), lambda_(std::move(lambda)) {}
+  R operator()(Args... args) const {
+    return invoke_(this, std::forward<Args>(args)...);
+  }
+
+  const Function& value() const { return *this; }
+
+ protected:
+  using Invoke = R(*)(const Function*, Args...);
 
-  virtual void Trace(cppgc::Visitor* visitor) const {
-    for (const auto& object : closure_)
-      visitor->Trace(object);
+  explicit Function(Invoke invoke) : invoke_(invoke) {}
+
+ private:
+  Invoke invoke_;
+};
+
+// Holds the lambda inline and the GCed objects captured in its closure as
+// typed members.
+template<typename Sig, typename Lambda, typename... Closure>
+class FunctionImpl;
+
+template<typename R, typename... Args, typename Lambda, typename... Closure>
+class FunctionImpl<R(Args...), Lambda, Closure...> final
+    : public Function<R(Args...)> {
+ public:
+  explicit FunctionImpl(Lambda lambda, Closure*... closure)
+      : Function<R(Args...)>(&FunctionImpl::Invoke),
+        lambda_(std::move(lambda)),
+        closure_(closure...) {}
+
+  // Calls with known lambda type do not go through the function pointer.
+  R operator()(Args... args) const {
+    return lambda_(std::forward<Args>(args)...);
   }
 
-  const std::function<Sig>& value() const { return lambda_; }
+  const FunctionImpl& value() const { return *this; }
+
+  void Trace(cppgc::Visitor* visitor) const override {
+    std::apply([visitor](const auto&... object) {
+      (visitor->Trace(object), ...);
+    }, closure_);
+  }
 
  private:
-  std::vector<cppgc::Member<Object>> closure_;
-  std::function<Sig> lambda_;
+  static R Invoke(const Function<R(Args...)>* self, Args... args) {
+    return static_cast<const FunctionImpl*>(self)->lambda_(
+        std::forward<Args>(args)...);
+  }
+
+  Lambda lambda_;
+  std::tuple<cppgc::Member<Closure>...> closure_;
+};
+
+// Stores a local variable that is modified after being captured by closures,
+// the function declaring it and the closures all refer to the same value.
+template<typename T>
+class Cell final : public Object {
+ public:
+  template<typename... Args>
+  explicit Cell(Args&&... args) : value(std::forward<Args>(args)...) {}
+
+  void Trace(cppgc::Visitor* visitor) const override {
+    TracePossibleMember(visitor, value);
+  }
+
+  T value;
 };
 
+// Helper to create the FunctionImpl from lambda, the concrete type is kept so
+// calls through the result invoke the lambda directly.
+template<typename Sig, typename Lambda, typename... Closure>
+COMPILETS_ALLOCATION_SITE inline FunctionImpl<Sig, Lambda, Closure...>*
+MakeFunctionImpl(Lambda lambda, Closure*... closure) {
+  using Impl = FunctionImpl<Sig, Lambda, Closure...>;
+  COMPILETS_RECORD_ALLOCATION(Impl, sizeof(Impl));
+  return cppgc::MakeGarbageCollected<Impl>(GetAllocationHandle(),
+                                           std::move(lambda),
+                                           closure...);
+}
+
 // Helper to create the Function from lambda.
-template<typename Sig, typename... Closure>
-inline Function<Sig>* MakeFunction(std::function<Sig> lambda,
-                                   Closure*... closure) {
-  return cppgc::MakeGarbageCollected<Function<Sig>>(
-      GetAllocationHandle(),
-      std::move(lambda),
-      std::vector<cppgc::Member<Object>>({closure...}));
+template<typename Sig, typename Lambda, typename... Closure>
+COMPILETS_ALLOCATION_SITE inline Function<Sig>* MakeFunction(
+    Lambda lambda,
+    Closure*... closure) {
+  return MakeFunctionImpl<Sig>(std::move(lambda), closure...);
+}
+
+// Helper to get the Function of a top-level function, it is only created once
+// and then cached by the State.
+template<typename Sig, auto F>
+inline Function<Sig>* MakeFunction() {
+  static const size_t slot = State::NewFunctionSlot();
+  cppgc::Persistent<Object>& function = State::Get()->GetFunctionSlot(slot);
+  if (!function)
+    function = MakeFunction<Sig>(F);
+  return static_cast<Function<Sig>*>(function.Get());
 }
 
 // Convert function to string.
@@ -0,0 +1,132 @@
+#ifndef CPP_RUNTIME_GENERATOR_H_
+#define CPP_RUNTIME_GENERATOR_H_
+
+#include <coroutine>
+#include <exception>
+
+#include "cppgc/persistent.h"
+#include "runtime/coroutine.h"
+#include "runtime/object.h"
+
+namespace compilets {
+
+// The generator object, which owns the coroutine running the body of the
+// generator function.
+//
+// The coroutine frame is not on the GC heap and is never traced, so the
+// translator declares the object variables of generator functions as
+// cppgc::Persistent to keep them alive while the coroutine is suspended.
+template<typename T>
+class Generator final : public Object {
+ public:
+  class promise_type {
+   public:
+    Generator* get_return_object() {
+      return MakeObject<Generator>(
+          std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    // The body starts running on the first resume.
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    // Keep the frame after the body finishes, it is destroyed together with
+    // the generator object.
+    std::suspend_always final_suspend() noexcept { return {}; }
+
+    // The yielded value is stored in the promise and read by the iterator,
+    // without being wrapped in a result object.
+    std::suspend_always yield_value(ValueType<T> value) {
+      value_ = std::move(value);
+      return {};
+    }
+
+    void return_void() {}
+
+    void unhandled_exception() {
+      std::rethrow_exception(std::current_exception());
+    }
+
+    static void* operator new(size_t size) {
+      return internal::AllocateFrame(size);
+    }
+
+    static void operator delete(void* frame, size_t size) {
+      internal::FreeFrame(frame, size);
+    }
+
+    const ValueType<T>& value() const { return value_; }
+
+   private:
+    ValueType<T> value_ = {};
+  };
+
+  using Handle = std::coroutine_handle<promise_type>;
+
+  // Iterates the yielded values, each step resumes the coroutine directly.
+  class Iterator {
+   public:
+    Iterator() = default;
+
+    explicit Iterator(Generator* generator) : generator_(generator) {
+      ++*this;
+    }
+
+    const ValueType<T>& operator*() const {
+      return generator_->handle_.promise().value();
+    }
+
+    Iterator& operator++() {
+      if (!generator_->Resume())
+        generator_.Clear();
+      return *this;
+    }
+
+    bool operator==(const Iterator& other) const {
+      return generator_.Get() == other.generator_.Get();
+    }
+
+   private:
+    // The loop may run inside the frame of another generator, which is not
+    // scanned by GC, so the iterator keeps the generator alive.
+    cppgc::Persistent<Generator> generator_;
+  };
+
+  explicit Generator(Handle handle) : handle_(handle) {}
+
+  ~Generator() {
+    handle_.destroy();
+  }
+
+  Iterator begin() { return Iterator(this); }
+  Iterator end() { return Iterator(); }
+
+  // Whether the body of generator has finished.
+  bool done() const { return handle_.done(); }
+
+ private:
+  // Run the body until the next yield, return false if it has finished.
+  bool Resume() {
+    if (handle_.done())
+      return false;
+    handle_.resume();
+    return !handle_.done();
+  }
+
+  Handle handle_;
+};
+
+// Convert generator to string.
+template<typename T>
+inline std::u16string ToStringImpl(Generator<T>* generator) {
+  return u"[object Generator]";
+}
+
+}  // namespace compilets
+
+// The generator functions return a pointer to the GC object, which needs the
+// promise type to be specified explicitly.
+template<typename T, typename... Args>
+struct std::coroutine_traits<compilets::Generator<T>*, Args...> {
+  using promise_type = typename compilets::Generator<T>::promise_type;
+};
+
+#endif  // CPP_RUNTIME_GENERATOR_H_
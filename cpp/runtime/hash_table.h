@@ -0,0 +1,426 @@
+#ifndef CPP_RUNTIME_HASH_TABLE_H_
+#define CPP_RUNTIME_HASH_TABLE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define COMPILETS_HASH_TABLE_SSE2
+#endif
+
+#include "runtime/string.h"
+#include "runtime/type_traits.h"
+
+namespace compilets {
+
+namespace internal {
+
+// Mix the bits so both the low 7 bits and the high bits of hash are usable.
+inline uint64_t MixHash(uint64_t hash) {
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccd;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+// Keys are compared with SameValueZero, so +0 and -0 hash the same, and so do
+// all the NaNs.
+inline uint64_t HashValue(double value) {
+  if (value == 0)
+    value = 0;
+  else if (std::isnan(value))
+    value = std::numeric_limits<double>::quiet_NaN();
+  return MixHash(std::bit_cast<uint64_t>(value));
+}
+
+inline uint64_t HashValue(bool value) {
+  return MixHash(value ? 1 : 2);
+}
+
+inline uint64_t HashValue(std::nullopt_t) {
+  return MixHash(3);
+}
+
+inline uint64_t HashValue(Null) {
+  return MixHash(4);
+}
+
+// The hash of String is cached, and is already well mixed.
+inline uint64_t HashValue(const String& value) {
+  return value.hash();
+}
+
+// String literals are hashed without being converted to String.
+inline uint64_t HashValue(const char16_t* value) {
+  return HashString(value);
+}
+
+template<typename T>
+inline uint64_t HashValue(T* value) {
+  if (!value)
+    return HashValue(std::nullopt);
+  return MixHash(reinterpret_cast<uintptr_t>(value));
+}
+
+template<typename T>
+inline uint32_t HashKey(const T& key) {
+  uint64_t hash = Visit([](const auto& value) -> uint64_t {
+    return HashValue(value);
+  }, key);
+  return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
+// The SameValueZero algorithm used by Map and Set, which differs from === in
+// that NaN equals to NaN.
+template<typename T, typename U>
+inline bool SameValueZero(const T& left, const U& right) {
+  return Visit([&right]<typename L>(const L& l) {
+    return Visit([&l]<typename R>(const R& r) {
+      if constexpr (std::is_same_v<L, double> && std::is_same_v<R, double>)
+        return l == r || (std::isnan(l) && std::isnan(r));
+      else if constexpr (std::is_pointer_v<L> &&
+                         std::is_same_v<R, std::nullopt_t>)
+        return l == nullptr;
+      else if constexpr (std::is_same_v<L, std::nullopt_t> &&
+                         std::is_pointer_v<R>)
+        return r == nullptr;
+      else
+        return StrictEqual(l, r);
+    }, right);
+  }, left);
+}
+
+// The control byte of each slot, full slots store the low 7 bits of hash.
+enum : int8_t {
+  kCtrlEmpty = -128,
+  kCtrlDeleted = -2,
+};
+
+// A group of control bytes that are probed together.
+class Group {
+ public:
+  static constexpr size_t kWidth = 16;
+
+  uint32_t MatchEmpty() const {
+    return Match(kCtrlEmpty);
+  }
+
+#if defined(COMPILETS_HASH_TABLE_SSE2)
+  explicit Group(const int8_t* ctrl)
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+  // Return the bitmask of slots whose control byte is |byte|.
+  uint32_t Match(int8_t byte) const {
+    return static_cast<uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(byte))));
+  }
+
+  // Return the bitmask of empty or deleted slots, which have the sign bit.
+  uint32_t MatchAvailable() const {
+    return static_cast<uint32_t>(_mm_movemask_epi8(ctrl_));
+  }
+
+ private:
+  __m128i ctrl_;
+#else
+  explicit Group(const int8_t* ctrl) {
+    memcpy(ctrl_, ctrl, kWidth);
+  }
+
+  uint32_t Match(int8_t byte) const {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kWidth; ++i)
+      mask |= static_cast<uint32_t>(ctrl_[i] == byte) << i;
+    return mask;
+  }
+
+  uint32_t MatchAvailable() const {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kWidth; ++i)
+      mask |= static_cast<uint32_t>(ctrl_[i] < 0) << i;
+    return mask;
+  }
+
+ private:
+  int8_t ctrl_[kWidth];
+#endif
+};
+
+}  // namespace internal
+
+// Hash table that keeps the insertion order of entries, used by Map and Set.
+//
+// Entries are appended to a dense array, which is what iteration walks, and
+// the index is an open addressing table in the style of SwissTable: each slot
+// stores the position of an entry, and a control byte with 7 bits of the hash,
+// so a group of 16 slots is probed with a few SIMD instructions and keys are
+// only compared on a likely match. The hash of each entry is kept, so keys are
+// never hashed again when the index grows.
+//
+// Deleted entries leave holes in the dense array, which are compacted when the
+// index is rebuilt, unless there are iterators walking the array.
+template<typename Entry>
+class OrderedHashTable {
+ private:
+  struct Record {
+    Entry entry;
+    uint32_t hash;
+    bool deleted = false;
+  };
+
+ public:
+  // Iterates the entries in insertion order.
+  //
+  // The iterator stores an index instead of a pointer, and checks the end
+  // against the current number of records, so a for...of loop that adds or
+  // deletes entries never reads freed memory, and visits the entries added
+  // during the loop like JS does. The table counts the live iterators and does
+  // not compact the records while there are any, so no entry is skipped.
+  class Iterator {
+   public:
+    Iterator(const OrderedHashTable* table, size_t index)
+        : table_(table), index_(index) {
+      table_->iterators_++;
+      SkipDeleted();
+    }
+
+    Iterator(const Iterator& other) : Iterator(other.table_, other.index_) {}
+
+    Iterator& operator=(const Iterator& other) {
+      other.table_->iterators_++;
+      table_->iterators_--;
+      table_ = other.table_;
+      index_ = other.index_;
+      return *this;
+    }
+
+    ~Iterator() {
+      table_->iterators_--;
+    }
+
+    const Entry& operator*() const { return records()[index_].entry; }
+    const Entry* operator->() const { return &records()[index_].entry; }
+
+    Iterator& operator++() {
+      ++index_;
+      SkipDeleted();
+      return *this;
+    }
+
+    bool operator==(const Iterator& other) const {
+      if (IsEnd() || other.IsEnd())
+        return IsEnd() == other.IsEnd();
+      return index_ == other.index_;
+    }
+
+   private:
+    const std::vector<Record>& records() const { return table_->records_; }
+
+    bool IsEnd() const { return index_ >= records().size(); }
+
+    void SkipDeleted() {
+      while (!IsEnd() && records()[index_].deleted)
+        ++index_;
+    }
+
+    const OrderedHashTable* table_;
+    size_t index_;
+  };
+
+  size_t size() const { return size_; }
+
+  Iterator begin() const { return Iterator(this, 0); }
+  Iterator end() const { return Iterator(this, kNotFound); }
+
+  // Call |callback| with each entry without creating iterators, which is used
+  // by tracing so the marker never touches the iterator count.
+  template<typename F>
+  void ForEach(F&& callback) const {
+    for (const Record& record : records_) {
+      if (!record.deleted)
+        callback(record.entry);
+    }
+  }
+
+  template<typename K>
+  const Entry* Find(const K& key) const {
+    size_t slot = FindSlot(key, internal::HashKey(key));
+    if (slot == kNotFound)
+      return nullptr;
+    return &records_[slots_[slot]].entry;
+  }
+
+  // Return the entry of key, a new entry is appended if not found.
+  template<typename K>
+  Entry& FindOrInsert(const K& key) {
+    uint32_t hash = internal::HashKey(key);
+    size_t slot = FindSlot(key, hash);
+    if (slot != kNotFound)
+      return records_[slots_[slot]].entry;
+    // Tombstones also make probing longer, and the holes in the dense array
+    // take memory, rebuild the index when either reaches the limit.
+    if (used_ >= MaxLoad(capacity_) || records_.size() >= capacity_)
+      Rehash();
+    slot = FindAvailableSlot(hash);
+    if (ctrl_[slot] == internal::kCtrlEmpty)
+      used_++;
+    ctrl_[slot] = H2(hash);
+    slots_[slot] = static_cast<uint32_t>(records_.size());
+    records_.push_back({Entry{key}, hash});
+    size_++;
+    return records_.back().entry;
+  }
+
+  template<typename K>
+  bool Erase(const K& key) {
+    size_t slot = FindSlot(key, internal::HashKey(key));
+    if (slot == kNotFound)
+      return false;
+    // Release the references held by entry.
+    Record& record = records_[slots_[slot]];
+    record.entry = Entry();
+    record.deleted = true;
+    size_--;
+    // When the group still has empty slots, no probing has ever gone past it,
+    // and the slot can be marked as empty instead of a tombstone.
+    size_t group = slot & ~(internal::Group::kWidth - 1);
+    if (internal::Group(&ctrl_[group]).MatchEmpty()) {
+      ctrl_[slot] = internal::kCtrlEmpty;
+      used_--;
+    } else {
+      ctrl_[slot] = internal::kCtrlDeleted;
+    }
+    return true;
+  }
+
+  void Clear() {
+    // Keep the positions of records for iterators, which then visit the
+    // entries added after clearing.
+    if (iterators_ > 0) {
+      for (Record& record : records_) {
+        record.entry = Entry();
+        record.deleted = true;
+      }
+      std::fill_n(ctrl_.get(), capacity_, internal::kCtrlEmpty);
+      size_ = used_ = 0;
+      return;
+    }
+    records_.clear();
+    records_.shrink_to_fit();
+    ctrl_.reset();
+    slots_.reset();
+    capacity_ = size_ = used_ = 0;
+  }
+
+ private:
+  static constexpr size_t kNotFound = std::numeric_limits<size_t>::max();
+  static constexpr size_t kMinCapacity = 2 * internal::Group::kWidth;
+
+  // Keep 1/8 of slots empty so probing always ends quickly.
+  static size_t MaxLoad(size_t capacity) {
+    return capacity - capacity / 8;
+  }
+
+  static size_t H1(uint32_t hash) { return hash >> 7; }
+  static int8_t H2(uint32_t hash) { return hash & 0x7f; }
+
+  // Probe the groups with triangular numbers, which visits every group when
+  // the number of groups is a power of 2.
+  class ProbeSequence {
+   public:
+    ProbeSequence(uint32_t hash, size_t capacity)
+        : mask_(capacity / internal::Group::kWidth - 1),
+          group_(H1(hash) & mask_) {}
+
+    size_t offset() const { return group_ * internal::Group::kWidth; }
+
+    void Next() {
+      group_ = (group_ + ++step_) & mask_;
+    }
+
+   private:
+    size_t mask_;
+    size_t group_;
+    size_t step_ = 0;
+  };
+
+  template<typename K>
+  size_t FindSlot(const K& key, uint32_t hash) const {
+    if (capacity_ == 0)
+      return kNotFound;
+    for (ProbeSequence seq(hash, capacity_); ; seq.Next()) {
+      internal::Group group(&ctrl_[seq.offset()]);
+      for (uint32_t bits = group.Match(H2(hash)); bits; bits &= bits - 1) {
+        size_t slot = seq.offset() + std::countr_zero(bits);
+        const Record& record = records_[slots_[slot]];
+        if (record.hash == hash &&
+            internal::SameValueZero(record.entry.key, key)) {
+          return slot;
+        }
+      }
+      // Insertion never goes past a group with empty slots.
+      if (group.MatchEmpty())
+        return kNotFound;
+    }
+  }
+
+  size_t FindAvailableSlot(uint32_t hash) const {
+    for (ProbeSequence seq(hash, capacity_); ; seq.Next()) {
+      uint32_t bits = internal::Group(&ctrl_[seq.offset()]).MatchAvailable();
+      if (bits)
+        return seq.offset() + std::countr_zero(bits);
+    }
+  }
+
+  // Drop the holes in entries and rebuild the index, with larger capacity if
+  // the live entries need. While iterating, the holes are kept so the indices
+  // of iterators stay valid, and the capacity grows to cover them instead.
+  void Rehash() {
+    bool compact = iterators_ == 0;
+    size_t records = compact ? size_ : records_.size();
+    size_t capacity = std::max(capacity_, kMinCapacity);
+    while (size_ + 1 > MaxLoad(capacity) / 2 || records + 1 > capacity)
+      capacity *= 2;
+    if (compact && size_ != records_.size())
+      std::erase_if(records_, [](const Record& r) { return r.deleted; });
+    if (capacity != capacity_) {
+      ctrl_ = std::make_unique<int8_t[]>(capacity);
+      slots_ = std::make_unique<uint32_t[]>(capacity);
+      capacity_ = capacity;
+    }
+    std::fill_n(ctrl_.get(), capacity_, internal::kCtrlEmpty);
+    for (size_t i = 0; i < records_.size(); ++i) {
+      if (records_[i].deleted)
+        continue;
+      size_t slot = FindAvailableSlot(records_[i].hash);
+      ctrl_[slot] = H2(records_[i].hash);
+      slots_[slot] = static_cast<uint32_t>(i);
+    }
+    used_ = size_;
+  }
+
+  std::vector<Record> records_;
+  std::unique_ptr<int8_t[]> ctrl_;
+  std::unique_ptr<uint32_t[]> slots_;
+  size_t capacity_ = 0;
+  // Number of live entries.
+  size_t size_ = 0;
+  // Number of slots that are not empty, including tombstones.
+  size_t used_ = 0;
+  // Number of iterators alive, the records are not compacted while non-zero.
+  mutable size_t iterators_ = 0;
+};
+
+}  // namespace compilets
+
+#endif  // CPP_RUNTIME_HASH_TABLE_H_
@@ -0,0 +1,478 @@
+#include "runtime/json.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <stdexcept>
+
+#include "fastfloat/fast_float.h"
+
+namespace compilets {
+
+namespace internal {
+
+namespace {
+
+constexpr uint64_t kOnes = 0x0101'0101'0101'0101;
+constexpr uint64_t kHighBits = 0x8080'8080'8080'8080;
+
+// Return the first '"', '\\' or control character in [begin, end), which are
+// the bytes that end a run of plain characters in JSON strings.
+//
+// Eight bytes are tested at once with bit tricks: the lowest byte flagged is
+// always exact, though bytes after it may be flagged falsely because of the
+// borrows in subtraction.
+const char* FindSpecialByte(const char* begin, const char* end) {
+  const char* p = begin;
+  if constexpr (std::endian::native == std::endian::little) {
+    for (; end - p >= 8; p += 8) {
+      uint64_t word;
+      memcpy(&word, p, 8);
+      uint64_t quote = word ^ (kOnes * '"');
+      uint64_t backslash = word ^ (kOnes * '\\');
+      uint64_t found = ((quote - kOnes) & ~quote) |
+                       ((backslash - kOnes) & ~backslash) |
+                       ((word - kOnes * 0x20) & ~word);
+      found &= kHighBits;
+      if (found)
+        return p + std::countr_zero(found) / 8;
+    }
+  }
+  for (; p < end; ++p) {
+    unsigned char c = *p;
+    if (c == '"' || c == '\\' || c < 0x20)
+      return p;
+  }
+  return end;
+}
+
+bool IsDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+int HexValue(char c) {
+  if (c >= '0' && c <= '9')
+    return c - '0';
+  if (c >= 'a' && c <= 'f')
+    return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
+void AppendUTF8(std::string& out, uint32_t code_point) {
+  if (code_point < 0x80) {
+    out += static_cast<char>(code_point);
+  } else if (code_point < 0x800) {
+    out += static_cast<char>(0xC0 | (code_point >> 6));
+    out += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else if (code_point < 0x10000) {
+    out += static_cast<char>(0xE0 | (code_point >> 12));
+    out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else {
+    out += static_cast<char>(0xF0 | (code_point >> 18));
+    out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+    out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (code_point & 0x3F));
+  }
+}
+
+// Append the escape sequence of a character that can not appear in JSON
+// strings as it is, the hex digits are lowercase like V8.
+void AppendEscaped(std::string& out, char16_t c) {
+  switch (c) {
+    case '"': out += "\\\""; return;
+    case '\\': out += "\\\\"; return;
+    case '\b': out += "\\b"; return;
+    case '\f': out += "\\f"; return;
+    case '\n': out += "\\n"; return;
+    case '\r': out += "\\r"; return;
+    case '\t': out += "\\t"; return;
+  }
+  constexpr char kHexDigits[] = "0123456789abcdef";
+  out += "\\u";
+  for (int shift = 12; shift >= 0; shift -= 4)
+    out += kHexDigits[(c >> shift) & 0xF];
+}
+
+}  // namespace
+
+JSONReader::JSONReader(std::string_view json) : json_(json) {}
+
+void JSONReader::Read(double& out) {
+  SkipWhitespace();
+  // Check the grammar of JSON numbers, which is stricter than fast_float.
+  size_t start = position_;
+  size_t i = position_;
+  if (i < json_.size() && json_[i] == '-')
+    ++i;
+  if (i < json_.size() && json_[i] == '0') {
+    ++i;
+  } else if (i < json_.size() && IsDigit(json_[i])) {
+    while (i < json_.size() && IsDigit(json_[i]))
+      ++i;
+  } else {
+    position_ = i;
+    ThrowUnexpected();
+  }
+  if (i < json_.size() && json_[i] == '.') {
+    ++i;
+    if (i == json_.size() || !IsDigit(json_[i])) {
+      position_ = i;
+      ThrowUnexpected();
+    }
+    while (i < json_.size() && IsDigit(json_[i]))
+      ++i;
+  }
+  if (i < json_.size() && (json_[i] == 'e' || json_[i] == 'E')) {
+    ++i;
+    if (i < json_.size() && (json_[i] == '+' || json_[i] == '-'))
+      ++i;
+    if (i == json_.size() || !IsDigit(json_[i])) {
+      position_ = i;
+      ThrowUnexpected();
+    }
+    while (i < json_.size() && IsDigit(json_[i]))
+      ++i;
+  }
+  fast_float::from_chars(json_.data() + start, json_.data() + i, out);
+  position_ = i;
+}
+
+void JSONReader::Read(bool& out) {
+  SkipWhitespace();
+  if (json_.substr(position_, 4) == "true") {
+    out = true;
+    position_ += 4;
+  } else if (json_.substr(position_, 5) == "false") {
+    out = false;
+    position_ += 5;
+  } else {
+    ThrowUnexpected();
+  }
+}
+
+void JSONReader::Read(sane::Bool& out) {
+  bool value;
+  Read(value);
+  out = value;
+}
+
+void JSONReader::Read(String& out) {
+  std::string_view contents;
+  if (ReadStringContents(contents))
+    out = String::FromUTF8Lazily(std::move(string_buffer_));
+  else
+    out = String::FromUTF8Lazily(std::string(contents));
+}
+
+void JSONReader::Read(CompactOptional<double>& out) {
+  if (ConsumeNull()) {
+    out = std::nullopt;
+  } else {
+    double value;
+    Read(value);
+    out = value;
+  }
+}
+
+void JSONReader::Finish() {
+  SkipWhitespace();
+  if (position_ != json_.size())
+    ThrowUnexpected();
+}
+
+std::string_view JSONReader::ReadKey() {
+  std::string_view key;
+  if (ReadStringContents(key))
+    key = string_buffer_;
+  Expect(':');
+  return key;
+}
+
+bool JSONReader::ReadStringContents(std::string_view& contents) {
+  Expect('"');
+  const char* begin = json_.data() + position_;
+  const char* end = json_.data() + json_.size();
+  const char* p = FindSpecialByte(begin, end);
+  // Most strings have no escaped characters and are returned as views.
+  if (p != end && *p == '"') {
+    contents = std::string_view(begin, p - begin);
+    position_ = p + 1 - json_.data();
+    return false;
+  }
+  string_buffer_.assign(begin, p);
+  while (true) {
+    position_ = p - json_.data();
+    if (p == end || *p != '\\')
+      break;
+    ++p;
+    if (p == end)
+      break;
+    switch (*p++) {
+      case '"': string_buffer_ += '"'; break;
+      case '\\': string_buffer_ += '\\'; break;
+      case '/': string_buffer_ += '/'; break;
+      case 'b': string_buffer_ += '\b'; break;
+      case 'f': string_buffer_ += '\f'; break;
+      case 'n': string_buffer_ += '\n'; break;
+      case 'r': string_buffer_ += '\r'; break;
+      case 't': string_buffer_ += '\t'; break;
+      case 'u': {
+        auto read_hex = [&]() -> int {
+          if (end - p < 4)
+            return -1;
+          int value = 0;
+          for (int i = 0; i < 4; ++i) {
+            int digit = HexValue(p[i]);
+            if (digit < 0)
+              return -1;
+            value = value * 16 + digit;
+          }
+          p += 4;
+          return value;
+        };
+        int code_unit = read_hex();
+        if (code_unit < 0) {
+          position_ = p - json_.data();
+          ThrowUnexpected();
+        }
+        uint32_t code_point = code_unit;
+        if (code_unit >= 0xD800 && code_unit <= 0xDBFF &&
+            end - p >= 2 && p[0] == '\\' && p[1] == 'u') {
+          const char* low_start = p;
+          p += 2;
+          int low = read_hex();
+          if (low >= 0xDC00 && low <= 0xDFFF)
+            code_point = 0x10000 + ((code_unit - 0xD800) << 10) +
+                         (low - 0xDC00);
+          else
+            p = low_start;
+        }
+        // The strings are kept in UTF-8, which can not represent lone
+        // surrogates, so they become replacement characters.
+        if (code_point >= 0xD800 && code_point <= 0xDFFF)
+          code_point = 0xFFFD;
+        AppendUTF8(string_buffer_, code_point);
+        break;
+      }
+      default:
+        position_ = p - 1 - json_.data();
+        ThrowUnexpected();
+    }
+    const char* run = p;
+    p = FindSpecialByte(run, end);
+    string_buffer_.append(run, p);
+  }
+  if (p == end || *p != '"')
+    ThrowUnexpected();
+  position_ = p + 1 - json_.data();
+  contents = string_buffer_;
+  return true;
+}
+
+void JSONReader::SkipValue() {
+  SkipWhitespace();
+  if (position_ == json_.size())
+    ThrowUnexpected();
+  switch (json_[position_]) {
+    case '"': {
+      std::string_view contents;
+      ReadStringContents(contents);
+      break;
+    }
+    case '[':
+      ++position_;
+      if (!Consume(']')) {
+        do {
+          SkipValue();
+        } while (Consume(','));
+        Expect(']');
+      }
+      break;
+    case '{':
+      ++position_;
+      if (!Consume('}')) {
+        do {
+          ReadKey();
+          SkipValue();
+        } while (Consume(','));
+        Expect('}');
+      }
+      break;
+    case 't':
+    case 'f': {
+      bool value;
+      Read(value);
+      break;
+    }
+    case 'n':
+      if (!ConsumeNull())
+        ThrowUnexpected();
+      break;
+    default: {
+      double value;
+      Read(value);
+    }
+  }
+}
+
+void JSONReader::SkipWhitespace() {
+  while (position_ < json_.size()) {
+    char c = json_[position_];
+    if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+      break;
+    ++position_;
+  }
+}
+
+bool JSONReader::Consume(char c) {
+  SkipWhitespace();
+  if (position_ < json_.size() && json_[position_] == c) {
+    ++position_;
+    return true;
+  }
+  return false;
+}
+
+bool JSONReader::ConsumeNull() {
+  SkipWhitespace();
+  if (json_.substr(position_, 4) == "null") {
+    position_ += 4;
+    return true;
+  }
+  return false;
+}
+
+void JSONReader::Expect(char c) {
+  if (!Consume(c))
+    ThrowUnexpected();
+}
+
+void JSONReader::ThrowUnexpected() {
+  if (position_ >= json_.size())
+    throw std::invalid_argument("Unexpected end of JSON input");
+  std::string message = "Unexpected token '";
+  message += json_[position_];
+  message += "' in JSON at position ";
+  message += std::to_string(position_);
+  throw std::invalid_argument(message);
+}
+
+void JSONWriter::Write(double value) {
+  // NaN and Infinity are not valid JSON.
+  if (!std::isfinite(value)) {
+    result_ += "null";
+    return;
+  }
+  char buffer[32];
+  // Safe integers are the most common numbers and have a faster path, note
+  // that -0 is printed as 0. Larger integers are printed with the shortest
+  // digits like other numbers.
+  if (std::abs(value) <= 9007199254740992.0 && std::trunc(value) == value) {
+    auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer),
+                                      static_cast<int64_t>(value));
+    result_.append(buffer, end);
+    return;
+  }
+  // Get the shortest digits that round-trip, and print them the way
+  // Number.prototype.toString does.
+  auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value,
+                                    std::chars_format::scientific);
+  const char* p = buffer;
+  if (*p == '-') {
+    result_ += '-';
+    ++p;
+  }
+  const char* e = static_cast<const char*>(memchr(p, 'e', end - p));
+  // The digits are "d.ddd", or a single "d".
+  std::string_view first(p, 1);
+  std::string_view rest = e - p > 1 ? std::string_view(p + 2, e - p - 2)
+                                    : std::string_view();
+  int k = 1 + static_cast<int>(rest.size());
+  int exponent = 0;
+  std::from_chars(e + (e[1] == '+' ? 2 : 1), end, exponent);
+  int n = exponent + 1;
+  if (k <= n && n <= 21) {
+    result_ += first;
+    result_ += rest;
+    result_.append(n - k, '0');
+  } else if (0 < n && n <= 21) {
+    result_ += first;
+    result_ += rest.substr(0, n - 1);
+    result_ += '.';
+    result_ += rest.substr(n - 1);
+  } else if (-6 < n && n <= 0) {
+    result_ += "0.";
+    result_.append(-n, '0');
+    result_ += first;
+    result_ += rest;
+  } else {
+    result_ += first;
+    if (k > 1) {
+      result_ += '.';
+      result_ += rest;
+    }
+    result_ += exponent > 0 ? "e+" : "e-";
+    result_ += std::to_string(std::abs(exponent));
+  }
+}
+
+void JSONWriter::Write(const String& value) {
+  // Strings that have not been decoded are written without conversions.
+  if (const std::string* utf8 = value.undecoded_utf8())
+    WriteUTF8(*utf8);
+  else
+    WriteUTF16(value.value());
+}
+
+void JSONWriter::Write(CompactOptional<double> value) {
+  if (value)
+    Write(value.value());
+  else
+    result_ += "null";
+}
+
+void JSONWriter::WriteUTF8(std::string_view value) {
+  result_ += '"';
+  const char* p = value.data();
+  const char* end = p + value.size();
+  while (true) {
+    const char* special = FindSpecialByte(p, end);
+    result_.append(p, special);
+    if (special == end)
+      break;
+    AppendEscaped(result_, *special);
+    p = special + 1;
+  }
+  result_ += '"';
+}
+
+void JSONWriter::WriteUTF16(std::u16string_view value) {
+  result_ += '"';
+  for (size_t i = 0; i < value.size(); ++i) {
+    char16_t c = value[i];
+    if (c == '"' || c == '\\' || c < 0x20) {
+      AppendEscaped(result_, c);
+    } else if (c >= 0xD800 && c <= 0xDBFF && i + 1 < value.size() &&
+               value[i + 1] >= 0xDC00 && value[i + 1] <= 0xDFFF) {
+      AppendUTF8(result_, 0x10000 + ((c - 0xD800) << 10) +
+                          (value[i + 1] - 0xDC00));
+      ++i;
+    } else if (c >= 0xD800 && c <= 0xDFFF) {
+      // Lone surrogates are escaped like the well-formed JSON.stringify.
+      AppendEscaped(result_, c);
+    } else {
+      AppendUTF8(result_, c);
+    }
+  }
+  result_ += '"';
+}
+
+}  // namespace internal
+
+}  // namespace compilets
@@ -0,0 +1,276 @@
+#ifndef CPP_RUNTIME_JSON_H_
+#define CPP_RUNTIME_JSON_H_
+
+#include <concepts>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "cppgc/persistent.h"
+#include "runtime/array.h"
+#include "runtime/object.h"
+#include "runtime/optional.h"
+#include "runtime/string.h"
+
+namespace compilets {
+
+namespace internal {
+
+// Reads JSON text straight into the C++ type it is parsed as, without building
+// a tree of values first.
+//
+// The generated interfaces have a VisitProperties method calling the visitor
+// with the name and reference of each property, which is used for matching
+// the keys of JSON objects. Keys not in the interface are skipped, and
+// properties missing in JSON keep their default values.
+class JSONReader {
+ public:
+  explicit JSONReader(std::string_view json);
+
+  JSONReader& operator=(const JSONReader&) = delete;
+  JSONReader(const JSONReader&) = delete;
+
+  void Read(double& out);
+  void Read(bool& out);
+  void Read(sane::Bool& out);
+  void Read(String& out);
+  void Read(CompactOptional<double>& out);
+
+  template<typename T>
+  void Read(std::optional<T>& out) {
+    if (ConsumeNull())
+      out.reset();
+    else
+      Read(out.emplace());
+  }
+
+  template<typename T>
+  void Read(cppgc::Member<T>& out) {
+    T* value;
+    Read(value);
+    out = value;
+  }
+
+  template<typename T>
+  void Read(Array<T>*& out) {
+    if (ConsumeNull()) {
+      out = nullptr;
+      return;
+    }
+    Expect('[');
+    out = MakeArray<T>({});
+    auto& elements = out->value();
+    if (!Consume(']')) {
+      do {
+        Read(elements.emplace_back());
+      } while (Consume(','));
+      Expect(']');
+    }
+    out->length = static_cast<double>(elements.size());
+  }
+
+  template<typename T>
+    requires std::derived_from<T, Object>
+  void Read(T*& out) {
+    if (ConsumeNull()) {
+      out = nullptr;
+      return;
+    }
+    out = MakeObject<T>();
+    ReadProperties(*out);
+  }
+
+  template<typename T>
+    requires std::derived_from<T, Struct>
+  void Read(T& out) {
+    ReadProperties(out);
+  }
+
+  // Throw if there is anything but whitespace after the parsed value.
+  void Finish();
+
+ private:
+  template<typename T>
+  void ReadProperties(T& out) {
+    Expect('{');
+    if (Consume('}'))
+      return;
+    do {
+      std::string_view key = ReadKey();
+      bool found = false;
+      T::VisitProperties(out, [&](std::string_view name, auto& property) {
+        if (!found && name == key) {
+          found = true;
+          Read(property);
+        }
+      });
+      if (!found)
+        SkipValue();
+    } while (Consume(','));
+    Expect('}');
+  }
+
+  // Read a key and the colon after it, the returned view is only valid until
+  // next key is read.
+  std::string_view ReadKey();
+  // Read the contents of a string and return whether the bytes in
+  // string_buffer_ are used instead of the input.
+  bool ReadStringContents(std::string_view& contents);
+  void SkipValue();
+  void SkipWhitespace();
+  bool Consume(char c);
+  bool ConsumeNull();
+  void Expect(char c);
+  [[noreturn]] void ThrowUnexpected();
+
+  std::string_view json_;
+  size_t position_ = 0;
+  // Holds the strings which have escaped characters.
+  std::string string_buffer_;
+};
+
+// Writes values as JSON text encoded in UTF-8.
+class JSONWriter {
+ public:
+  JSONWriter() = default;
+
+  JSONWriter& operator=(const JSONWriter&) = delete;
+  JSONWriter(const JSONWriter&) = delete;
+
+  void Write(double value);
+  void Write(sane::Bool value) { Write(static_cast<bool>(value)); }
+  void Write(const String& value);
+  void Write(CompactOptional<double> value);
+
+  // Only takes bool, so that pointers are never written as booleans.
+  template<typename T>
+    requires std::same_as<T, bool>
+  void Write(T value) {
+    result_ += value ? "true" : "false";
+  }
+
+  template<typename T>
+  void Write(const std::optional<T>& value) {
+    if (value)
+      Write(*value);
+    else
+      result_ += "null";
+  }
+
+  template<typename T>
+  void Write(const cppgc::Member<T>& value) {
+    Write(static_cast<const T*>(value.Get()));
+  }
+
+  template<typename T>
+  void Write(const cppgc::Persistent<T>& value) {
+    Write(static_cast<const T*>(value.Get()));
+  }
+
+  template<typename T>
+  void Write(const Array<T>* value) {
+    if (!value) {
+      result_ += "null";
+      return;
+    }
+    result_ += '[';
+    bool first = true;
+    for (const auto& element : value->value()) {
+      if (!first)
+        result_ += ',';
+      first = false;
+      Write(element);
+    }
+    result_ += ']';
+  }
+
+  template<typename T>
+    requires std::derived_from<T, Object>
+  void Write(const T* value) {
+    if (value)
+      WriteProperties(*value);
+    else
+      result_ += "null";
+  }
+
+  template<typename T>
+    requires std::derived_from<T, Struct>
+  void Write(const T& value) {
+    WriteProperties(value);
+  }
+
+  std::string TakeResult() { return std::move(result_); }
+
+ private:
+  template<typename T>
+  void WriteProperties(const T& value) {
+    result_ += '{';
+    bool first = true;
+    T::VisitProperties(value, [&](std::string_view name, const auto& property) {
+      // Like undefined, empty optional properties are omitted.
+      if (IsEmptyOptional(property))
+        return;
+      if (!first)
+        result_ += ',';
+      first = false;
+      WriteUTF8(name);
+      result_ += ':';
+      Write(property);
+    });
+    result_ += '}';
+  }
+
+  static bool IsEmptyOptional(CompactOptional<double> value) {
+    return !value.has_value();
+  }
+
+  template<typename T>
+  static bool IsEmptyOptional(const std::optional<T>& value) {
+    return !value.has_value();
+  }
+
+  template<typename T>
+  static bool IsEmptyOptional(const T&) {
+    return false;
+  }
+
+  // Write the quoted string with characters escaped.
+  void WriteUTF8(std::string_view value);
+  void WriteUTF16(std::u16string_view value);
+
+  std::string result_;
+};
+
+}  // namespace internal
+
+namespace JSON {
+
+// Unlike JavaScript which returns any, the type of result must be known, and
+// it is decided by the TypeScript type of the JSON.parse call.
+template<typename T>
+ValueType<T> parse(const String& text) {
+  std::string utf8;
+  const std::string* json = text.undecoded_utf8();
+  if (!json) {
+    utf8 = text.ToUTF8();
+    json = &utf8;
+  }
+  internal::JSONReader reader(*json);
+  ValueType<T> result{};
+  reader.Read(result);
+  reader.Finish();
+  return result;
+}
+
+template<typename T>
+String stringify(const T& value) {
+  internal::JSONWriter writer;
+  writer.Write(value);
+  return String::FromUTF8Lazily(writer.TakeResult());
+}
+
+}  // namespace JSON
+
+}  // namespace compilets
+
+#endif  // CPP_RUNTIME_JSON_H_
@@ -0,0 +1,77 @@
+#ifndef CPP_RUNTIME_MAP_H_
+#define CPP_RUNTIME_MAP_H_
+
+#include "runtime/hash_table.h"
+#include "runtime/object.h"
+
+namespace compilets {
+
+template<typename K, typename V>
+struct MapEntry {
+  CppgcMemberType<K> key;
+  CppgcMemberType<V> value = {};
+};
+
+// The Map of JS, entries are iterated in insertion order.
+template<typename K, typename V>
+class Map final : public Object {
+ public:
+  using Entry = MapEntry<K, V>;
+
+  void clear() {
+    table_.Clear();
+    size = 0;
+  }
+
+  // The delete method, which is a keyword in C++.
+  bool erase(const ValueType<K>& key) {
+    bool deleted = table_.Erase(key);
+    size = static_cast<double>(table_.size());
+    return deleted;
+  }
+
+  OptionalValueType<V> get(const ValueType<K>& key) const {
+    const Entry* entry = table_.Find(key);
+    if (!entry)
+      return OptionalValueType<V>();
+    return entry->value;
+  }
+
+  bool has(const ValueType<K>& key) const {
+    return table_.Find(key) != nullptr;
+  }
+
+  Map* set(const ValueType<K>& key, const ValueType<V>& value) {
+    table_.FindOrInsert(key).value = value;
+    size = static_cast<double>(table_.size());
+    return this;
+  }
+
+  double size = 0;
+
+  auto begin() const { return table_.begin(); }
+  auto end() const { return table_.end(); }
+
+  void Trace(cppgc::Visitor* visitor) const override {
+    if constexpr (HasCppgcMember<CppgcMemberType<K>>::value ||
+                  HasCppgcMember<CppgcMemberType<V>>::value) {
+      table_.ForEach([visitor](const Entry& entry) {
+        TracePossibleMember(visitor, entry.key);
+        TracePossibleMember(visitor, entry.value);
+      });
+    }
+  }
+
+ private:
+  OrderedHashTable<Entry> table_;
+};
+
+// Convert map to string.
+template<typename K, typename V>
+inline std::u16string ToStringImpl(Map<K, V>* map) {
+  return u"[object Map]";
+}
+
+}  // namespace compilets
+
+#endif  // CPP_RUNTIME_MAP_H_
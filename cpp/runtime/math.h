@@ -1,10 +1,14 @@
 #ifndef CPP_RUNTIME_MATH_H_
 #define CPP_RUNTIME_MATH_H_
 
+#include <stdint.h>
+
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <limits>
 #include <numbers>
+#include <stdexcept>
 
 namespace compilets {
 
@@ -65,6 +69,17 @@ inline double Mod(A a, B b) {
     return std::fmod(a, b);
 }
 
+// The / operator of BigInt, which is represented by int64_t. Dividing by zero
+// throws RangeError like JS, and the quotient that does not fit in 64 bits is
+// rejected instead of being undefined behavior.
+inline int64_t BigIntDivide(int64_t a, int64_t b) {
+  if (b == 0)
+    throw std::range_error("Division by zero");
+  if (a == std::numeric_limits<int64_t>::min() && b == -1)
+    throw std::range_error("BigInt larger than 64 bits is not supported");
+  return a / b;
+}
+
 }  // namespace compilets
 
 #endif  // CPP_RUNTIME_MATH_H_
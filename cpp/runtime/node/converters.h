@@ -1,11 +1,129 @@
 #ifndef CPP_RUNTIME_NODE_CONVERTERS_H_
 #define CPP_RUNTIME_NODE_CONVERTERS_H_
 
+#include <string.h>
+
 #include "runtime/array.h"
+#include "runtime/buffer.h"
 #include "runtime/string.h"
 #include "runtime/union.h"
 #include "kizunapi/kizunapi.h"
 
+namespace compilets::internal {
+
+// Keeps a JS ArrayBuffer alive while native code is using its memory.
+//
+// The reference only prevents the ArrayBuffer from being garbage collected, if
+// JS detaches it (for example by ArrayBuffer.prototype.transfer() or by
+// transferring it with postMessage) while native code is still holding it, the
+// memory would be freed or moved and the pointer becomes dangling. This can not
+// be prevented with Node-API, and detached buffers are only detected when the
+// memory is converted back to JS.
+struct NodeBufferReference {
+  napi_env env;
+  napi_ref ref;
+};
+
+// The deleter of BackingStore wrapping JS memory, which is called when cppgc
+// sweeps the ArrayBuffer on the JS thread.
+inline void DeleteNodeBufferReference(uint8_t* data, size_t length,
+                                      void* hint) {
+  auto* reference = static_cast<NodeBufferReference*>(hint);
+  napi_delete_reference(reference->env, reference->ref);
+  delete reference;
+}
+
+// The finalizer of JS buffers using native memory, which releases the store.
+inline void ReleaseBackingStore(napi_env env, void* data, void* hint) {
+  delete static_cast<std::shared_ptr<BackingStore>*>(hint);
+}
+
+// Use the memory of JS ArrayBuffer without copying.
+inline std::shared_ptr<BackingStore> BackingStoreFromNode(napi_env env,
+                                                          napi_value value) {
+  bool is_arraybuffer = false;
+  if (napi_is_arraybuffer(env, value, &is_arraybuffer) != napi_ok ||
+      !is_arraybuffer) {
+    return nullptr;
+  }
+  void* data;
+  size_t length;
+  if (napi_get_arraybuffer_info(env, value, &data, &length) != napi_ok)
+    return nullptr;
+  auto* reference = new NodeBufferReference{env, nullptr};
+  if (napi_create_reference(env, value, 1, &reference->ref) != napi_ok) {
+    delete reference;
+    return nullptr;
+  }
+  return BackingStore::Wrap(static_cast<uint8_t*>(data), length,
+                            &DeleteNodeBufferReference, reference);
+}
+
+// Create a JS ArrayBuffer sharing the memory of the store.
+inline napi_status BackingStoreToNode(
+    napi_env env,
+    const std::shared_ptr<BackingStore>& store,
+    napi_value* result) {
+  // Memory coming from JS is returned as the original ArrayBuffer.
+  if (store->deleter() == &DeleteNodeBufferReference) {
+    auto* reference = static_cast<NodeBufferReference*>(store->hint());
+    napi_status s = napi_get_reference_value(env, reference->ref, result);
+    if (s != napi_ok)
+      return s;
+    bool is_detached = false;
+    s = napi_is_detached_arraybuffer(env, *result, &is_detached);
+    if (s == napi_ok && is_detached) {
+      napi_throw_error(env, nullptr,
+                       "ArrayBuffer was detached while used by native code");
+      return napi_pending_exception;
+    }
+    return s;
+  }
+  auto* hint = new std::shared_ptr<BackingStore>(store);
+  napi_status s = napi_create_external_arraybuffer(env,
+                                                   store->data(),
+                                                   store->length(),
+                                                   &ReleaseBackingStore,
+                                                   hint,
+                                                   result);
+  if (s == napi_ok)
+    return s;
+  delete hint;
+  // Runtimes with sandboxed memory like Electron do not allow external
+  // buffers, in which case the memory has to be copied.
+  void* data;
+  s = napi_create_arraybuffer(env, store->length(), &data, result);
+  if (s == napi_ok)
+    memcpy(data, store->data(), store->length());
+  return s;
+}
+
+// Create a Uint8Array or Buffer viewing the memory of JS Uint8Array.
+template<typename T>
+inline std::optional<T*> Uint8ArrayFromNode(napi_env env, napi_value value) {
+  bool is_typedarray = false;
+  if (napi_is_typedarray(env, value, &is_typedarray) != napi_ok ||
+      !is_typedarray) {
+    return std::nullopt;
+  }
+  napi_typedarray_type type;
+  size_t length;
+  napi_value arraybuffer;
+  size_t byte_offset;
+  if (napi_get_typedarray_info(env, value, &type, &length, nullptr,
+                               &arraybuffer, &byte_offset) != napi_ok ||
+      type != napi_uint8_array) {
+    return std::nullopt;
+  }
+  auto store = BackingStoreFromNode(env, arraybuffer);
+  if (!store)
+    return std::nullopt;
+  return MakeObject<T>(MakeObject<ArrayBuffer>(std::move(store)),
+                       byte_offset, length);
+}
+
+}  // namespace compilets::internal
+
 namespace ki {
 
 using namespace compilets;
@@ -46,24 +164,164 @@ struct Type<String> {
   }
 };
 
+// Convert ArrayBuffer to/from JS without copying the memory.
+template<>
+struct Type<ArrayBuffer*> {
+  static constexpr const char* name = "ArrayBuffer";
+  static napi_status ToNode(napi_env env,
+                            const ArrayBuffer* buffer,
+                            napi_value* result) {
+    return compilets::internal::BackingStoreToNode(env, buffer->store(),
+                                                   result);
+  }
+  static std::optional<ArrayBuffer*> FromNode(napi_env env, napi_value value) {
+    auto store = compilets::internal::BackingStoreFromNode(env, value);
+    if (store)
+      return MakeObject<ArrayBuffer>(std::move(store));
+    else
+      return std::nullopt;
+  }
+};
+
+// Convert Uint8Array to/from JS, which shares the memory of its ArrayBuffer.
+template<>
+struct Type<Uint8Array*> {
+  static constexpr const char* name = "Uint8Array";
+  static napi_status ToNode(napi_env env,
+                            const Uint8Array* array,
+                            napi_value* result) {
+    napi_value arraybuffer;
+    napi_status s = compilets::internal::BackingStoreToNode(
+        env, array->buffer->store(), &arraybuffer);
+    if (s != napi_ok)
+      return s;
+    size_t byte_offset = array->data() - array->buffer->data();
+    return napi_create_typedarray(env, napi_uint8_array, array->size(),
+                                  arraybuffer, byte_offset, result);
+  }
+  static std::optional<Uint8Array*> FromNode(napi_env env, napi_value value) {
+    return compilets::internal::Uint8ArrayFromNode<Uint8Array>(env, value);
+  }
+};
+
+// Convert Buffer to/from JS. Memory coming from JS is returned as a Buffer
+// viewing the original ArrayBuffer, otherwise the Buffer passed to JS is an
+// external buffer that keeps the memory alive.
+template<>
+struct Type<nodejs::Buffer*> {
+  static constexpr const char* name = "Buffer";
+  static napi_status ToNode(napi_env env,
+                            const nodejs::Buffer* buffer,
+                            napi_value* result) {
+    const auto& store = buffer->buffer->store();
+    if (store->deleter() == &compilets::internal::DeleteNodeBufferReference)
+      return ViewToNode(env, buffer, result);
+    auto* hint = new std::shared_ptr<compilets::internal::BackingStore>(
+        buffer->buffer->store());
+    napi_status s = napi_create_external_buffer(
+        env, buffer->size(), buffer->data(),
+        &compilets::internal::ReleaseBackingStore, hint, result);
+    if (s == napi_ok)
+      return s;
+    delete hint;
+    return napi_create_buffer_copy(env, buffer->size(), buffer->data(),
+                                   nullptr, result);
+  }
+  static std::optional<nodejs::Buffer*> FromNode(napi_env env,
+                                                 napi_value value) {
+    return compilets::internal::Uint8ArrayFromNode<nodejs::Buffer>(env, value);
+  }
+
+ private:
+  // Node-API can not create a Buffer from an ArrayBuffer, so call
+  // Buffer.from(arrayBuffer, byteOffset, length) which shares the memory.
+  static napi_status ViewToNode(napi_env env,
+                                const nodejs::Buffer* buffer,
+                                napi_value* result) {
+    napi_value args[3];
+    napi_status s = compilets::internal::BackingStoreToNode(
+        env, buffer->buffer->store(), &args[0]);
+    if (s != napi_ok)
+      return s;
+    size_t byte_offset = buffer->data() - buffer->buffer->data();
+    napi_value global, constructor, from;
+    if ((s = napi_get_global(env, &global)) != napi_ok ||
+        (s = napi_get_named_property(env, global, "Buffer",
+                                     &constructor)) != napi_ok ||
+        (s = napi_get_named_property(env, constructor, "from",
+                                     &from)) != napi_ok ||
+        (s = napi_create_double(env, static_cast<double>(byte_offset),
+                                &args[1])) != napi_ok ||
+        (s = napi_create_double(env, static_cast<double>(buffer->size()),
+                                &args[2])) != napi_ok) {
+      return s;
+    }
+    return napi_call_function(env, constructor, from, 3, args, result);
+  }
+};
+
 // Convert Union to/from JS.
 template<typename... Ts>
-struct Type<Union<Ts...>> {
+struct Type<VariantUnion<Ts...>> {
   static constexpr const char* name = "Union";
   static napi_status ToNode(napi_env env,
-                            const Union<Ts...>& var,
+                            const VariantUnion<Ts...>& var,
                             napi_value* result) {
     return Type<std::variant<Ts...>>::ToNode(env, var, result);
   }
-  static std::optional<Union<Ts...>> FromNode(napi_env env, napi_value value) {
+  static std::optional<VariantUnion<Ts...>> FromNode(napi_env env,
+                                                     napi_value value) {
     auto var = Type<std::variant<Ts...>>::FromNode(env, value);
     if (var)
-      return Union<Ts...>(std::move(var.value()));
+      return VariantUnion<Ts...>(std::move(var.value()));
+    else
+      return std::nullopt;
+  }
+};
+
+// The packed unions are converted through std::variant.
+template<typename... Ts>
+struct Type<CompactUnion<Ts...>> {
+  static constexpr const char* name = "Union";
+  static napi_status ToNode(napi_env env,
+                            const CompactUnion<Ts...>& value,
+                            napi_value* result) {
+    return Type<VariantUnion<Ts...>>::ToNode(env, VariantUnion<Ts...>(value),
+                                             result);
+  }
+  static std::optional<CompactUnion<Ts...>> FromNode(napi_env env,
+                                                     napi_value value) {
+    auto var = Type<VariantUnion<Ts...>>::FromNode(env, value);
+    if (var)
+      return CompactUnion<Ts...>(var.value());
     else
       return std::nullopt;
   }
 };
 
+// The compact optional numbers are converted through std::optional.
+template<>
+struct Type<CompactOptional<double>> {
+  static constexpr const char* name = "Optional";
+  static napi_status ToNode(napi_env env,
+                            CompactOptional<double> value,
+                            napi_value* result) {
+    std::optional<double> opt;
+    if (value)
+      opt = value.value();
+    return Type<std::optional<double>>::ToNode(env, opt, result);
+  }
+  static std::optional<CompactOptional<double>> FromNode(napi_env env,
+                                                         napi_value value) {
+    auto opt = Type<std::optional<double>>::FromNode(env, value);
+    if (!opt)
+      return std::nullopt;
+    if (opt.value())
+      return CompactOptional<double>(opt.value().value());
+    return CompactOptional<double>();
+  }
+};
+
 // Store the pointers as cppgc::Persistent in JS objects.
 template<typename T>
 struct TypeBridge<T, std::enable_if_t<std::is_base_of_v<Object, T>>> {
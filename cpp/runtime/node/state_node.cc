@@ -3,11 +3,15 @@
 #include "cppgc/heap.h"
 #include "node/node.h"
 #include "node/v8-cppgc.h"
+#include "runtime/console.h"
 
 namespace compilets {
 
 StateNode::StateNode()
-    : isolate_(v8::Isolate::GetCurrent()) {}
+    : isolate_(v8::Isolate::GetCurrent()) {
+  // Flush every line so the output interleaves with the JS code's.
+  internal::OutputStream::Stdout().set_line_buffered(true);
+}
 
 void StateNode::PreciseGC() {
   isolate_->MemoryPressureNotification(v8::MemoryPressureLevel::kCritical);
@@ -17,4 +21,22 @@ cppgc::AllocationHandle& StateNode::GetAllocationHandle() {
   return isolate_->GetCppHeap()->GetAllocationHandle();
 }
 
+cppgc::HeapHandle& StateNode::GetHeapHandle() {
+  return isolate_->GetCppHeap()->GetHeapHandle();
+}
+
+EventLoop* StateNode::GetEventLoop() {
+  // Native modules run in the libuv loop of Node.js, which timers have not
+  // been integrated with.
+  return nullptr;
+}
+
+void StateNode::PostMicrotask(std::coroutine_handle<> handle) {
+  // Use the microtask queue of V8, which Node.js drains after every callback
+  // like the promises of JS.
+  isolate_->EnqueueMicrotask([](void* data) {
+    std::coroutine_handle<>::from_address(data).resume();
+  }, handle.address());
+}
+
 }  // namespace compilets
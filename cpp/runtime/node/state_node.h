@@ -16,6 +16,9 @@ class StateNode : public State {
   // State:
   void PreciseGC() override;
   cppgc::AllocationHandle& GetAllocationHandle() override;
+  cppgc::HeapHandle& GetHeapHandle() override;
+  EventLoop* GetEventLoop() override;
+  void PostMicrotask(std::coroutine_handle<> handle) override;
 
  private:
   v8::Isolate* isolate_;
@@ -4,6 +4,7 @@
 #include "cppgc/allocation.h"
 #include "cppgc/garbage-collected.h"
 #include "cppgc/prefinalizer.h"
+#include "runtime/allocation_profiler.h"
 #include "runtime/runtime.h"
 #include "runtime/type_traits.h"
 
@@ -15,9 +16,13 @@ class Object : public cppgc::GarbageCollected<Object> {
   virtual void Trace(cppgc::Visitor* visitor) const {}
 };
 
+// Base class for TypeScript interfaces that are passed by value.
+struct Struct {};
+
 // Helper to create an object type.
 template<typename T, typename... Args>
-T* MakeObject(Args&&... args) {
+COMPILETS_ALLOCATION_SITE T* MakeObject(Args&&... args) {
+  COMPILETS_RECORD_ALLOCATION(T, sizeof(T));
   return cppgc::MakeGarbageCollected<T>(GetAllocationHandle(),
                                         std::forward<Args>(args)...);
 }
@@ -42,6 +47,15 @@ inline std::u16string ToStringImpl(Object* value) {
   return u"<object>";
 }
 
+inline std::u16string ToStringImpl(const Struct& value) {
+  return u"<object>";
+}
+
+// Values are always true like objects.
+inline bool IsTrueImpl(const Struct& value) {
+  return true;
+}
+
 // Make T* for objects.
 template<typename T>
 struct Value<T, std::enable_if_t<std::is_base_of_v<Object, T>>> {
@@ -0,0 +1,80 @@
+#ifndef CPP_RUNTIME_OPTIONAL_H_
+#define CPP_RUNTIME_OPTIONAL_H_
+
+#include <stdint.h>
+
+#include <bit>
+#include <optional>
+#include <type_traits>
+
+namespace compilets {
+
+template<typename T>
+class CompactOptional;
+
+// Optional number that takes 8 bytes instead of the 16 bytes of
+// std::optional<double>, by using a signaling NaN as the undefined state.
+// Arithmetic never produces signaling NaNs, the only way to get one is to
+// reinterpret bits, and such values are stored as the usual quiet NaN.
+template<>
+class CompactOptional<double> {
+ public:
+  constexpr CompactOptional() = default;
+  constexpr CompactOptional(std::nullopt_t) {}
+  constexpr CompactOptional(double value)
+      : bits_(std::bit_cast<uint64_t>(value)) {
+    if (bits_ == kUndefinedBits) [[unlikely]]
+      bits_ = kQuietNaNBits;
+  }
+
+  constexpr CompactOptional& operator=(std::nullopt_t) {
+    bits_ = kUndefinedBits;
+    return *this;
+  }
+
+  constexpr bool has_value() const { return bits_ != kUndefinedBits; }
+  constexpr explicit operator bool() const { return has_value(); }
+
+  // Reading the undefined state gives NaN, which is what JS gets when
+  // converting undefined to number, so there is no check like std::optional.
+  constexpr double value() const { return std::bit_cast<double>(bits_); }
+  constexpr double operator*() const { return value(); }
+
+  constexpr double value_or(double other) const {
+    return has_value() ? value() : other;
+  }
+
+  constexpr void reset() { bits_ = kUndefinedBits; }
+
+  friend constexpr bool operator==(CompactOptional left,
+                                   CompactOptional right) {
+    if (!left || !right)
+      return left.bits_ == right.bits_;
+    return left.value() == right.value();
+  }
+
+  friend constexpr bool operator==(CompactOptional left, std::nullopt_t) {
+    return !left;
+  }
+
+  friend constexpr bool operator==(CompactOptional left, double right) {
+    return left.value() == right;
+  }
+
+ private:
+  static constexpr uint64_t kUndefinedBits = 0x7ff4'0000'0000'0001;
+  static constexpr uint64_t kQuietNaNBits = 0x7ff8'0000'0000'0000;
+
+  uint64_t bits_ = kUndefinedBits;
+};
+
+// The type used for optional values, numbers use the compact representation
+// while other types use std::optional.
+template<typename T>
+using Optional = std::conditional_t<std::is_same_v<T, double>,
+                                    CompactOptional<double>,
+                                    std::optional<T>>;
+
+}  // namespace compilets
+
+#endif  // CPP_RUNTIME_OPTIONAL_H_
@@ -1,6 +1,52 @@
 #include "runtime/process.h"
 
-namespace compilets::nodejs {
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace compilets {
+
+namespace internal {
+
+namespace {
+
+// Initialized before main, which is close enough to the start of process.
+const int64_t g_time_origin = MonotonicNow();
+
+}  // namespace
+
+int64_t MonotonicNow() {
+#if defined(_WIN32)
+  static const int64_t frequency = []() {
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    return frequency.QuadPart;
+  }();
+  LARGE_INTEGER counter;
+  QueryPerformanceCounter(&counter);
+  // Split the multiplication to avoid overflow.
+  return counter.QuadPart / frequency * 1000000000 +
+         counter.QuadPart % frequency * 1000000000 / frequency;
+#else
+  // CLOCK_MONOTONIC is served by the vDSO on Linux, and by commpage on macOS.
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+int64_t GetTimeOrigin() {
+  return g_time_origin;
+}
+
+}  // namespace internal
+
+namespace nodejs {
+
+Process::Process()
+    : argv(MakeObject<Array<String>>()), hrtime(MakeObject<HRTime>()) {}
 
 void Process::exit() {
   ::exit(0);
@@ -13,4 +59,24 @@ void Process::exit(std::variant<double, std::monostate> arg) {
   ::exit(code);
 }
 
-}  // namespace compilets::nodejs
+void Process::SetArgv(int argc, const char** args) {
+  // Like the single executable applications of Node.js, the executable is put
+  // in the places of both node and the script, so the arguments start from
+  // process.argv[2].
+  sane::vector<String> values;
+  for (int i = 0; i < argc; ++i) {
+    values.push_back(String::FromUTF8(args[i]));
+    if (i == 0)
+      values.push_back(values[0]);
+  }
+  argv = MakeArray<String>(std::move(values));
+}
+
+void Process::Trace(cppgc::Visitor* visitor) const {
+  TraceMember(visitor, argv);
+  TraceMember(visitor, hrtime);
+}
+
+}  // namespace nodejs
+
+}  // namespace compilets
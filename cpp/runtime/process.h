@@ -1,18 +1,60 @@
 #ifndef CPP_RUNTIME_PROCESS_H_
 #define CPP_RUNTIME_PROCESS_H_
 
+#include <stdint.h>
+
 #include <variant>
 
+#include "runtime/array.h"
 #include "runtime/object.h"
+#include "runtime/string.h"
+
+namespace compilets {
+
+namespace internal {
+
+// Nanoseconds from a monotonic clock, which is read without syscall on Linux.
+int64_t MonotonicNow();
+
+// The time when the process started, in nanoseconds of MonotonicNow().
+int64_t GetTimeOrigin();
 
-namespace compilets::nodejs {
+}  // namespace internal
+
+namespace nodejs {
+
+// process.hrtime
+class HRTime final : public Object {
+ public:
+  int64_t bigint() const { return internal::MonotonicNow(); }
+};
 
 class Process : public Object {
  public:
+  Process();
+
   void exit();
   void exit(std::variant<double, std::monostate> arg);
+
+  // Fill process.argv with the arguments passed to main.
+  void SetArgv(int argc, const char** args);
+
+  void Trace(cppgc::Visitor* visitor) const override;
+
+  cppgc::Member<Array<String>> argv;
+  cppgc::Member<HRTime> hrtime;
 };
 
-}  // namespace compilets::nodejs
+class Performance : public Object {
+ public:
+  // Milliseconds since the process started.
+  double now() const {
+    return (internal::MonotonicNow() - internal::GetTimeOrigin()) / 1e6;
+  }
+};
+
+}  // namespace nodejs
+
+}  // namespace compilets
 
 #endif  // CPP_RUNTIME_PROCESS_H_
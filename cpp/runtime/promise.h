@@ -0,0 +1,221 @@
+#ifndef CPP_RUNTIME_PROMISE_H_
+#define CPP_RUNTIME_PROMISE_H_
+
+#include <coroutine>
+#include <exception>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "cppgc/persistent.h"
+#include "runtime/coroutine.h"
+#include "runtime/function.h"
+
+namespace compilets {
+
+template<typename T>
+class Promise;
+
+namespace internal {
+
+// The stored result and the signature of the resolve function of Promise<T>,
+// void promises store nothing and their resolve function takes no argument.
+template<typename T>
+struct PromiseTraits {
+  using Storage = CppgcMemberType<T>;
+  using ResolveSignature = void(ValueType<T>);
+};
+
+template<>
+struct PromiseTraits<void> {
+  using Storage = std::monostate;
+  using ResolveSignature = void();
+};
+
+}  // namespace internal
+
+// The promise object, which is returned by async functions and is settled by
+// them, or created with the executor that receives the resolve function.
+//
+// Rejections are not supported, errors thrown in async functions propagate to
+// the code that resumed the coroutine.
+template<typename T>
+class Promise final : public Object {
+ public:
+  using ResolveSignature = typename internal::PromiseTraits<T>::ResolveSignature;
+
+  // The coroutine promise of async functions, defined below.
+  class promise_type;
+
+  // Suspends the awaiting coroutine until the promise is settled.
+  class Awaiter {
+   public:
+    explicit Awaiter(Promise* promise) : promise_(promise) {}
+
+    // Awaiting a settled promise does not suspend, which neither allocates
+    // nor waits for the microtask queue.
+    bool await_ready() const { return promise_->settled_; }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+      // The frame of suspended coroutine is not scanned by GC.
+      pin_ = promise_;
+      promise_->waiters_.push_back(handle);
+    }
+
+    auto await_resume() const {
+      if constexpr (!std::is_void_v<T>)
+        return ValueType<T>(promise_->value_);
+    }
+
+   private:
+    Promise* promise_;
+    cppgc::Persistent<Promise> pin_;
+  };
+
+  Promise() = default;
+
+  // new Promise((resolve) => { ... })
+  template<typename Executor>
+  explicit Promise(Executor* executor) {
+    Function<ResolveSignature>* resolve;
+    if constexpr (std::is_void_v<T>) {
+      resolve = MakeFunction<ResolveSignature>([this]() {
+        Resolve();
+      }, this);
+    } else {
+      resolve = MakeFunction<ResolveSignature>([this](ValueType<T> value) {
+        Resolve(std::move(value));
+      }, this);
+    }
+    executor->value()(resolve);
+  }
+
+  // Settle the promise and queue the awaiting coroutines as microtasks, it
+  // does nothing if the promise has been settled.
+  template<typename... Args>
+  void Resolve(Args&&... args) {
+    if (settled_)
+      return;
+    settled_ = true;
+    if constexpr (!std::is_void_v<T>)
+      value_ = ValueType<T>(std::forward<Args>(args)...);
+    if (waiters_.empty())
+      return;
+    State* state = State::Get();
+    for (std::coroutine_handle<> handle : waiters_)
+      state->PostMicrotask(handle);
+    waiters_.clear();
+  }
+
+  bool settled() const { return settled_; }
+
+  void Trace(cppgc::Visitor* visitor) const override {
+    TracePossibleMember(visitor, value_);
+  }
+
+ private:
+  bool settled_ = false;
+  typename internal::PromiseTraits<T>::Storage value_ = {};
+  std::vector<std::coroutine_handle<>> waiters_;
+};
+
+namespace internal {
+
+// Implements co_return in async functions, which resolves the promise.
+template<typename T>
+class AsyncFunctionReturn {
+ public:
+  void return_value(ValueType<T> value) {
+    promise_->Resolve(std::move(value));
+  }
+
+ protected:
+  cppgc::Persistent<Promise<T>> promise_;
+};
+
+template<>
+class AsyncFunctionReturn<void> {
+ public:
+  void return_void() {
+    promise_->Resolve();
+  }
+
+ protected:
+  cppgc::Persistent<Promise<void>> promise_;
+};
+
+}  // namespace internal
+
+// The async function starts running immediately, and frees its frame after
+// returning. While running, the frame keeps the returned promise alive, so
+// the function can finish even if nothing else references the promise.
+template<typename T>
+class Promise<T>::promise_type : public internal::AsyncFunctionReturn<T> {
+ public:
+  Promise* get_return_object() {
+    this->promise_ = MakeObject<Promise>();
+    return this->promise_.Get();
+  }
+
+  std::suspend_never initial_suspend() noexcept { return {}; }
+  std::suspend_never final_suspend() noexcept { return {}; }
+
+  void unhandled_exception() {
+    std::rethrow_exception(std::current_exception());
+  }
+
+  // The awaited promises are pointers, which need to be converted to awaiters
+  // explicitly.
+  template<typename U>
+  typename Promise<U>::Awaiter await_transform(Promise<U>* promise) {
+    return typename Promise<U>::Awaiter(promise);
+  }
+
+  template<typename U>
+  typename Promise<U>::Awaiter await_transform(
+      const cppgc::Persistent<Promise<U>>& promise) {
+    return typename Promise<U>::Awaiter(promise.Get());
+  }
+
+  template<typename U>
+  typename Promise<U>::Awaiter await_transform(
+      const cppgc::Member<Promise<U>>& promise) {
+    return typename Promise<U>::Awaiter(promise.Get());
+  }
+
+  static void* operator new(size_t size) {
+    return internal::AllocateFrame(size);
+  }
+
+  static void operator delete(void* frame, size_t size) {
+    internal::FreeFrame(frame, size);
+  }
+};
+
+// The static methods of Promise.
+class PromiseConstructor {
+ public:
+  template<typename T, typename... Args>
+  static Promise<T>* resolve(Args&&... args) {
+    Promise<T>* promise = MakeObject<Promise<T>>();
+    promise->Resolve(std::forward<Args>(args)...);
+    return promise;
+  }
+};
+
+// Convert promise to string.
+template<typename T>
+inline std::u16string ToStringImpl(Promise<T>* promise) {
+  return u"[object Promise]";
+}
+
+}  // namespace compilets
+
+// The async functions return a pointer to the GC object, which needs the
+// promise type to be specified explicitly.
+template<typename T, typename... Args>
+struct std::coroutine_traits<compilets::Promise<T>*, Args...> {
+  using promise_type = typename compilets::Promise<T>::promise_type;
+};
+
+#endif  // CPP_RUNTIME_PROMISE_H_
@@ -0,0 +1,117 @@
+#include "runtime/readline.h"
+
+#include <errno.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <string_view>
+
+namespace compilets {
+
+namespace internal {
+
+// static
+LineReader& LineReader::Stdin() {
+  static LineReader reader(0);
+  return reader;
+}
+
+LineReader::LineReader(int fd, size_t buffer_size)
+    : fd_(fd), buffer_(buffer_size, '\0') {}
+
+std::optional<String> LineReader::ReadLine() {
+  // Number of unread bytes known to have no "\n", which are not scanned again
+  // after reading more.
+  size_t scanned = 0;
+  size_t line_end;
+  while (true) {
+    const char* start = buffer_.data() + begin_ + scanned;
+    const void* found = memchr(start, '\n', end_ - begin_ - scanned);
+    if (found) {
+      line_end = static_cast<const char*>(found) - buffer_.data();
+      break;
+    }
+    scanned = end_ - begin_;
+    if (!Fill()) {
+      // The last line may not end with a line break.
+      if (begin_ == end_)
+        return std::nullopt;
+      line_end = end_;
+      break;
+    }
+  }
+  std::string_view line(buffer_.data() + begin_, line_end - begin_);
+  size_t next = line_end < end_ ? line_end + 1 : end_;
+  // Both "\r\n" and a lone "\r" end the line.
+  size_t cr = line.find('\r');
+  if (cr != std::string_view::npos) {
+    if (cr + 1 < line.size())
+      next = begin_ + cr + 1;
+    line = line.substr(0, cr);
+  }
+  begin_ = next;
+  return String::FromUTF8Lazily(std::string(line));
+}
+
+bool LineReader::Fill() {
+  if (eof_)
+    return false;
+  if (begin_ > 0) {
+    memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+    end_ -= begin_;
+    begin_ = 0;
+  }
+  // The buffer is full of one line.
+  if (end_ == buffer_.size())
+    buffer_.resize(buffer_.size() * 2);
+  while (true) {
+#if defined(_WIN32)
+    int n = _read(fd_, buffer_.data() + end_,
+                  static_cast<unsigned>(buffer_.size() - end_));
+#else
+    ssize_t n = read(fd_, buffer_.data() + end_, buffer_.size() - end_);
+#endif
+    if (n < 0 && errno == EINTR)
+      continue;
+    // Read errors are treated as the end of input like closed pipes.
+    if (n <= 0) {
+      eof_ = true;
+      return false;
+    }
+    end_ += n;
+    return true;
+  }
+}
+
+}  // namespace internal
+
+namespace nodejs {
+
+namespace readline {
+
+Interface::Interface(internal::LineReader* reader) : reader_(reader) {}
+
+void Interface::close() {
+  closed_ = true;
+}
+
+std::optional<String> Interface::ReadLine() {
+  if (closed_)
+    return std::nullopt;
+  return reader_->ReadLine();
+}
+
+Interface* createInterface() {
+  return MakeObject<Interface>(&internal::LineReader::Stdin());
+}
+
+}  // namespace readline
+
+}  // namespace nodejs
+
+}  // namespace compilets
@@ -0,0 +1,102 @@
+#ifndef CPP_RUNTIME_READLINE_H_
+#define CPP_RUNTIME_READLINE_H_
+
+#include <iterator>
+#include <optional>
+#include <string>
+
+#include "runtime/object.h"
+#include "runtime/string.h"
+
+namespace compilets {
+
+namespace internal {
+
+// Synchronous reader of lines from a file descriptor.
+//
+// The input is read in large chunks and line breaks are found with memchr,
+// which C libraries implement with SIMD instructions. Lines are handed out as
+// lazily decoded strings, so filters that print the lines they match do not
+// convert most bytes to UTF-16 and back.
+class LineReader {
+ public:
+  static constexpr size_t kBufferSize = 1024 * 1024;
+
+  // The reader of stdin shared by all readline interfaces.
+  static LineReader& Stdin();
+
+  explicit LineReader(int fd, size_t buffer_size = kBufferSize);
+
+  LineReader& operator=(const LineReader&) = delete;
+  LineReader(const LineReader&) = delete;
+
+  // Return the next line without its line break, which is "\n", "\r\n" or a
+  // lone "\r" like readline, or std::nullopt at the end of input.
+  std::optional<String> ReadLine();
+
+ private:
+  // Move the unread bytes to the front and read more after them, returns
+  // false at the end of input.
+  bool Fill();
+
+  int fd_;
+  std::string buffer_;
+  // The unread bytes are [begin_, end_) of the buffer.
+  size_t begin_ = 0;
+  size_t end_ = 0;
+  bool eof_ = false;
+};
+
+}  // namespace internal
+
+namespace nodejs {
+
+namespace readline {
+
+// The readline interface, which is iterated by the for await...of loop.
+//
+// The input is read synchronously, the loop blocks when waiting for more input
+// instead of running other tasks in the event loop.
+class Interface final : public Object {
+ public:
+  class Iterator {
+   public:
+    explicit Iterator(Interface* rl) : rl_(rl) { ++*this; }
+
+    const String& operator*() const { return *line_; }
+    Iterator& operator++() {
+      line_ = rl_->ReadLine();
+      return *this;
+    }
+    bool operator==(std::default_sentinel_t) const { return !line_; }
+
+   private:
+    Interface* rl_;
+    std::optional<String> line_;
+  };
+
+  explicit Interface(internal::LineReader* reader);
+
+  void close();
+
+  Iterator begin() { return Iterator(this); }
+  std::default_sentinel_t end() { return {}; }
+
+ private:
+  std::optional<String> ReadLine();
+
+  internal::LineReader* reader_;
+  bool closed_ = false;
+};
+
+// readline.createInterface({input: process.stdin}), stdin is the only input
+// supported.
+Interface* createInterface();
+
+}  // namespace readline
+
+}  // namespace nodejs
+
+}  // namespace compilets
+
+#endif  // CPP_RUNTIME_READLINE_H_
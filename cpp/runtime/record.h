@@ -0,0 +1,140 @@
+#ifndef CPP_RUNTIME_RECORD_H_
+#define CPP_RUNTIME_RECORD_H_
+
+#include <initializer_list>
+
+#include "runtime/array.h"
+#include "runtime/hash_table.h"
+#include "runtime/object.h"
+#include "runtime/string.h"
+
+namespace compilets {
+
+namespace internal {
+
+// Reading a missing property gives undefined, which is NaN for numbers and
+// the default value for other types.
+template<typename T>
+inline ValueType<T> UndefinedRecordValue() {
+  if constexpr (std::is_same_v<ValueType<T>, double>)
+    return std::numeric_limits<double>::quiet_NaN();
+  else
+    return ValueType<T>();
+}
+
+}  // namespace internal
+
+template<typename T>
+struct RecordEntry {
+  String key;
+  // Properties added by compound assignments start from undefined.
+  CppgcMemberType<T> value = internal::UndefinedRecordValue<T>();
+};
+
+// Objects used as dictionaries, i.e. Record<string, T> and {[key: string]: T},
+// the properties are enumerated in the order they are added.
+template<typename T>
+class Record final : public Object {
+ public:
+  using Entry = RecordEntry<T>;
+
+  Record() = default;
+
+  // The keys of object literal are property names, which are interned.
+  explicit Record(std::initializer_list<Entry> entries) {
+    for (const Entry& entry : entries)
+      at(entry.key.Intern()) = entry.value;
+  }
+
+  // Return the property for assignment, which is added when missing.
+  //
+  // Keys given as literals are interned when added, so lookups with interned
+  // property names compare by pointer. Other keys are stored as they are, as
+  // interned strings are never freed and dynamic keys are unbounded.
+  template<typename K>
+  CppgcMemberType<T>& at(const K& key) {
+    Entry& entry = table_.FindOrInsert(key);
+    if constexpr (!std::is_same_v<K, String>) {
+      if (!entry.key.IsInterned())
+        entry.key = entry.key.Intern();
+    }
+    return entry.value;
+  }
+
+  // Reading a missing property gives undefined.
+  template<typename K>
+  ValueType<T> get(const K& key) const {
+    const Entry* entry = table_.Find(key);
+    if (entry)
+      return entry->value;
+    return internal::UndefinedRecordValue<T>();
+  }
+
+  // The in operator.
+  template<typename K>
+  bool has(const K& key) const {
+    return table_.Find(key) != nullptr;
+  }
+
+  // The delete operator, which evaluates to true even when key is missing.
+  template<typename K>
+  bool erase(const K& key) {
+    table_.Erase(key);
+    return true;
+  }
+
+  size_t size() const { return table_.size(); }
+
+  auto begin() const { return table_.begin(); }
+  auto end() const { return table_.end(); }
+
+  void Trace(cppgc::Visitor* visitor) const override {
+    if constexpr (HasCppgcMember<CppgcMemberType<T>>::value) {
+      table_.ForEach([visitor](const Entry& entry) {
+        TracePossibleMember(visitor, entry.value);
+      });
+    }
+  }
+
+ private:
+  OrderedHashTable<Entry> table_;
+};
+
+// Helper to create the Record from object literal.
+template<typename T>
+inline Record<T>* MakeRecord(std::initializer_list<RecordEntry<T>> entries) {
+  return MakeObject<Record<T>>(entries);
+}
+
+// The static methods of Object, which only work with records as the properties
+// of other objects are not known at runtime.
+class ObjectConstructor {
+ public:
+  template<typename T>
+  static Array<String>* keys(const Record<T>* record) {
+    sane::vector<String> result;
+    result.reserve(record->size());
+    for (const RecordEntry<T>& entry : *record)
+      result.push_back(entry.key);
+    return MakeArray<String>(std::move(result));
+  }
+
+  template<typename T>
+  static Array<CppgcMemberType<T>>* values(const Record<T>* record) {
+    sane::vector<CppgcMemberType<T>> result;
+    result.reserve(record->size());
+    for (const RecordEntry<T>& entry : *record)
+      result.push_back(entry.value);
+    return MakeArray<CppgcMemberType<T>>(std::move(result));
+  }
+};
+
+// Convert record to string.
+template<typename T>
+inline std::u16string ToStringImpl(Record<T>* record) {
+  return u"[object Object]";
+}
+
+}  // namespace compilets
+
+#endif  // CPP_RUNTIME_RECORD_H_
@@ -15,6 +15,7 @@ namespace compilets {
 // Globals of Node.js.
 namespace nodejs {
 extern Console* console;
+extern Performance* performance;
 extern Process* process;
 extern std::optional<std::function<void()>> gc;
 }
@@ -0,0 +1,67 @@
+#ifndef CPP_RUNTIME_SET_H_
+#define CPP_RUNTIME_SET_H_
+
+#include "runtime/hash_table.h"
+#include "runtime/object.h"
+
+namespace compilets {
+
+template<typename T>
+struct SetEntry {
+  CppgcMemberType<T> key;
+};
+
+// The Set of JS, values are iterated in insertion order.
+template<typename T>
+class Set final : public Object {
+ public:
+  using Entry = SetEntry<T>;
+
+  Set* add(const ValueType<T>& value) {
+    table_.FindOrInsert(value);
+    size = static_cast<double>(table_.size());
+    return this;
+  }
+
+  void clear() {
+    table_.Clear();
+    size = 0;
+  }
+
+  // The delete method, which is a keyword in C++.
+  bool erase(const ValueType<T>& value) {
+    bool deleted = table_.Erase(value);
+    size = static_cast<double>(table_.size());
+    return deleted;
+  }
+
+  bool has(const ValueType<T>& value) const {
+    return table_.Find(value) != nullptr;
+  }
+
+  double size = 0;
+
+  auto begin() const { return table_.begin(); }
+  auto end() const { return table_.end(); }
+
+  void Trace(cppgc::Visitor* visitor) const override {
+    if constexpr (HasCppgcMember<CppgcMemberType<T>>::value) {
+      table_.ForEach([visitor](const Entry& entry) {
+        TracePossibleMember(visitor, entry.key);
+      });
+    }
+  }
+
+ private:
+  OrderedHashTable<Entry> table_;
+};
+
+// Convert set to string.
+template<typename T>
+inline std::u16string ToStringImpl(Set<T>* set) {
+  return u"[object Set]";
+}
+
+}  // namespace compilets
+
+#endif  // CPP_RUNTIME_SET_H_
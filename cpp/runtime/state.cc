@@ -2,6 +2,7 @@
 
 #include "cppgc/internal/logging.h"
 #include "runtime/console.h"
+#include "runtime/object.h"
 #include "runtime/process.h"
 
 namespace compilets {
@@ -9,6 +10,7 @@ namespace compilets {
 namespace nodejs {
 
 Console* console = nullptr;
+Performance* performance = nullptr;
 Process* process = nullptr;
 
 }  // namespace nodejs
@@ -16,6 +18,7 @@ Process* process = nullptr;
 namespace {
 
 State* g_state = nullptr;
+size_t g_function_slots_count = 0;
 
 }  // namespace
 
@@ -24,6 +27,11 @@ State* State::Get() {
   return g_state;
 }
 
+// static
+size_t State::NewFunctionSlot() {
+  return g_function_slots_count++;
+}
+
 State::State() {
   CPPGC_CHECK(!g_state);
   g_state = this;
@@ -31,15 +39,24 @@ State::State() {
 
 State::~State() {
   nodejs::console = nullptr;
+  nodejs::performance = nullptr;
   nodejs::process = nullptr;
 }
 
 void State::InitializeObjects() {
   console_ = MakeObject<nodejs::Console>();
+  performance_ = MakeObject<nodejs::Performance>();
   process_ = MakeObject<nodejs::Process>();
   // Set nodejs globals.
   nodejs::console = console_.Get();
+  nodejs::performance = performance_.Get();
   nodejs::process = process_.Get();
 }
 
+cppgc::Persistent<Object>& State::GetFunctionSlot(size_t slot) {
+  if (slot >= function_slots_.size())
+    function_slots_.resize(g_function_slots_count);
+  return function_slots_[slot];
+}
+
 }  // namespace compilets
@@ -1,21 +1,38 @@
 #ifndef CPP_RUNTIME_STATE_H_
 #define CPP_RUNTIME_STATE_H_
 
+#include <coroutine>
+#include <vector>
+
 #include "cppgc/persistent.h"
 
 namespace compilets {
 
 namespace nodejs {
 class Console;
+class Performance;
 class Process;
 }
 
+class EventLoop;
+class Object;
+
 class State {
  public:
   static State* Get();
 
   virtual void PreciseGC() = 0;
   virtual cppgc::AllocationHandle& GetAllocationHandle() = 0;
+  virtual cppgc::HeapHandle& GetHeapHandle() = 0;
+  // Return the loop running timers and I/O watchers, which is only available
+  // in executables.
+  virtual EventLoop* GetEventLoop() = 0;
+  // Queue the coroutine awaiting a promise to be resumed as a microtask.
+  virtual void PostMicrotask(std::coroutine_handle<> handle) = 0;
+
+  // Reserve a slot for caching the function object of a top-level function.
+  static size_t NewFunctionSlot();
+  cppgc::Persistent<Object>& GetFunctionSlot(size_t slot);
 
  protected:
   State();
@@ -25,7 +42,9 @@ class State {
 
  private:
   cppgc::Persistent<nodejs::Console> console_;
+  cppgc::Persistent<nodejs::Performance> performance_;
   cppgc::Persistent<nodejs::Process> process_;
+  std::vector<cppgc::Persistent<Object>> function_slots_;
 };
 
 }  // namespace compilets
@@ -1,7 +1,11 @@
 #include "runtime/string.h"
 
+#include <string.h>
+
+#include <bit>
 #include <compare>
 #include <iostream>
+#include <unordered_map>
 
 #include "cppgc/internal/logging.h"
 #include "fastfloat/fast_float.h"
@@ -20,22 +24,170 @@ std::string UTF16ToUTF8(const char16_t* str, size_t length) {
   return utf8;
 }
 
+// Slow path of decoding UTF-8 with invalid bytes, each of which becomes a
+// replacement character.
+size_t DecodeUTF8WithReplacement(std::string_view utf8, char16_t* out) {
+  const auto* p = reinterpret_cast<const uint8_t*>(utf8.data());
+  const auto* end = p + utf8.size();
+  char16_t* start = out;
+  while (p < end) {
+    uint32_t c = *p;
+    size_t length = c < 0x80 ? 1 : c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : 2;
+    uint32_t min = length == 2 ? 0x80 : length == 3 ? 0x800 : 0x10000;
+    bool valid = c < 0x80 || (c >= 0xC2 && c <= 0xF4 &&
+                              static_cast<size_t>(end - p) >= length);
+    if (valid && length > 1) {
+      c &= 0x7F >> length;
+      for (size_t i = 1; i < length && valid; ++i) {
+        valid = (p[i] & 0xC0) == 0x80;
+        c = (c << 6) | (p[i] & 0x3F);
+      }
+      valid = valid && c >= min && c <= 0x10FFFF &&
+              !(c >= 0xD800 && c <= 0xDFFF);
+    }
+    if (!valid) {
+      *out++ = 0xFFFD;
+      p++;
+    } else if (c >= 0x10000) {
+      *out++ = static_cast<char16_t>(0xD800 + ((c - 0x10000) >> 10));
+      *out++ = static_cast<char16_t>(0xDC00 + ((c - 0x10000) & 0x3FF));
+      p += length;
+    } else {
+      *out++ = static_cast<char16_t>(c);
+      p += length;
+    }
+  }
+  return out - start;
+}
+
+uint64_t ReadWord(const char* p) {
+  uint64_t word;
+  memcpy(&word, p, sizeof(word));
+  return word;
+}
+
+uint64_t MixWord(uint64_t hash, uint64_t word) {
+  hash ^= word;
+  hash *= 0xbf58476d1ce4e5b9;
+  return hash ^ (hash >> 31);
+}
+
 }  // namespace
 
+uint64_t HashString(std::u16string_view str) {
+  const char* p = reinterpret_cast<const char*>(str.data());
+  size_t size = str.size() * sizeof(char16_t);
+  uint64_t a = 0x9e3779b97f4a7c15 ^ size;
+  uint64_t b = 0x94d049bb133111eb;
+  // Hash 16 bytes per iteration in two independent lanes, so the multiplies
+  // of both lanes run in parallel.
+  for (; size >= 16; p += 16, size -= 16) {
+    a = MixWord(a, ReadWord(p));
+    b = MixWord(b, ReadWord(p + 8));
+  }
+  if (size >= 8) {
+    a = MixWord(a, ReadWord(p));
+    p += 8;
+    size -= 8;
+  }
+  uint64_t tail = 0;
+  memcpy(&tail, p, size);
+  uint64_t hash = MixWord(a ^ std::rotl(b, 32), tail);
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccd;
+  hash ^= hash >> 33;
+  return hash;
+}
+
 String::String()
-    : value_(std::make_shared<std::u16string>()) {}
+    : value_(std::make_shared<Storage>(std::u16string())) {}
 
 String::String(std::u16string str)
-    : value_(std::make_shared<std::u16string>(std::move(str))) {
-  this->length = value_->length();
+    : value_(std::make_shared<Storage>(std::move(str))) {
+  this->length = value_->str.length();
+}
+
+String::String(std::shared_ptr<Storage> value)
+    : length(value->str.length()), value_(std::move(value)) {}
+
+void String::Storage::Decode() {
+  str.resize(utf8.size());
+  size_t written = simdutf::convert_utf8_to_utf16(utf8.data(), utf8.size(),
+                                                  str.data());
+  str.resize(written);
+  // The bytes are not needed anymore.
+  std::string().swap(utf8);
+  decoded = true;
+}
+
+String String::Intern() const {
+  if (value_->interned)
+    return *this;
+  // The keys point to the strings owned by the values.
+  static std::unordered_map<std::u16string_view,
+                            std::shared_ptr<Storage>> table;
+  auto it = table.find(value());
+  if (it != table.end())
+    return String(it->second);
+  auto storage = std::make_shared<Storage>(value());
+  storage->interned = true;
+  table.emplace(storage->str, storage);
+  return String(std::move(storage));
 }
 
 String String::operator[](size_t index) const {
   return String(std::u16string{value()[index]});
 }
 
+String String::Iterator::operator*() const {
+  return String(str_->substr(index_, CodePointLength()));
+}
+
+String::Iterator& String::Iterator::operator++() {
+  index_ += CodePointLength();
+  return *this;
+}
+
+size_t String::Iterator::CodePointLength() const {
+  if (index_ + 1 < str_->size() &&
+      ((*str_)[index_] & 0xFC00) == 0xD800 &&
+      ((*str_)[index_ + 1] & 0xFC00) == 0xDC00) {
+    return 2;
+  }
+  return 1;
+}
+
+// static
+String String::FromUTF8(std::string_view utf8) {
+  // A UTF-8 byte never decodes to more than one UTF-16 unit, so the result is
+  // written in one pass without computing the length first.
+  std::u16string result(utf8.size(), u'\0');
+  size_t written = simdutf::convert_utf8_to_utf16(utf8.data(), utf8.size(),
+                                                  result.data());
+  if (written == 0 && !utf8.empty())
+    written = DecodeUTF8WithReplacement(utf8, result.data());
+  result.resize(written);
+  // Text that is mostly not ASCII would keep too much unused memory.
+  if (written < utf8.size() / 2)
+    result.shrink_to_fit();
+  return String(std::move(result));
+}
+
+// static
+String String::FromUTF8Lazily(std::string utf8) {
+  // Invalid bytes must be replaced, which changes the length.
+  if (!simdutf::validate_utf8(utf8.data(), utf8.size()))
+    return FromUTF8(utf8);
+  double length = simdutf::utf16_length_from_utf8(utf8.data(), utf8.size());
+  String result(std::make_shared<Storage>(std::move(utf8)));
+  result.length = length;
+  return result;
+}
+
 std::string String::ToUTF8() const {
-  return UTF16ToUTF8(value_->c_str(), value_->length());
+  if (!value_->decoded)
+    return value_->utf8;
+  return UTF16ToUTF8(value_->str.c_str(), value_->str.length());
 }
 
 String::ToNumberResult String::ToNumber() const {
@@ -1,15 +1,22 @@
 #ifndef CPP_RUNTIME_STRING_H_
 #define CPP_RUNTIME_STRING_H_
 
+#include <stdint.h>
+
+#include <algorithm>
 #include <compare>
 #include <iosfwd>
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include "runtime/type_traits.h"
 
 namespace compilets {
 
+// Compute the hash of characters, which is what String::hash() returns.
+uint64_t HashString(std::u16string_view str);
+
 // Immutable string.
 class String {
  public:
@@ -27,8 +34,37 @@ class String {
   // Accessing a char at index returns a new string.
   String operator[](size_t index) const;
 
-  // Comparing with another string.
+  // Iterates the code points, which is what the for...of loop visits, so a
+  // surrogate pair is read as one string.
+  class Iterator {
+   public:
+    Iterator(const std::u16string* str, size_t index)
+        : str_(str), index_(index) {}
+
+    String operator*() const;
+    Iterator& operator++();
+    bool operator==(const Iterator& other) const = default;
+
+   private:
+    size_t CodePointLength() const;
+
+    const std::u16string* str_;
+    size_t index_;
+  };
+
+  Iterator begin() const { return Iterator(&value(), 0); }
+  Iterator end() const { return Iterator(&value(), value().size()); }
+
+  // Comparing with another string, copies of the same string share storage,
+  // and strings with different hashes can not be equal.
   bool operator==(const String& other) const {
+    if (value_ == other.value_)
+      return true;
+    if (value_->interned && other.value_->interned)
+      return false;
+    if (value_->has_hash && other.value_->has_hash &&
+        value_->hash != other.value_->hash)
+      return false;
     return value() == other.value();
   }
 
@@ -47,16 +83,83 @@ class String {
     return value() <=> other;
   }
 
+  // Return the hash, which is computed once and then stored with the string.
+  uint64_t hash() const {
+    if (!value_->has_hash) {
+      value_->hash = HashString(value());
+      value_->has_hash = true;
+    }
+    return value_->hash;
+  }
+
+  // Return the copy of this string kept in the intern table, all interned
+  // copies of equal strings share storage and are compared by pointer.
+  // Interned strings are never freed, so only strings from a bounded set, like
+  // literals and property names, should be interned.
+  String Intern() const;
+  bool IsInterned() const { return value_->interned; }
+
+  // Decode UTF-8, invalid bytes are replaced with U+FFFD like Node.js does.
+  static String FromUTF8(std::string_view utf8);
+  // Keep valid UTF-8 as it is until the characters are read, so a string that
+  // is only measured or written back as UTF-8 is never decoded.
+  static String FromUTF8Lazily(std::string utf8);
+
   // Internal helpers.
   std::string ToUTF8() const;
   struct ToNumberResult { bool success; double result; };
   ToNumberResult ToNumber() const;
-  const std::u16string& value() const { return *value_.get(); }
+  const std::u16string& value() const {
+    if (!value_->decoded) [[unlikely]]
+      value_->Decode();
+    return value_->str;
+  }
+  // Return the UTF-8 bytes of a lazily decoded string, or nullptr when the
+  // string has been decoded.
+  const std::string* undecoded_utf8() const {
+    return value_->decoded ? nullptr : &value_->utf8;
+  }
 
  private:
-  std::shared_ptr<std::u16string> value_;
+  struct Storage {
+    explicit Storage(std::u16string str) : str(std::move(str)) {}
+    explicit Storage(std::string utf8)
+        : utf8(std::move(utf8)), decoded(false) {}
+
+    void Decode();
+
+    std::u16string str;
+    // The valid UTF-8 which str is decoded from on first read.
+    std::string utf8;
+    uint64_t hash = 0;
+    bool has_hash = false;
+    bool interned = false;
+    bool decoded = true;
+  };
+
+  explicit String(std::shared_ptr<Storage> value);
+
+  std::shared_ptr<Storage> value_;
 };
 
+// Holds a string literal as template argument.
+template<size_t N>
+struct StringLiteral {
+  constexpr StringLiteral(const char16_t (&str)[N]) {
+    std::copy_n(str, N, value);
+  }
+
+  char16_t value[N];
+};
+
+// Return the interned copy of a string literal, which is created once, used
+// for the property names of records.
+template<StringLiteral literal>
+inline const String& InternedString() {
+  static const String str = String(literal.value).Intern();
+  return str;
+}
+
 // Helper for concatenating multiple strings.
 class StringBuilder {
  public:
@@ -0,0 +1,65 @@
+#include "runtime/allocation_scope.h"
+#include "runtime/array.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace compilets {
+
+namespace {
+
+class Counted : public Object {
+ public:
+  explicit Counted(int* destroyed) : destroyed_(destroyed) {}
+  ~Counted() { (*destroyed_)++; }
+
+ private:
+  int* destroyed_;
+};
+
+}  // namespace
+
+class AllocationScopeTest : public testing::Test {
+};
+
+TEST_F(AllocationScopeTest, FreeOnExit) {
+  int destroyed = 0;
+  {
+    AllocationScope scope;
+    scope.Track(MakeObject<Counted>(&destroyed));
+    scope.Track(MakeObject<Counted>(&destroyed));
+    EXPECT_EQ(destroyed, 0);
+  }
+  EXPECT_EQ(destroyed, 2);
+}
+
+TEST_F(AllocationScopeTest, SurviveGC) {
+  int destroyed = 0;
+  {
+    AllocationScope scope;
+    scope.Track(MakeObject<Counted>(&destroyed));
+    State::Get()->PreciseGC();
+    EXPECT_EQ(destroyed, 0);
+  }
+  EXPECT_EQ(destroyed, 1);
+}
+
+TEST_F(AllocationScopeTest, Nested) {
+  int destroyed = 0;
+  {
+    AllocationScope outer;
+    outer.Track(MakeObject<Counted>(&destroyed));
+    {
+      AllocationScope inner;
+      inner.Track(MakeObject<Counted>(&destroyed));
+    }
+    EXPECT_EQ(destroyed, 1);
+  }
+  EXPECT_EQ(destroyed, 2);
+}
+
+TEST_F(AllocationScopeTest, TrackReturnsObject) {
+  AllocationScope scope;
+  Array<double>* arr = scope.Track(MakeArray<double>({1, 2, 3}));
+  EXPECT_EQ(arr->length, 3);
+}
+
+}  // namespace compilets
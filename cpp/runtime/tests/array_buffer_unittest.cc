@@ -0,0 +1,100 @@
+#include <cmath>
+#include <stdexcept>
+
+#include "runtime/buffer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace compilets {
+
+class ArrayBufferTest : public testing::Test {
+};
+
+TEST_F(ArrayBufferTest, Constructor) {
+  ArrayBuffer* buffer = MakeObject<ArrayBuffer>(8);
+  EXPECT_EQ(buffer->byteLength, 8);
+  Uint8Array* zero = MakeObject<Uint8Array>(0);
+  EXPECT_EQ(zero->length, 0);
+  Uint8Array* whole = MakeObject<Uint8Array>(buffer);
+  EXPECT_EQ(whole->length, 8);
+  Uint8Array* part = MakeObject<Uint8Array>(buffer, 2, 4);
+  EXPECT_EQ(part->byteOffset, 2);
+  EXPECT_EQ(part->length, 4);
+  EXPECT_THROW(MakeObject<Uint8Array>(buffer, 6, 4), std::range_error);
+  EXPECT_THROW(MakeObject<ArrayBuffer>(-1), std::range_error);
+}
+
+TEST_F(ArrayBufferTest, SharedMemory) {
+  ArrayBuffer* buffer = MakeObject<ArrayBuffer>(4);
+  Uint8Array* whole = MakeObject<Uint8Array>(buffer);
+  Uint8Array* tail = whole->subarray(-2);
+  EXPECT_EQ(tail->byteOffset, 2);
+  tail->value()[0] = 255;
+  tail->fill(257);
+  EXPECT_EQ(ToString(whole), u"0,0,1,1");
+  whole->value()[2] = 9;
+  EXPECT_EQ(tail->value()[0], 9);
+  // Slicing copies.
+  ArrayBuffer* copy = buffer->slice(1, 3);
+  EXPECT_EQ(copy->byteLength, 2);
+  copy->data()[0] = 8;
+  EXPECT_EQ(whole->value()[1], 0);
+}
+
+TEST_F(ArrayBufferTest, ElementAccess) {
+  ArrayBuffer* buffer = MakeObject<ArrayBuffer>(4);
+  Uint8Array* whole = MakeObject<Uint8Array>(buffer);
+  Uint8Array* part = MakeObject<Uint8Array>(buffer, 1, 2);
+  part->value()[0] = 257.9;
+  part->value()[1] = -1;
+  EXPECT_EQ(ToString(whole), u"0,1,255,0");
+  part->value()[0] = NAN;
+  part->value()[1] += 2;
+  EXPECT_EQ(ToString(whole), u"0,0,1,0");
+  // Writing out of range is ignored.
+  part->value()[2] = 9;
+  part->value()[-1] = 9;
+  part->value()[0.5] = 9;
+  EXPECT_EQ(ToString(whole), u"0,0,1,0");
+  // Reading out of range returns NaN.
+  EXPECT_EQ(part->value().get(1), 1);
+  EXPECT_TRUE(std::isnan(part->value().get(2)));
+  EXPECT_TRUE(std::isnan(part->value().get(-1)));
+  EXPECT_TRUE(std::isnan(part->value().get(NAN)));
+  EXPECT_EQ(part->value()[1]++, 1);
+  EXPECT_EQ(part->value().get(1), 2);
+}
+
+TEST_F(ArrayBufferTest, WrapMemory) {
+  static uint8_t memory[] = {1, 2, 3};
+  auto store = internal::BackingStore::Wrap(memory, sizeof(memory),
+                                            nullptr, nullptr);
+  Uint8Array* array = MakeObject<Uint8Array>(MakeObject<ArrayBuffer>(store));
+  EXPECT_EQ(ToString(array), u"1,2,3");
+  array->value()[0] = 4;
+  EXPECT_EQ(memory[0], 4);
+  // The deleter runs when the last reference is gone.
+  bool deleted = false;
+  store = internal::BackingStore::Wrap(
+      memory, sizeof(memory),
+      [](uint8_t* data, size_t length, void* hint) {
+        *static_cast<bool*>(hint) = true;
+      },
+      &deleted);
+  EXPECT_FALSE(deleted);
+  store.reset();
+  EXPECT_TRUE(deleted);
+}
+
+TEST_F(ArrayBufferTest, Buffer) {
+  nodejs::Buffer* buffer = nodejs::Buffer::alloc(5);
+  const char text[] = "hello";
+  std::copy(text, text + 5, buffer->data());
+  nodejs::Buffer* sub = buffer->subarray(1, -1);
+  EXPECT_EQ(sub->toString().value(), u"ell");
+  EXPECT_EQ(ToString(sub), u"ell");
+  Uint8Array* array = sub;
+  EXPECT_EQ(array->buffer, buffer->buffer);
+  EXPECT_THROW(nodejs::Buffer::alloc(-1), std::range_error);
+}
+
+}  // namespace compilets
@@ -0,0 +1,99 @@
+#include <stdio.h>
+
+#include <string>
+
+#if !defined(_WIN32)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <exception>
+
+#include "runtime/array.h"
+#include "runtime/console.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace compilets {
+
+class ConsoleTest : public testing::Test {
+};
+
+#if !defined(_WIN32)
+
+namespace {
+
+// Read what has been written to the file so far.
+std::string ReadAll(FILE* file) {
+  std::string result(lseek(fileno(file), 0, SEEK_END), '\0');
+  pread(fileno(file), result.data(), result.size(), 0);
+  return result;
+}
+
+}  // namespace
+
+TEST_F(ConsoleTest, FormatValues) {
+  FILE* file = tmpfile();
+  {
+    internal::OutputStream stream(fileno(file), false);
+    stream.WriteValue(String(u"café"));
+    stream.Write(std::string_view(" "));
+    stream.WriteValue(u"中");
+    stream.Write(std::string_view(" "));
+    stream.WriteValue(1.5);
+    stream.Write(std::string_view(" "));
+    stream.WriteValue(3);
+    stream.Write(std::string_view(" "));
+    stream.WriteValue(MakeArray<double>({1, 2}));
+    stream.EndLine();
+  }
+  EXPECT_EQ(ReadAll(file), "café 中 1.5 3 1,2\n");
+  fclose(file);
+}
+
+TEST_F(ConsoleTest, Buffered) {
+  FILE* file = tmpfile();
+  internal::OutputStream stream(fileno(file), false);
+  stream.Write(std::u16string_view(u"line"));
+  stream.EndLine();
+  EXPECT_EQ(ReadAll(file), "");
+  stream.Flush();
+  EXPECT_EQ(ReadAll(file), "line\n");
+  // Full buffer is written without waiting for flush.
+  std::string text(100 * 1024, 'a');
+  stream.Write(std::string_view(text));
+  stream.Write(std::string_view("b"));
+  EXPECT_EQ(ReadAll(file), "line\n" + text);
+  fclose(file);
+}
+
+TEST_F(ConsoleTest, LineBuffered) {
+  FILE* file = tmpfile();
+  internal::OutputStream stream(fileno(file), true);
+  stream.Write(std::u16string_view(u"line"));
+  EXPECT_EQ(ReadAll(file), "");
+  stream.EndLine();
+  EXPECT_EQ(ReadAll(file), "line\n");
+  fclose(file);
+}
+
+TEST_F(ConsoleTest, FlushOnTerminate) {
+  FILE* file = tmpfile();
+  internal::OutputStream::Stdout().Flush();
+  pid_t pid = fork();
+  if (pid == 0) {
+    dup2(fileno(file), 1);
+    internal::OutputStream& stream = internal::OutputStream::Stdout();
+    stream.set_line_buffered(false);
+    stream.Write(std::string_view("unflushed"));
+    std::terminate();
+  }
+  int status = 0;
+  ASSERT_EQ(waitpid(pid, &status, 0), pid);
+  EXPECT_TRUE(WIFSIGNALED(status));
+  EXPECT_EQ(ReadAll(file), "unflushed");
+  fclose(file);
+}
+
+#endif  // !defined(_WIN32)
+
+}  // namespace compilets
@@ -0,0 +1,64 @@
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+
+#include "runtime/event_loop.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace compilets {
+
+class EventLoopTest : public testing::Test {
+};
+
+TEST_F(EventLoopTest, TimersOrder) {
+  EventLoop loop;
+  std::vector<int> calls;
+  loop.AddTimer(20, [&]() { calls.push_back(3); });
+  loop.AddTimer(1, [&]() { calls.push_back(1); });
+  loop.AddTimer(1, [&]() {
+    calls.push_back(2);
+    loop.AddTimer(0, [&]() { calls.push_back(4); });
+  });
+  loop.Run();
+  EXPECT_EQ(calls, std::vector<int>({1, 2, 4, 3}));
+}
+
+TEST_F(EventLoopTest, RemoveTimer) {
+  EventLoop loop;
+  int count = 0;
+  uint64_t removed = loop.AddTimer(1, [&]() { count += 100; });
+  uint64_t interval = 0;
+  interval = loop.AddTimer(1, [&]() {
+    if (++count == 3)
+      loop.RemoveTimer(interval);
+  }, true);
+  loop.RemoveTimer(removed);
+  loop.Run();
+  EXPECT_EQ(count, 3);
+}
+
+#if defined(__linux__)
+TEST_F(EventLoopTest, Watch) {
+  EventLoop loop;
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  char received = 0;
+  EXPECT_TRUE(loop.Watch(fds[0], EPOLLIN, [&](uint32_t events) {
+    EXPECT_TRUE(events & EPOLLIN);
+    EXPECT_EQ(read(fds[0], &received, 1), 1);
+    loop.Unwatch(fds[0]);
+  }));
+  loop.AddTimer(1, [&]() {
+    EXPECT_EQ(write(fds[1], "x", 1), 1);
+  });
+  loop.Run();
+  EXPECT_EQ(received, 'x');
+  close(fds[0]);
+  close(fds[1]);
+}
+#endif
+
+}  // namespace compilets
@@ -0,0 +1,112 @@
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+#include "runtime/fs.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace compilets {
+
+namespace fs = nodejs::fs;
+
+class FsTest : public testing::Test {
+};
+
+namespace {
+
+// Temporary directory removed after each test.
+class ScopedTempDir {
+ public:
+  ScopedTempDir()
+      : dir_(std::filesystem::temp_directory_path() / "compilets_fs_test") {
+    std::filesystem::create_directories(dir_);
+  }
+
+  ~ScopedTempDir() {
+    std::filesystem::remove_all(dir_);
+  }
+
+  String Path(const char16_t* name) const {
+    return String::FromUTF8(dir_.string()).value() + u"/" + name;
+  }
+
+ private:
+  std::filesystem::path dir_;
+};
+
+}  // namespace
+
+TEST_F(FsTest, ReadWriteString) {
+  ScopedTempDir dir;
+  String path = dir.Path(u"a.txt");
+  EXPECT_FALSE(fs::existsSync(path));
+  fs::writeFileSync(path, u"café 中 😀");
+  EXPECT_TRUE(fs::existsSync(path));
+  EXPECT_EQ(fs::readFileSync(path, u"utf8").value(), u"café 中 😀");
+  nodejs::Buffer* buffer = fs::readFileSync(path);
+  EXPECT_EQ(buffer->length, 14);
+  EXPECT_EQ(buffer->toString().value(), u"café 中 😀");
+  EXPECT_THROW(fs::readFileSync(path, u"latin1"), std::invalid_argument);
+  EXPECT_THROW(fs::readFileSync(dir.Path(u"none")), std::system_error);
+}
+
+TEST_F(FsTest, ReadLargeFile) {
+  ScopedTempDir dir;
+  String path = dir.Path(u"large.txt");
+  std::u16string text(fs::kMapFileThreshold + 3, u'a');
+  text.back() = u'z';
+  fs::writeFileSync(path, String(text));
+  nodejs::Buffer* buffer = fs::readFileSync(path);
+  EXPECT_EQ(buffer->size(), text.size());
+  EXPECT_EQ(buffer->data()[text.size() - 1], 'z');
+  EXPECT_EQ(fs::readFileSync(path, u"utf-8").value(), text);
+  // Mapped buffer can be written without changing the file.
+  buffer->data()[0] = 'b';
+  EXPECT_EQ(fs::readFileSync(path)->data()[0], 'a');
+}
+
+TEST_F(FsTest, InvalidUTF8) {
+  ScopedTempDir dir;
+  String path = dir.Path(u"invalid.txt");
+  nodejs::Buffer* buffer = nodejs::Buffer::alloc(4);
+  buffer->data()[0] = 'a';
+  buffer->data()[1] = 0xFF;
+  buffer->data()[2] = 0xC3;
+  buffer->data()[3] = 'b';
+  fs::writeFileSync(path, buffer);
+  EXPECT_EQ(fs::readFileSync(path, u"utf8").value(), u"a��b");
+}
+
+TEST_F(FsTest, ReaddirSync) {
+  ScopedTempDir dir;
+  fs::writeFileSync(dir.Path(u"b"), u"");
+  fs::writeFileSync(dir.Path(u"a"), u"");
+  fs::writeFileSync(dir.Path(u"c"), u"");
+  Array<String>* names = fs::readdirSync(dir.Path(u""));
+  ASSERT_EQ(names->length, 3);
+  EXPECT_EQ(names->value()[0].value(), u"a");
+  EXPECT_EQ(names->value()[1].value(), u"b");
+  EXPECT_EQ(names->value()[2].value(), u"c");
+  EXPECT_THROW(fs::readdirSync(dir.Path(u"none")), std::system_error);
+}
+
+TEST_F(FsTest, ReadInChunks) {
+  ScopedTempDir dir;
+  String path = dir.Path(u"chunks.txt");
+  fs::writeFileSync(path, u"0123456789");
+  double fd = fs::openSync(path);
+  nodejs::Buffer* buffer = nodejs::Buffer::alloc(4);
+  std::string result;
+  while (double n = fs::readSync(fd, buffer))
+    result.append(buffer->view().substr(0, n));
+  fs::closeSync(fd);
+  EXPECT_EQ(result, "0123456789");
+  fd = fs::openSync(path, u"r");
+  EXPECT_EQ(fs::readSync(fd, buffer, 1, 2, 8), 2);
+  EXPECT_EQ(buffer->view().substr(1, 2), "89");
+  EXPECT_THROW(fs::readSync(fd, buffer, 3, 2), std::range_error);
+  fs::closeSync(fd);
+  EXPECT_THROW(nodejs::Buffer::alloc(-1), std::range_error);
+}
+
+}  // namespace compilets
@@ -0,0 +1,70 @@
+#include <vector>
+
+#include "runtime/generator.h"
+#include "runtime/string.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace compilets {
+
+namespace {
+
+Generator<double>* Range(double n) {
+  for (double i = 0; i < n; ++i)
+    co_yield i;
+}
+
+Generator<double>* Squares(double n) {
+  for (double i : *Range(n))
+    co_yield i * i;
+}
+
+Generator<String>* Words() {
+  co_yield u"a";
+  co_return;
+  co_yield u"b";
+}
+
+}  // namespace
+
+class GeneratorTest : public testing::Test {
+};
+
+TEST_F(GeneratorTest, ForOf) {
+  std::vector<double> values;
+  for (double i : *Range(3))
+    values.push_back(i);
+  EXPECT_EQ(values, std::vector<double>({0, 1, 2}));
+  for (double i : *Range(0))
+    values.push_back(i);
+  EXPECT_EQ(values.size(), 3);
+}
+
+TEST_F(GeneratorTest, Chained) {
+  std::vector<double> values;
+  for (double i : *Squares(4))
+    values.push_back(i);
+  EXPECT_EQ(values, std::vector<double>({0, 1, 4, 9}));
+}
+
+TEST_F(GeneratorTest, Return) {
+  Generator<String>* words = Words();
+  EXPECT_FALSE(words->done());
+  std::vector<String> values;
+  for (const String& word : *words)
+    values.push_back(word);
+  EXPECT_EQ(values, std::vector<String>({u"a"}));
+  EXPECT_TRUE(words->done());
+  // A finished generator yields nothing.
+  for (const String& word : *words)
+    values.push_back(word);
+  EXPECT_EQ(values.size(), 1);
+}
+
+TEST_F(GeneratorTest, FramePool) {
+  void* frame = internal::AllocateFrame(100);
+  internal::FreeFrame(frame, 100);
+  EXPECT_EQ(internal::AllocateFrame(120), frame);
+  internal::FreeFrame(frame, 120);
+}
+
+}  // namespace compilets
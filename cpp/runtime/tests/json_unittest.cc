@@ -0,0 +1,138 @@
+#include <stdexcept>
+
+#include "runtime/json.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace compilets {
+
+class JSONTest : public testing::Test {
+};
+
+namespace {
+
+// The structs are written like the generated interfaces.
+struct Point final : public Struct {
+  Point() = default;
+  Point(double x, double y) : x(x), y(y) {}
+
+  double x;
+  double y;
+
+  static void VisitProperties(auto& self, auto&& visit) {
+    visit("x", self.x);
+    visit("y", self.y);
+  }
+};
+
+struct Shape final : public Object {
+  Shape() = default;
+
+  String name;
+  bool closed;
+  Optional<double> area;
+  cppgc::Member<Array<Point>> points;
+  cppgc::Member<Shape> parent;
+
+  void Trace(cppgc::Visitor* visitor) const override {
+    TraceMember(visitor, points);
+    TraceMember(visitor, parent);
+  }
+
+  ~Shape() = default;
+
+  static void VisitProperties(auto& self, auto&& visit) {
+    visit("name", self.name);
+    visit("closed", self.closed);
+    visit("area", self.area);
+    visit("points", self.points);
+    visit("parent", self.parent);
+  }
+};
+
+}  // namespace
+
+TEST_F(JSONTest, ParsePrimitives) {
+  EXPECT_EQ(JSON::parse<double>(u" 12.5e1 "), 125);
+  EXPECT_EQ(JSON::parse<double>(u"-0.25"), -0.25);
+  EXPECT_EQ(JSON::parse<bool>(u"true"), true);
+  EXPECT_EQ(JSON::parse<String>(u"\"caf\u00e9\""), u"caf\u00e9");
+  EXPECT_EQ(JSON::parse<String>(u"\"a\\n\\\"\\u00e9\\ud83d\\ude00\""),
+            u"a\n\"\u00e9\U0001F600");
+  EXPECT_EQ(JSON::parse<Optional<double>>(u"null"), std::nullopt);
+  EXPECT_EQ(JSON::parse<Optional<String>>(u"\"s\""), String(u"s"));
+  for (const char16_t* invalid : {u"", u"01", u"1.", u"-", u"+1", u"1 2",
+                                  u"\"a", u"\"\\x\"", u"\"\t\"", u"nul"}) {
+    EXPECT_THROW(JSON::parse<Optional<double>>(String(invalid)),
+                 std::invalid_argument);
+  }
+}
+
+TEST_F(JSONTest, ParseObjects) {
+  Shape* shape = JSON::parse<Shape>(
+      uR"({"name": "tri", "closed": true, "unknown": [{"x": [null]}, "}"],
+           "points": [{"x": 1, "y": 2}, {"y": 4, "x": 3}, {}],
+           "parent": {"name": "\u0070", "parent": null}})");
+  EXPECT_EQ(shape->name, u"tri");
+  EXPECT_TRUE(shape->closed);
+  EXPECT_FALSE(shape->area);
+  ASSERT_EQ(shape->points->length, 3);
+  EXPECT_EQ(shape->points->value()[1].x, 3);
+  EXPECT_EQ(shape->points->value()[1].y, 4);
+  EXPECT_EQ(shape->points->value()[2].x, 0);
+  EXPECT_EQ(shape->parent->name, u"p");
+  EXPECT_EQ(shape->parent->parent, nullptr);
+  EXPECT_EQ(shape->parent->points, nullptr);
+  auto* numbers = JSON::parse<Array<double>>(u"[1, 2 ,3]");
+  EXPECT_EQ(numbers->value(), sane::vector<double>({1, 2, 3}));
+  EXPECT_EQ(numbers->length, 3);
+  EXPECT_EQ(JSON::parse<Array<bool>>(u"[]")->length, 0);
+  EXPECT_THROW(JSON::parse<Point>(u"{\"x\": 1,}"), std::invalid_argument);
+  EXPECT_THROW(JSON::parse<Point>(u"{\"x\": \"1\"}"), std::invalid_argument);
+}
+
+TEST_F(JSONTest, StringifyNumbers) {
+  EXPECT_EQ(JSON::stringify(0.0), u"0");
+  EXPECT_EQ(JSON::stringify(-0.0), u"0");
+  EXPECT_EQ(JSON::stringify(123.0), u"123");
+  EXPECT_EQ(JSON::stringify(-1.5), u"-1.5");
+  EXPECT_EQ(JSON::stringify(0.1 + 0.2), u"0.30000000000000004");
+  EXPECT_EQ(JSON::stringify(1e21), u"1e+21");
+  EXPECT_EQ(JSON::stringify(123e18), u"123000000000000000000");
+  EXPECT_EQ(JSON::stringify(0.000001), u"0.000001");
+  EXPECT_EQ(JSON::stringify(1.5e-7), u"1.5e-7");
+  EXPECT_EQ(JSON::stringify(std::nan("")), u"null");
+}
+
+TEST_F(JSONTest, StringifyStrings) {
+  EXPECT_EQ(JSON::stringify(String(u"a\"\\\n\x01\u00e9\U0001F600")),
+            u"\"a\\\"\\\\\\n\\u0001\u00e9\U0001F600\"");
+  EXPECT_EQ(JSON::stringify(String(std::u16string(1, u'\xD800'))),
+            u"\"\\ud800\"");
+  String lazy = String::FromUTF8Lazily("tab\there, caf\xC3\xA9 is long");
+  String json = JSON::stringify(lazy);
+  EXPECT_EQ(*json.undecoded_utf8(), "\"tab\\there, caf\xC3\xA9 is long\"");
+}
+
+TEST_F(JSONTest, StringifyObjects) {
+  Shape* shape = MakeObject<Shape>();
+  shape->name = u"line";
+  shape->points = MakeArray<Point>({Point(1, 2), Point(0.5, -3)});
+  EXPECT_EQ(JSON::stringify(shape),
+            uR"({"name":"line","closed":false,)"
+            uR"("points":[{"x":1,"y":2},{"x":0.5,"y":-3}],"parent":null})");
+  shape->area = 2;
+  shape->points = nullptr;
+  EXPECT_EQ(JSON::stringify(shape),
+            uR"({"name":"line","closed":false,"area":2,"points":null,)"
+            uR"("parent":null})");
+  auto* strings = MakeArray<Optional<String>>({u"a", std::nullopt});
+  EXPECT_EQ(JSON::stringify(strings), u"[\"a\",null]");
+  cppgc::Persistent<Shape> persistent(shape);
+  EXPECT_EQ(JSON::stringify(persistent), JSON::stringify(shape));
+  // Round trip.
+  Shape* copy = JSON::parse<Shape>(JSON::stringify(shape));
+  EXPECT_EQ(copy->area, 2);
+  EXPECT_EQ(JSON::stringify(copy), JSON::stringify(shape));
+}
+
+}  // namespace compilets
@@ -0,0 +1,190 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "cppgc/persistent.h"
+#include "runtime/map.h"
+#include "runtime/set.h"
+#include "runtime/string.h"
+#include "runtime/union.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace compilets {
+
+namespace {
+
+class Counted : public Object {
+ public:
+  explicit Counted(int* destroyed) : destroyed_(destroyed) {}
+  ~Counted() { (*destroyed_)++; }
+
+ private:
+  int* destroyed_;
+};
+
+template<typename T>
+std::vector<double> Keys(const T* table) {
+  std::vector<double> keys;
+  for (const auto& entry : *table)
+    keys.push_back(entry.key);
+  return keys;
+}
+
+}  // namespace
+
+class MapTest : public testing::Test {
+};
+
+TEST_F(MapTest, Map) {
+  Map<String, double>* map = MakeObject<Map<String, double>>();
+  EXPECT_EQ(map->size, 0);
+  EXPECT_FALSE(map->get(u"a").has_value());
+  EXPECT_EQ(map->set(u"a", 1)->set(u"b", 2), map);
+  EXPECT_EQ(map->size, 2);
+  EXPECT_EQ(map->get(u"a"), 1);
+  EXPECT_EQ(map->get(String(u"b")), 2);
+  EXPECT_TRUE(map->has(u"b"));
+  map->set(u"a", 3);
+  EXPECT_EQ(map->size, 2);
+  EXPECT_EQ(map->get(u"a"), 3);
+  EXPECT_TRUE(map->erase(u"a"));
+  EXPECT_FALSE(map->erase(u"a"));
+  EXPECT_FALSE(map->has(u"a"));
+  EXPECT_EQ(map->size, 1);
+  map->clear();
+  EXPECT_EQ(map->size, 0);
+  EXPECT_FALSE(map->has(u"b"));
+  map->set(u"c", 4);
+  EXPECT_EQ(map->get(u"c"), 4);
+}
+
+TEST_F(MapTest, Set) {
+  Set<double>* set = MakeObject<Set<double>>();
+  EXPECT_EQ(set->add(1)->add(2)->add(1), set);
+  EXPECT_EQ(set->size, 2);
+  EXPECT_TRUE(set->has(1));
+  EXPECT_FALSE(set->has(3));
+  EXPECT_TRUE(set->erase(1));
+  EXPECT_FALSE(set->has(1));
+  EXPECT_EQ(set->size, 1);
+}
+
+TEST_F(MapTest, SameValueZero) {
+  Set<double>* set = MakeObject<Set<double>>();
+  set->add(std::numeric_limits<double>::quiet_NaN());
+  set->add(-std::numeric_limits<double>::quiet_NaN());
+  set->add(0);
+  set->add(-0.0);
+  EXPECT_EQ(set->size, 2);
+  EXPECT_TRUE(set->has(std::nan("")));
+  EXPECT_TRUE(set->has(-0.0));
+  Set<Union<double, String>>* mixed = MakeObject<Set<Union<double, String>>>();
+  mixed->add(1.);
+  mixed->add(u"1");
+  mixed->add(1.);
+  EXPECT_EQ(mixed->size, 2);
+  EXPECT_TRUE(mixed->has(u"1"));
+}
+
+TEST_F(MapTest, InsertionOrder) {
+  Map<double, double>* map = MakeObject<Map<double, double>>();
+  for (int i = 0; i < 6; ++i)
+    map->set(i, i);
+  map->erase(0);
+  map->erase(3);
+  map->set(3, 3);
+  map->set(1, 10);
+  EXPECT_EQ(Keys(map), std::vector<double>({1, 2, 4, 5, 3}));
+  EXPECT_EQ(map->get(1), 10);
+}
+
+TEST_F(MapTest, ManyEntries) {
+  const int count = 100000;
+  Set<double>* set = MakeObject<Set<double>>();
+  for (int i = 0; i < count; ++i)
+    set->add(i);
+  for (int i = 0; i < count; i += 2)
+    set->erase(i);
+  EXPECT_EQ(set->size, count / 2);
+  for (int i = 0; i < count; ++i)
+    ASSERT_EQ(set->has(i), i % 2 == 1);
+  // Keep adding and deleting, which reuses tombstones and compacts holes.
+  for (int i = 0; i < count; ++i) {
+    set->add(count + i);
+    set->erase(count + i);
+  }
+  EXPECT_EQ(set->size, count / 2);
+  std::vector<double> keys = Keys(set);
+  ASSERT_EQ(keys.size(), count / 2);
+  for (size_t i = 0; i < keys.size(); ++i)
+    ASSERT_EQ(keys[i], i * 2 + 1);
+}
+
+TEST_F(MapTest, ModifyWhileIterating) {
+  Set<double>* set = MakeObject<Set<double>>();
+  set->add(1)->add(2)->add(3);
+  std::vector<double> visited;
+  for (const auto& entry : *set) {
+    double key = entry.key;
+    visited.push_back(key);
+    set->erase(2);
+    if (key < 10)
+      set->add(key + 10);
+  }
+  EXPECT_EQ(visited, std::vector<double>({1, 3, 11, 13}));
+}
+
+TEST_F(MapTest, RehashWhileIterating) {
+  Set<double>* set = MakeObject<Set<double>>();
+  for (int i = 0; i < 20; ++i)
+    set->add(i);
+  // Leave holes before the iterator.
+  for (int i = 0; i < 10; ++i)
+    set->erase(i);
+  std::vector<double> visited;
+  for (const auto& entry : *set) {
+    visited.push_back(entry.key);
+    // Adding many entries rebuilds the index during the loop.
+    if (entry.key == 10) {
+      for (int i = 100; i < 200; ++i)
+        set->add(i);
+    }
+  }
+  std::vector<double> expected;
+  for (int i = 10; i < 20; ++i)
+    expected.push_back(i);
+  for (int i = 100; i < 200; ++i)
+    expected.push_back(i);
+  EXPECT_EQ(visited, expected);
+  // The holes are compacted after iterating.
+  set->add(200);
+  EXPECT_EQ(Keys(set).size(), 111);
+  // Clearing keeps visiting the entries added later.
+  visited.clear();
+  for (const auto& entry : *set) {
+    visited.push_back(entry.key);
+    if (entry.key == 10) {
+      set->clear();
+      set->add(1);
+    }
+  }
+  EXPECT_EQ(visited, std::vector<double>({10, 1}));
+}
+
+TEST_F(MapTest, Trace) {
+  int destroyed = 0;
+  cppgc::Persistent<Map<double, Counted>> map = MakeObject<Map<double, Counted>>();
+  cppgc::Persistent<Set<Counted>> set = MakeObject<Set<Counted>>();
+  map->set(1, MakeObject<Counted>(&destroyed));
+  set->add(MakeObject<Counted>(&destroyed));
+  State::Get()->PreciseGC();
+  EXPECT_EQ(destroyed, 0);
+  EXPECT_NE(map->get(1), nullptr);
+  map->erase(1);
+  set->clear();
+  State::Get()->PreciseGC();
+  EXPECT_EQ(destroyed, 2);
+  EXPECT_EQ(map->get(1), nullptr);
+}
+
+}  // namespace compilets
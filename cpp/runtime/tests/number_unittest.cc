@@ -1,3 +1,4 @@
+#include "runtime/math.h"
 #include "runtime/number.h"
 #include "runtime/string.h"
 #include "runtime/union.h"
@@ -16,6 +17,14 @@ TEST_F(NumberTest, IsFinite) {
   EXPECT_TRUE(isFinite(10 / 5));
 }
 
+TEST_F(NumberTest, BigIntDivide) {
+  EXPECT_EQ(BigIntDivide(7, 2), 3);
+  EXPECT_EQ(BigIntDivide(-7, 2), -3);
+  EXPECT_THROW(BigIntDivide(1, 0), std::range_error);
+  EXPECT_THROW(BigIntDivide(std::numeric_limits<int64_t>::min(), -1),
+               std::range_error);
+}
+
 TEST_F(NumberTest, ParseFloat) {
   EXPECT_EQ(parseFloat(123), 123);
   EXPECT_EQ(parseFloat(1.23), 1.23);
@@ -0,0 +1,60 @@
+#include <cmath>
+#include <limits>
+
+#include "runtime/type_traits.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace compilets {
+
+static_assert(sizeof(Optional<double>) == sizeof(double));
+static_assert(std::is_same_v<Optional<double>, CompactOptional<double>>);
+static_assert(std::is_same_v<Optional<bool>, std::optional<bool>>);
+
+class OptionalTest : public testing::Test {
+};
+
+TEST_F(OptionalTest, CompactDouble) {
+  Optional<double> undefined;
+  EXPECT_FALSE(undefined.has_value());
+  EXPECT_TRUE(std::isnan(undefined.value()));
+  EXPECT_EQ(undefined.value_or(8964), 8964);
+  EXPECT_EQ(undefined, std::nullopt);
+  Optional<double> number = 0;
+  EXPECT_TRUE(number.has_value());
+  EXPECT_EQ(number, 0);
+  number = std::nullopt;
+  EXPECT_EQ(number, undefined);
+  number = -1.5;
+  EXPECT_EQ(*number, -1.5);
+  EXPECT_NE(number, undefined);
+}
+
+TEST_F(OptionalTest, CompactDoubleNaN) {
+  Optional<double> nan = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_TRUE(nan.has_value());
+  EXPECT_TRUE(std::isnan(nan.value()));
+  EXPECT_NE(nan, nan);
+  // The undefined state is a NaN, arithmetic on it gives a defined NaN.
+  Optional<double> undefined;
+  Optional<double> sum = undefined.value() + 1;
+  EXPECT_TRUE(sum.has_value());
+  EXPECT_TRUE(std::isnan(sum.value()));
+  // Reinterpreting the undefined bits still gives a defined NaN.
+  Optional<double> reinterpreted = undefined.value();
+  EXPECT_TRUE(reinterpreted.has_value());
+}
+
+TEST_F(OptionalTest, Helpers) {
+  Optional<double> number;
+  EXPECT_FALSE(IsTrue(number));
+  EXPECT_TRUE(StrictEqual(number, std::nullopt));
+  number = 0;
+  EXPECT_FALSE(IsTrue(number));
+  number = 123;
+  EXPECT_TRUE(IsTrue(number));
+  EXPECT_TRUE(StrictEqual(number, 123.0));
+  EXPECT_EQ(GetOptionalValue(number), 123);
+  EXPECT_EQ(ToString(number), u"123");
+}
+
+}  // namespace compilets
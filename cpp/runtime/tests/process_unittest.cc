@@ -0,0 +1,47 @@
+#include <chrono>
+#include <thread>
+
+#include "runtime/process.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace compilets {
+
+class ProcessTest : public testing::Test {
+};
+
+TEST_F(ProcessTest, MonotonicNow) {
+  int64_t start = internal::MonotonicNow();
+  EXPECT_GE(start, internal::GetTimeOrigin());
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  int64_t elapsed = internal::MonotonicNow() - start;
+  EXPECT_GE(elapsed, 2000000);
+  EXPECT_LT(elapsed, 1000000000);
+}
+
+TEST_F(ProcessTest, PerformanceNow) {
+  nodejs::Performance* performance = MakeObject<nodejs::Performance>();
+  double start = performance->now();
+  EXPECT_GE(start, 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  EXPECT_GE(performance->now() - start, 2);
+}
+
+TEST_F(ProcessTest, HRTime) {
+  nodejs::Process* process = MakeObject<nodejs::Process>();
+  int64_t start = process->hrtime->bigint();
+  EXPECT_GE(process->hrtime->bigint(), start);
+}
+
+TEST_F(ProcessTest, Argv) {
+  nodejs::Process* process = MakeObject<nodejs::Process>();
+  EXPECT_EQ(process->argv->length, 0);
+  const char* args[] = {"/bin/app", "-v", "caf\xC3\xA9"};
+  process->SetArgv(3, args);
+  ASSERT_EQ(process->argv->length, 4);
+  EXPECT_EQ(process->argv->value()[0], u"/bin/app");
+  EXPECT_EQ(process->argv->value()[1], u"/bin/app");
+  EXPECT_EQ(process->argv->value()[2], u"-v");
+  EXPECT_EQ(process->argv->value()[3], u"café");
+}
+
+}  // namespace compilets
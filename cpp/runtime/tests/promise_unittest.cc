@@ -0,0 +1,86 @@
+#include <vector>
+
+#include "runtime/promise.h"
+#include "runtime/string.h"
+#include "runtime/timers.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace compilets {
+
+namespace {
+
+Promise<double>* Double(double n) {
+  co_return n * 2;
+}
+
+Promise<void>* Sleep(double ms) {
+  using Resolve = Function<void()>;
+  return MakeObject<Promise<void>>(
+      MakeFunction<void(Resolve*)>([ms](Resolve* resolve) {
+        nodejs::setTimeout(resolve, ms);
+      }));
+}
+
+Promise<String>* Delayed(std::vector<String>* log, String name, double ms) {
+  co_await Sleep(ms);
+  log->push_back(name);
+  co_return name;
+}
+
+Promise<void>* Chain(std::vector<String>* log) {
+  log->push_back(u"start");
+  String a = co_await Delayed(log, u"a", 5);
+  String b = co_await Delayed(log, u"b", 1);
+  log->push_back(a);
+  log->push_back(b);
+}
+
+void RunEventLoop() {
+  State::Get()->GetEventLoop()->Run();
+}
+
+}  // namespace
+
+class PromiseTest : public testing::Test {
+};
+
+TEST_F(PromiseTest, ResolvedWithoutSuspending) {
+  Promise<double>* promise = Double(21);
+  EXPECT_TRUE(promise->settled());
+  Promise<double>::Awaiter awaiter(promise);
+  EXPECT_TRUE(awaiter.await_ready());
+  EXPECT_EQ(awaiter.await_resume(), 42);
+}
+
+TEST_F(PromiseTest, AwaitTimers) {
+  std::vector<String> log;
+  Promise<void>* promise = Chain(&log);
+  EXPECT_FALSE(promise->settled());
+  EXPECT_EQ(log, std::vector<String>({u"start"}));
+  RunEventLoop();
+  EXPECT_TRUE(promise->settled());
+  EXPECT_EQ(log, std::vector<String>({u"start", u"a", u"b", u"a", u"b"}));
+}
+
+TEST_F(PromiseTest, MicrotasksRunInOrder) {
+  std::vector<String> log;
+  Promise<void>* sleep = Sleep(1);
+  auto waiter = [&log, sleep](String name) -> Promise<void>* {
+    co_await sleep;
+    log.push_back(name);
+  };
+  waiter(u"1");
+  waiter(u"2");
+  RunEventLoop();
+  EXPECT_EQ(log, std::vector<String>({u"1", u"2"}));
+}
+
+TEST_F(PromiseTest, Resolve) {
+  Promise<String>* promise = PromiseConstructor::resolve<String>(u"value");
+  EXPECT_TRUE(promise->settled());
+  promise->Resolve(u"ignored");
+  EXPECT_EQ(Promise<String>::Awaiter(promise).await_resume(), u"value");
+  EXPECT_TRUE(PromiseConstructor::resolve<void>()->settled());
+}
+
+}  // namespace compilets
@@ -0,0 +1,61 @@
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "runtime/readline.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace compilets {
+
+class ReadlineTest : public testing::Test {
+};
+
+namespace {
+
+// Write the input to a temporary file and read all lines from it.
+std::vector<String> ReadLines(std::string_view input, size_t buffer_size) {
+  FILE* file = tmpfile();
+  fwrite(input.data(), 1, input.size(), file);
+  fflush(file);
+  rewind(file);
+  internal::LineReader reader(fileno(file), buffer_size);
+  std::vector<String> lines;
+  while (std::optional<String> line = reader.ReadLine())
+    lines.push_back(std::move(*line));
+  fclose(file);
+  return lines;
+}
+
+}  // namespace
+
+TEST_F(ReadlineTest, LineBreaks) {
+  for (size_t buffer_size : {1, 3, 1024}) {
+    EXPECT_EQ(ReadLines("a\nbc\r\n\nd\re\r\rf", buffer_size),
+              std::vector<String>({u"a", u"bc", u"", u"d", u"e", u"", u"f"}));
+    EXPECT_EQ(ReadLines("a\n\n", buffer_size),
+              std::vector<String>({u"a", u""}));
+    EXPECT_EQ(ReadLines("a\r", buffer_size), std::vector<String>({u"a"}));
+    EXPECT_TRUE(ReadLines("", buffer_size).empty());
+  }
+}
+
+TEST_F(ReadlineTest, LongLines) {
+  std::string input(internal::LineReader::kBufferSize * 3, 'x');
+  input += "\n\xE4\xB8\xAD\n";
+  std::vector<String> lines = ReadLines(input, 4096);
+  ASSERT_EQ(lines.size(), 2);
+  EXPECT_EQ(lines[0].length, internal::LineReader::kBufferSize * 3);
+  EXPECT_EQ(lines[1], u"中");
+}
+
+TEST_F(ReadlineTest, LazyDecoding) {
+  std::vector<String> lines = ReadLines("caf\xC3\xA9\n\xFF\n", 16);
+  ASSERT_EQ(lines.size(), 2);
+  EXPECT_TRUE(lines[0].undecoded_utf8());
+  EXPECT_EQ(lines[0].length, 4);
+  EXPECT_EQ(lines[0], u"café");
+  EXPECT_EQ(lines[1], u"�");
+}
+
+}  // namespace compilets
@@ -0,0 +1,75 @@
+#include <cmath>
+
+#include "runtime/record.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace compilets {
+
+namespace {
+
+class Item : public Object {
+ public:
+  explicit Item(double value) : value(value) {}
+
+  double value;
+};
+
+}  // namespace
+
+class RecordTest : public testing::Test {
+};
+
+TEST_F(RecordTest, Properties) {
+  Record<double>* record = MakeRecord<double>({{u"a", 1}, {u"b", 2}});
+  EXPECT_EQ(record->get(u"a"), 1);
+  EXPECT_TRUE(std::isnan(record->get(u"c")));
+  EXPECT_FALSE(record->has(u"c"));
+  record->at(u"c") = 3;
+  record->at(String(u"a")) += 10;
+  EXPECT_EQ(record->get(String(u"a")), 11);
+  // Adding to a missing property adds to undefined.
+  record->at(u"missing") += 10;
+  EXPECT_TRUE(std::isnan(record->get(u"missing")));
+  EXPECT_TRUE(record->erase(u"missing"));
+  EXPECT_TRUE(record->has(u"c"));
+  EXPECT_TRUE(record->erase(u"b"));
+  EXPECT_TRUE(record->erase(u"b"));
+  EXPECT_EQ(record->size(), 2);
+}
+
+TEST_F(RecordTest, InternedKeys) {
+  Record<double>* record = MakeRecord<double>({{u"a", 1}});
+  record->at(u"b") = 2;
+  String key = std::u16string(u"cd");
+  record->at(key) = 3;
+  Array<String>* keys = ObjectConstructor::keys(record);
+  EXPECT_TRUE(keys->value()[0].IsInterned());
+  EXPECT_TRUE(keys->value()[1].IsInterned());
+  EXPECT_FALSE(keys->value()[2].IsInterned());
+  const String& name = InternedString<u"a">();
+  EXPECT_TRUE(name.IsInterned());
+  EXPECT_EQ(&name, &InternedString<u"a">());
+  EXPECT_EQ(record->get(name), 1);
+  EXPECT_EQ(record->get(InternedString<u"cd">()), 3);
+}
+
+TEST_F(RecordTest, KeysAndValues) {
+  Record<double>* record = MakeRecord<double>({{u"z", 1}, {u"y", 2}});
+  record->at(u"x") = 3;
+  record->erase(u"z");
+  record->at(u"z") = 4;
+  EXPECT_EQ(ObjectConstructor::keys(record)->value(),
+            std::vector<String>({u"y", u"x", u"z"}));
+  EXPECT_EQ(ObjectConstructor::values(record)->value(),
+            std::vector<double>({2, 3, 4}));
+}
+
+TEST_F(RecordTest, Objects) {
+  Record<Item>* record = MakeRecord<Item>({{u"one", MakeObject<Item>(1)}});
+  EXPECT_EQ(record->get(u"one")->value, 1);
+  EXPECT_EQ(record->get(u"two"), nullptr);
+  Array<cppgc::Member<Item>>* values = ObjectConstructor::values(record);
+  EXPECT_EQ(values->value()[0]->value, 1);
+}
+
+}  // namespace compilets
@@ -2,7 +2,7 @@
 #include "testing/gtest/include/gtest/gtest.h"
 
 int main(int argc, char** argv) {
-  compilets::StateExe state_;
+  compilets::StateExe state_(argc, const_cast<const char**>(argv));
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
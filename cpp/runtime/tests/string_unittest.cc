@@ -1,3 +1,5 @@
+#include <vector>
+
 #include "runtime/string.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -61,4 +63,47 @@ TEST_F(StringTest, StringBuilder) {
                     u"literal"));
 }
 
+TEST_F(StringTest, Hash) {
+  String str = u"a string longer than sixteen bytes";
+  EXPECT_EQ(str.hash(), String(str.value()).hash());
+  EXPECT_EQ(str.hash(), HashString(u"a string longer than sixteen bytes"));
+  EXPECT_NE(str.hash(), String(u"a string longer than sixteen bytez").hash());
+  EXPECT_NE(String(u"").hash(), String(std::u16string(1, u'\0')).hash());
+  EXPECT_NE(String(u"ab").hash(), String(u"ba").hash());
+}
+
+TEST_F(StringTest, Intern) {
+  String a = String(u"key").Intern();
+  String b = String(u"key").Intern();
+  EXPECT_TRUE(a.IsInterned());
+  EXPECT_EQ(&a.value(), &b.value());
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, String(u"other").Intern());
+  EXPECT_EQ(a, String(u"key"));
+  EXPECT_EQ(a.Intern().length, 3);
+}
+
+TEST_F(StringTest, CodePoints) {
+  std::vector<String> chars;
+  for (String c : String(u"a\U0001F600b\xD800"))
+    chars.push_back(c);
+  EXPECT_EQ(chars, std::vector<String>({u"a", u"\U0001F600", u"b", u"\xD800"}));
+}
+
+TEST_F(StringTest, FromUTF8Lazily) {
+  String str = String::FromUTF8Lazily("caf\xC3\xA9 \xF0\x9F\x98\x80");
+  EXPECT_EQ(str.length, 7);
+  ASSERT_TRUE(str.undecoded_utf8());
+  EXPECT_EQ(str.ToUTF8(), "caf\xC3\xA9 \xF0\x9F\x98\x80");
+  // Copies share the decoded characters.
+  String copy = str;
+  EXPECT_EQ(str, u"café 😀");
+  EXPECT_FALSE(copy.undecoded_utf8());
+  EXPECT_EQ(copy.hash(), String(u"café 😀").hash());
+  // Invalid bytes are replaced at once.
+  String invalid = String::FromUTF8Lazily("a\xFF");
+  EXPECT_FALSE(invalid.undecoded_utf8());
+  EXPECT_EQ(invalid, u"a\uFFFD");
+}
+
 }  // namespace compilets
@@ -1,9 +1,35 @@
+#include <cmath>
+
+#include "cppgc/persistent.h"
+#include "runtime/object.h"
 #include "runtime/string.h"
 #include "runtime/union.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace compilets {
 
+namespace {
+
+class Counted : public Object {
+ public:
+  explicit Counted(int* destroyed) : destroyed_(destroyed) {}
+  ~Counted() { (*destroyed_)++; }
+
+ private:
+  int* destroyed_;
+};
+
+class Holder : public Object {
+ public:
+  void Trace(cppgc::Visitor* visitor) const override {
+    TraceMember(visitor, member);
+  }
+
+  Union<double, cppgc::Member<Counted>> member;
+};
+
+}  // namespace
+
 class UnionTest : public testing::Test {
 };
 
@@ -14,6 +40,13 @@ static_assert(HasCppgcMember<Union<double, bool>>::value == false);
 static_assert(
     HasCppgcMember<Union<double, cppgc::Member<double>>>::value == true);
 
+// Unions of numbers, booleans, null, undefined and objects are packed.
+static_assert(sizeof(Union<std::monostate, Null, double, bool, Object*>) == 8);
+static_assert(std::is_same_v<Union<double, Object*>,
+                             CompactUnion<double, Object*>>);
+static_assert(std::is_same_v<Union<double, String>,
+                             VariantUnion<double, String>>);
+
 TEST_F(UnionTest, UnionEqualNumber) {
   Union<String, double> n = 123.;
   EXPECT_TRUE(Equal(n, n));
@@ -56,6 +89,47 @@ TEST_F(UnionTest, UnionEqualUnion) {
   EXPECT_TRUE(StrictEqual(n, nullptr));
 }
 
+TEST_F(UnionTest, CompactUnionValues) {
+  Union<std::monostate, double, bool> u;
+  EXPECT_TRUE(StrictEqual(u, std::nullopt));
+  u = 8964.;
+  EXPECT_EQ(Get<double>(u), 8964);
+  EXPECT_TRUE(Equal(u, u"8964"));
+  u = -0.;
+  EXPECT_TRUE(std::signbit(Get<double>(u)));
+  u = std::nan("");
+  EXPECT_TRUE(std::isnan(Get<double>(u)));
+  u = true;
+  EXPECT_TRUE(Get<bool>(u));
+  EXPECT_TRUE(IsTrue(u));
+  u = Union<double, bool>(false);
+  EXPECT_FALSE(Get<bool>(u));
+  EXPECT_FALSE(IsTrue(u));
+}
+
+TEST_F(UnionTest, CompactUnionObject) {
+  int destroyed = 0;
+  Counted* counted = MakeObject<Counted>(&destroyed);
+  Union<std::monostate, double, Counted*> u = counted;
+  EXPECT_EQ(Get<Counted*>(u), counted);
+  EXPECT_EQ(u.GetObject(), counted);
+  EXPECT_TRUE(StrictEqual(u, counted));
+  Union<std::monostate, double, Counted*, String> v = u;
+  EXPECT_EQ(Get<Counted*>(v), counted);
+  EXPECT_EQ(v.GetObject(), counted);
+}
+
+TEST_F(UnionTest, CompactUnionTrace) {
+  int destroyed = 0;
+  cppgc::Persistent<Holder> holder = MakeObject<Holder>();
+  holder->member = MakeObject<Counted>(&destroyed);
+  State::Get()->PreciseGC();
+  EXPECT_EQ(destroyed, 0);
+  holder->member = 123.;
+  State::Get()->PreciseGC();
+  EXPECT_EQ(destroyed, 1);
+}
+
 TEST_F(UnionTest, Ordering) {
   Union<String, double> n = 123.;
   EXPECT_LT(n, 123.4);
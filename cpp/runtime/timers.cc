@@ -0,0 +1,31 @@
+#include "runtime/timers.h"
+
+#include "cppgc/internal/logging.h"
+#include "runtime/event_loop.h"
+
+namespace compilets::internal {
+
+namespace {
+
+EventLoop* GetEventLoop() {
+  EventLoop* event_loop = State::Get()->GetEventLoop();
+  CPPGC_CHECK(event_loop);
+  return event_loop;
+}
+
+}  // namespace
+
+nodejs::Timeout* AddTimer(std::function<void()> callback,
+                          double delay,
+                          bool repeat) {
+  uint64_t id = GetEventLoop()->AddTimer(delay, std::move(callback), repeat);
+  return MakeObject<nodejs::Timeout>(id);
+}
+
+void RemoveTimer(nodejs::Timeout* timeout) {
+  // Like Node.js, clearing an invalid timer does nothing.
+  if (timeout)
+    GetEventLoop()->RemoveTimer(timeout->id());
+}
+
+}  // namespace compilets::internal
@@ -0,0 +1,71 @@
+#ifndef CPP_RUNTIME_TIMERS_H_
+#define CPP_RUNTIME_TIMERS_H_
+
+#include <stdint.h>
+
+#include <functional>
+
+#include "cppgc/persistent.h"
+#include "runtime/function.h"
+
+namespace compilets {
+
+namespace nodejs {
+
+// The object returned by setTimeout and setInterval.
+class Timeout final : public Object {
+ public:
+  explicit Timeout(uint64_t id) : id_(id) {}
+
+  uint64_t id() const { return id_; }
+
+ private:
+  uint64_t id_;
+};
+
+}  // namespace nodejs
+
+namespace internal {
+
+nodejs::Timeout* AddTimer(std::function<void()> callback,
+                          double delay,
+                          bool repeat);
+void RemoveTimer(nodejs::Timeout* timeout);
+
+// The pending timer keeps the callback alive until it is removed.
+template<typename R>
+inline std::function<void()> MakeTimerCallback(Function<R()>* callback) {
+  return [callback = cppgc::Persistent<Function<R()>>(callback)]() {
+    callback->value()();
+  };
+}
+
+}  // namespace internal
+
+namespace nodejs {
+
+template<typename R>
+inline Timeout* setTimeout(Function<R()>* callback, double delay = 0) {
+  return internal::AddTimer(internal::MakeTimerCallback(callback), delay,
+                            false);
+}
+
+template<typename R>
+inline Timeout* setInterval(Function<R()>* callback, double delay = 0) {
+  return internal::AddTimer(internal::MakeTimerCallback(callback), delay,
+                            true);
+}
+
+inline void clearTimeout(Timeout* timeout) {
+  internal::RemoveTimer(timeout);
+}
+
+inline void clearInterval(Timeout* timeout) {
+  internal::RemoveTimer(timeout);
+}
+
+}  // namespace nodejs
+
+}  // namespace compilets
+
+#endif  // CPP_RUNTIME_TIMERS_H_
@@ -1,5 +1,7 @@
 #include "runtime/type_traits.h"
 
+#include <algorithm>
+
 #include "cppgc/internal/logging.h"
 #include "fastfloat/fast_float.h"
 #include "simdutf/simdutf.h"
@@ -18,12 +20,21 @@ std::u16string UTF8ToUTF16(const char* str, size_t length) {
 
 }  // namespace
 
-std::u16string ToStringImpl(double value) {
+namespace internal {
+
+size_t NumberToChars(double value, char* buffer) {
   // Having 16 decimal digits is enough for double.
   // https://stackoverflow.com/questions/9999221
-  char buffer[16] = {0};
-  snprintf(buffer, sizeof(buffer), "%g", value);
-  return UTF8ToUTF16(buffer, strlen(buffer));
+  int length = snprintf(buffer, kNumberToCharsSize, "%g", value);
+  return std::min(static_cast<size_t>(length), kNumberToCharsSize - 1);
+}
+
+}  // namespace internal
+
+std::u16string ToStringImpl(double value) {
+  char buffer[internal::kNumberToCharsSize] = {0};
+  size_t length = internal::NumberToChars(value, buffer);
+  return UTF8ToUTF16(buffer, length);
 }
 
 }  // namespace compilets
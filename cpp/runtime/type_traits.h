@@ -7,6 +7,7 @@
 
 #include "cppgc/member.h"
 #include "cppgc/visitor.h"
+#include "runtime/optional.h"
 
 namespace compilets {
 
@@ -34,6 +35,14 @@ auto Visit(F&& visitor, const std::optional<T>& value) {
     return visitor(std::nullopt);
 }
 
+template<typename F>
+auto Visit(F&& visitor, const CompactOptional<double>& value) {
+  if (value)
+    return visitor(value.value());
+  else
+    return visitor(std::nullopt);
+}
+
 template<typename F, typename T>
 auto Visit(F&& visitor, const cppgc::Member<T>& value) {
   if (value)
@@ -42,6 +51,17 @@ auto Visit(F&& visitor, const cppgc::Member<T>& value) {
     return visitor(std::nullopt);
 }
 
+namespace internal {
+
+// Longest output of NumberToChars, including the terminating null.
+inline constexpr size_t kNumberToCharsSize = 16;
+
+// Write the number as ASCII to |buffer|, which has kNumberToCharsSize chars,
+// and return the length.
+size_t NumberToChars(double value, char* buffer);
+
+}  // namespace internal
+
 // Convert value to string.
 std::u16string ToStringImpl(double value);
 inline std::u16string ToStringImpl(const char16_t* str) { return str; }
@@ -124,6 +144,10 @@ inline const T& GetOptionalValue(const std::optional<T>& value) {
   return std::move(value.value());
 }
 
+inline double GetOptionalValue(const CompactOptional<double>& value) {
+  return value.value();
+}
+
 template<typename T>
 inline const T& GetOptionalValue(const T& value) {
   return value;
@@ -141,7 +165,7 @@ using ValueType = Value<T, enable>::Type;
 // Receive the optional value type for T.
 template<typename T, typename enable = void>
 struct OptionalValue {
-  using Type = std::optional<T>;
+  using Type = Optional<T>;
 };
 
 template<typename T, typename enable = void>
@@ -159,7 +183,7 @@ using CppgcMemberType = CppgcMember<T, enable>::Type;
 // Receive the optional property type for T.
 template<typename T, typename enable = void>
 struct OptionalCppgcMember {
-  using Type = std::optional<T>;
+  using Type = Optional<T>;
 };
 
 template<typename T, typename enable = void>
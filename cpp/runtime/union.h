@@ -1,70 +1,370 @@
 #ifndef CPP_RUNTIME_UNION_H_
 #define CPP_RUNTIME_UNION_H_
 
+#include <stdint.h>
+
+#include <bit>
+#include <cmath>
+#include <compare>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <variant>
 
+#include "cppgc/heap-consistency.h"
+#include "cppgc/internal/logging.h"
 #include "runtime/type_traits.h"
 
 namespace compilets {
 
 class Object;
 
-// Union extends std::variant with following abilities:
+template<typename... Ts>
+class VariantUnion;
+
+template<typename... Ts>
+class CompactUnion;
+
+namespace internal {
+
+// Types that CompactUnion can store in its 8 bytes.
+template<typename T>
+struct IsCompactAlternative
+    : std::disjunction<std::is_same<T, double>,
+                       std::is_same<T, bool>,
+                       std::is_same<T, std::monostate>,
+                       std::is_same<T, Null>,
+                       std::is_pointer<T>,
+                       IsCppgcMember<T>> {};
+
+// The alternative index is stored in the 3 low bits of pointers, which are
+// always zero for GCed objects.
+template<typename... Ts>
+constexpr bool IsCompactUnionV = sizeof(void*) == 8 &&
+                                 sizeof...(Ts) <= 8 &&
+                                 (IsCompactAlternative<Ts>::value && ...);
+
+}  // namespace internal
+
+// Union is the translation of TypeScript's union types, with following
+// abilities on top of std::variant:
 // 1. Allow construction from a subset.
 // 2. Unions with different orders of same types are treated as same type.
+//
+// Unions made of only numbers, booleans, null, undefined and objects are
+// packed into 8 bytes by CompactUnion, the others use VariantUnion.
 template<typename... Ts>
-class Union : public std::variant<Ts...> {
+using Union = std::conditional_t<internal::IsCompactUnionV<Ts...>,
+                                 CompactUnion<Ts...>,
+                                 VariantUnion<Ts...>>;
+
+// Utility to check if the type is an union.
+template<typename T>
+struct IsUnion : std::false_type {};
+
+template<typename... Ts>
+struct IsUnion<VariantUnion<Ts...>> : std::true_type {};
+
+template<typename... Ts>
+struct IsUnion<CompactUnion<Ts...>> : std::true_type {};
+
+// Utility to check if the union contains a certain type.
+template<typename U, typename T>
+struct IsUnionMember : std::false_type {};
+
+template<typename U, typename... Ts>
+struct IsUnionMember<U, VariantUnion<Ts...>>
+    : std::disjunction<std::is_same<U, Ts>...> {};
+
+template<typename U, typename... Ts>
+struct IsUnionMember<U, CompactUnion<Ts...>>
+    : std::disjunction<std::is_same<U, Ts>...> {};
+
+// Union stored as std::variant, used when some types can not be packed.
+template<typename... Ts>
+class VariantUnion : public std::variant<Ts...> {
  public:
   using std::variant<Ts...>::variant;
   using std::variant<Ts...>::operator=;
 
   template<typename... Us>
-  Union(std::variant<Us...> value)
+  VariantUnion(std::variant<Us...> value)
       : std::variant<Ts...>(std::visit([](auto&& v) {
                               return std::variant<Ts...>(v);
                             }, std::move(value))) {}
 
+  template<typename... Us>
+  VariantUnion(const CompactUnion<Us...>& value)
+      : std::variant<Ts...>(value.VisitAlternative([](auto v) {
+                              return std::variant<Ts...>(v);
+                            })) {}
+
   // Get the object pointer from variant.
   Object* GetObject() const {
-    return std::visit([](const auto& v) {
-      if constexpr (std::is_pointer_v<decltype(v)>)
+    return std::visit([]<typename U>(const U& v) -> Object* {
+      if constexpr (std::is_pointer_v<U>)
         return v;
+      else if constexpr (IsCppgcMember<U>::value)
+        return v.Get();
       else
         return nullptr;
     }, *this);
   }
 };
 
-// Utility to check if the type is an union.
-template<typename T>
-struct IsUnion : std::false_type {};
-
+// Union packed into a single 64-bit word:
+// * Doubles are stored with their bits plus 2^49, so the high 16 bits are
+//   never zero. NaNs are canonicalized first to make it work for them too.
+// * Pointers are stored as is with the alternative index in the low 3 bits,
+//   their high 16 bits are zero in 48-bit address spaces.
+// * Other values are small integers carrying the alternative index in the low
+//   3 bits, and the value of booleans in bit 3.
+//
+// Since the pointers are kept intact, conservative stack scanning still finds
+// the objects. Alternatives of cppgc::Member<T> are traced by TraceMember and
+// do the same write barrier as cppgc::Member on assignment.
 template<typename... Ts>
-struct IsUnion<Union<Ts...>> : std::true_type {};
+class CompactUnion {
+ public:
+  template<size_t I>
+  using Alternative = std::tuple_element_t<I, std::tuple<Ts...>>;
 
-// Utility to check if the union contains a certain type.
-template<typename U, typename T>
-struct IsUnionMember : std::false_type {};
+  CompactUnion() : CompactUnion(Alternative<0>()) {}
 
-template<typename U, typename... Ts>
-struct IsUnionMember<U, Union<Ts...>>
-    : std::disjunction<std::is_same<U, Ts>...> {};
+  template<typename U>
+    requires (!IsUnion<std::remove_cvref_t<U>>::value)
+  CompactUnion(const U& value) {
+    Store<FindAlternative<U>()>(value);
+  }
+
+  template<typename... Us>
+  CompactUnion(const CompactUnion<Us...>& other) {
+    other.VisitAlternative([this](auto v) {
+      Store<FindAlternative<decltype(v)>()>(v);
+    });
+  }
+
+  template<typename... Us>
+  CompactUnion(const VariantUnion<Us...>& other) {
+    std::visit([this]<typename U>(const U& v) {
+      Store<FindAlternative<U>()>(v);
+    }, other);
+  }
+
+  CompactUnion(const CompactUnion& other) = default;
+
+  CompactUnion& operator=(const CompactUnion& other) {
+    bits_ = other.bits_;
+    WriteBarrier();
+    return *this;
+  }
+
+  size_t index() const {
+    if (bits_ >> 48)
+      return kDoubleIndex;
+    return bits_ & kIndexMask;
+  }
+
+  // Return the alternative I, cppgc::Member<T> is returned as T*.
+  template<size_t I>
+  auto GetAlternative() const {
+    CPPGC_DCHECK(index() == I);
+    using T = Alternative<I>;
+    if constexpr (std::is_same_v<T, double>)
+      return std::bit_cast<double>(bits_ - kDoubleOffset);
+    else if constexpr (std::is_same_v<T, bool>)
+      return static_cast<bool>(bits_ & kBoolBit);
+    else if constexpr (std::is_pointer_v<T>)
+      return reinterpret_cast<T>(bits_ & ~kIndexMask);
+    else if constexpr (IsCppgcMember<T>::value)
+      return reinterpret_cast<decltype(std::declval<T>().Get())>(
+          bits_ & ~kIndexMask);
+    else
+      return T();
+  }
+
+  // Like std::visit but the visitor receives the values of GetAlternative.
+  template<typename F>
+  auto VisitAlternative(F&& visitor) const {
+    return VisitAt<0>(std::forward<F>(visitor), index());
+  }
+
+  // Get the object pointer from union.
+  Object* GetObject() const {
+    // When all alternatives are objects, the pointer is just the bits without
+    // the index, which works because classes only use single inheritance and
+    // the Object is always at the start.
+    if constexpr (((std::is_pointer_v<Ts> || IsCppgcMember<Ts>::value) && ...))
+      return reinterpret_cast<Object*>(bits_ & ~kIndexMask);
+    return VisitAlternative([]<typename U>(U v) -> Object* {
+      if constexpr (std::is_pointer_v<U>)
+        return v;
+      else
+        return nullptr;
+    });
+  }
+
+  void Trace(cppgc::Visitor* visitor) const {
+    TraceAt<0>(visitor, index());
+  }
+
+ private:
+  static constexpr size_t kDoubleIndex = [] {
+    size_t index = 0;
+    ((std::is_same_v<Ts, double> ? false : (++index, true)) && ...);
+    return index;
+  }();
+  static constexpr uint64_t kIndexMask = 0b111;
+  static constexpr uint64_t kBoolBit = 0b1000;
+  static constexpr uint64_t kDoubleOffset = uint64_t{1} << 49;
+  static constexpr uint64_t kCanonicalNaN = 0x7ff8000000000000;
+
+  // Find the alternative that a value of U converts to, in the order of:
+  // same type, object pointer that U converts to, and number.
+  template<typename U>
+  static constexpr size_t FindAlternative() {
+    using V = std::remove_cvref_t<U>;
+    size_t result = sizeof...(Ts);
+    size_t index = 0;
+    ((std::is_same_v<Ts, V> && result == sizeof...(Ts) ? result = index : 0,
+      ++index), ...);
+    if (result != sizeof...(Ts))
+      return result;
+    if constexpr (IsCppgcMember<V>::value) {
+      return FindAlternative<decltype(std::declval<V>().Get())>();
+    } else if constexpr (std::is_pointer_v<V> || std::is_null_pointer_v<V>) {
+      index = 0;
+      ((IsPointerAlternative<Ts, V>() && result == sizeof...(Ts) ?
+            result = index : 0,
+        ++index), ...);
+    } else if constexpr (std::is_arithmetic_v<V>) {
+      result = kDoubleIndex;
+    }
+    return result;
+  }
+
+  template<typename T, typename P>
+  static constexpr bool IsPointerAlternative() {
+    if constexpr (std::is_pointer_v<T>)
+      return std::is_convertible_v<P, T>;
+    else if constexpr (IsCppgcMember<T>::value)
+      return std::is_convertible_v<P, decltype(std::declval<T>().Get())>;
+    else
+      return false;
+  }
+
+  template<size_t I, typename U>
+  void Store(const U& value) {
+    static_assert(I < sizeof...(Ts), "The type is not a member of union");
+    using T = Alternative<I>;
+    if constexpr (std::is_same_v<T, double>) {
+      double number = static_cast<double>(value);
+      uint64_t bits = std::isnan(number) ? kCanonicalNaN
+                                         : std::bit_cast<uint64_t>(number);
+      bits_ = bits + kDoubleOffset;
+    } else if constexpr (std::is_same_v<T, bool>) {
+      bits_ = (value ? kBoolBit : 0) | I;
+    } else if constexpr (std::is_pointer_v<T> || IsCppgcMember<T>::value) {
+      using Pointer = decltype(GetAlternative<I>());
+      Pointer pointer;
+      if constexpr (IsCppgcMember<U>::value)
+        pointer = value.Get();
+      else
+        pointer = value;
+      uint64_t bits = reinterpret_cast<uint64_t>(pointer);
+      CPPGC_DCHECK((bits >> 48) == 0 && (bits & kIndexMask) == 0);
+      bits_ = bits | I;
+    } else {
+      bits_ = I;
+    }
+  }
+
+  template<size_t I, typename F>
+  auto VisitAt(F&& visitor, size_t index) const {
+    if constexpr (I + 1 < sizeof...(Ts)) {
+      if (index != I)
+        return VisitAt<I + 1>(std::forward<F>(visitor), index);
+    }
+    return visitor(GetAlternative<I>());
+  }
+
+  template<size_t I>
+  void TraceAt(cppgc::Visitor* visitor, size_t index) const {
+    if constexpr (IsCppgcMember<Alternative<I>>::value) {
+      if (index == I)
+        visitor->Trace(Alternative<I>(GetAlternative<I>()));
+    }
+    if constexpr (I + 1 < sizeof...(Ts))
+      TraceAt<I + 1>(visitor, index);
+  }
+
+  // Unions with cppgc::Member<T> are stored in GCed objects, and assigning an
+  // object must be seen by the incremental marker.
+  void WriteBarrier() const {
+    if constexpr ((IsCppgcMember<Ts>::value || ...)) {
+      // Only decide by the index, as the bits of booleans can look like
+      // pointers.
+      constexpr bool kIsMember[] = {IsCppgcMember<Ts>::value...};
+      if (!kIsMember[index()] || (bits_ & ~kIndexMask) == 0)
+        return;
+      const void* object = reinterpret_cast<const void*>(bits_ & ~kIndexMask);
+      using cppgc::subtle::HeapConsistency;
+      HeapConsistency::WriteBarrierParams params;
+      auto type = HeapConsistency::GetWriteBarrierType(this, object, params);
+      if (type == HeapConsistency::WriteBarrierType::kMarking)
+        HeapConsistency::DijkstraWriteBarrier(params, object);
+      else if (type == HeapConsistency::WriteBarrierType::kGenerational)
+        HeapConsistency::GenerationalBarrier(params, this);
+    }
+  }
+
+  uint64_t bits_;
+};
+
+// Read the value of type T from union, like std::get.
+template<typename T, typename... Ts>
+inline const T& Get(const VariantUnion<Ts...>& value) {
+  return std::get<T>(value);
+}
+
+template<typename T, typename... Ts>
+inline T Get(VariantUnion<Ts...>&& value) {
+  return std::get<T>(std::move(value));
+}
+
+template<typename T, typename... Ts>
+inline auto Get(const CompactUnion<Ts...>& value) {
+  constexpr size_t index = [] {
+    size_t result = 0;
+    ((std::is_same_v<Ts, T> ? false : (++result, true)) && ...);
+    return result;
+  }();
+  static_assert(index < sizeof...(Ts), "The type is not a member of union");
+  CPPGC_CHECK(value.index() == index);
+  return value.template GetAlternative<index>();
+}
 
 // Helper to trace the union type.
 template<typename... Ts>
-inline void TraceMember(cppgc::Visitor* visitor, const Union<Ts...>& member) {
+inline void TraceMember(cppgc::Visitor* visitor,
+                        const VariantUnion<Ts...>& member) {
   std::visit([visitor](auto&& arg) {
-    if constexpr (HasCppgcMember<decltype(arg)>::value) {
+    if constexpr (HasCppgcMember<std::remove_cvref_t<decltype(arg)>>::value) {
       TraceMember(visitor, arg);
     }
   }, member);
 }
 
+template<typename... Ts>
+inline void TraceMember(cppgc::Visitor* visitor,
+                        const CompactUnion<Ts...>& member) {
+  member.Trace(visitor);
+}
+
 // Pass compilets::Visit to std::visit.
 template<typename F, typename... Ts>
-auto Visit(F&& visitor, const Union<Ts...>& value) {
-  if constexpr (IsUnionMember<std::monostate, Union<Ts...>>::value) {
+auto Visit(F&& visitor, const VariantUnion<Ts...>& value) {
+  if constexpr (IsUnionMember<std::monostate, VariantUnion<Ts...>>::value) {
     // Pass nullopt instead of monostate to visitor.
     if (std::holds_alternative<std::monostate>(value))
       return visitor(std::nullopt);
@@ -72,25 +372,53 @@ auto Visit(F&& visitor, const Union<Ts...>& value) {
   return std::visit(visitor, value);
 }
 
+template<typename F, typename... Ts>
+auto Visit(F&& visitor, const CompactUnion<Ts...>& value) {
+  return value.VisitAlternative([&visitor]<typename U>(const U& arg) {
+    if constexpr (std::is_same_v<U, std::monostate>)
+      return visitor(std::nullopt);
+    else
+      return visitor(arg);
+  });
+}
+
 // Replace T with cppgc::Member<T>.
 template<typename... Ts>
-struct CppgcMember<Union<Ts...>> {
+struct CppgcMember<VariantUnion<Ts...>> {
+  using Type = Union<CppgcMemberType<Ts>...>;
+};
+
+template<typename... Ts>
+struct CppgcMember<CompactUnion<Ts...>> {
   using Type = Union<CppgcMemberType<Ts>...>;
 };
 
 // Extend HasCppgcMember to check members inside a variant.
 template<typename... Ts>
-struct HasCppgcMember<Union<Ts...>>
+struct HasCppgcMember<VariantUnion<Ts...>>
+    : std::disjunction<HasCppgcMember<Ts>...> {};
+
+template<typename... Ts>
+struct HasCppgcMember<CompactUnion<Ts...>>
     : std::disjunction<HasCppgcMember<Ts>...> {};
 
 // Ordering for union.
 template<typename... Ts, typename U>
-std::partial_ordering operator<=>(const Union<Ts...>& left, const U& right) {
+std::partial_ordering operator<=>(const VariantUnion<Ts...>& left,
+                                  const U& right) {
   return std::visit([&right](const auto& arg) {
     return arg <=> right;
   }, left);
 }
 
+template<typename... Ts, typename U>
+std::partial_ordering operator<=>(const CompactUnion<Ts...>& left,
+                                  const U& right) {
+  return left.VisitAlternative([&right](const auto& arg) {
+    return arg <=> right;
+  });
+}
+
 }  // namespace compilets
 
 #endif  // CPP_RUNTIME_UNION_H_
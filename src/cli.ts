@@ -1,7 +1,7 @@
 #!/usr/bin/env node
 
 import {Builtins, Cli, Command, Option} from 'clipanion';
-import {generateCppProject, ninjaBuild, gnGen} from './index';
+import {generateCppProject, watchCppProject, ninjaBuild, gnGen} from './index';
 import packageJson from '../package.json';
 
 export class GenCommand extends Command {
@@ -43,9 +43,14 @@ export class GnGenCommand extends Command {
 
   config = Option.String('--config', {description: 'Debug or Release'});
   target = Option.String('--target', {required: true, description: 'The path of C++ project'});
+  profileAllocations = Option.Boolean('--profile-allocations', false, {description: 'Report allocations per type and site on exit'});
 
   async execute() {
-    await gnGen(this.target, {config: this.config ?? 'Release', stream: true});
+    await gnGen(this.target, {
+      config: this.config ?? 'Release',
+      stream: true,
+      allocationProfiler: this.profileAllocations,
+    });
   }
 }
 
@@ -75,6 +80,40 @@ export class BuildCommand extends Command {
   }
 }
 
+export class WatchCommand extends Command {
+  static paths = [ [ 'watch' ] ];
+  static usage = Command.Usage({
+    description: 'Generate and build the C++ project, and rebuild on changes.',
+    details: `
+      Only the changed files and the files depending on them are translated
+      again, and only the affected targets are rebuilt. Adding new files
+      requires restarting the command.
+    `,
+    examples: [
+      [
+        'Watch $CWD and build at $CWD/cpp-project',
+        '$0 watch',
+      ],
+      [
+        'Specify the path of TypeScript project and C++ project',
+        '$0 watch --root /path/to/ts-project --target /path/to/cpp-project',
+      ],
+    ]
+  });
+
+  root = Option.String('--root', {description: 'The path of TypeScript project, default is $CWD'});
+  config = Option.String('--config', {description: 'Debug or Release'});
+  target = Option.String('--target', {description: 'The path of C++ project, default is $CWD/cpp-project'});
+
+  async execute() {
+    const root = this.root ?? process.cwd();
+    const target = this.target ?? `${process.cwd()}/cpp-project`;
+    watchCppProject(root, target, {config: this.config ?? 'Release', stream: true});
+    // Keep running until the process is killed.
+    await new Promise(() => {});
+  }
+}
+
 const cli = new Cli({
   binaryName: `compilets`,
   binaryLabel: 'Compilets',
@@ -86,4 +125,5 @@ cli.register(Builtins.VersionCommand);
 cli.register(GenCommand);
 cli.register(GnGenCommand);
 cli.register(BuildCommand);
+cli.register(WatchCommand);
 cli.runExit(process.argv.slice(2)).then(() => process.exit());
@@ -16,7 +16,7 @@ import {
 /**
  * Possible types of the CppFile.
  */
-type CppFileType = 'lib' |  // file shared between all targets
+export type CppFileType = 'lib' |  // file shared between all targets
                    'exe' |  // executable entry file
                    'napi';  // native module entry file
 
@@ -256,6 +256,9 @@ export default class CppFile {
       interfaces = interfaces.difference(ctx.includedInterfaces);
     if (interfaces.size == 0)
       return [ [], [] ];
+    // Value types only have primitive members and can be printed before other
+    // interfaces, which may contain them by value.
+    const valueDeclarations: NamespaceBlock[] = [];
     const fullDeclarations: NamespaceBlock[] = [];
     const forwardDeclarations: NamespaceBlock[] = [];
     // As interfaces are being generated while printing, keep printing until
@@ -270,7 +273,7 @@ export default class CppFile {
         using scope = new PrintContextScope(ctx, {interfaces: new Set<string>()});
         // Print the full declaration first.
         const type = this.interfaceRegistry.get(name);
-        fullDeclarations.push({
+        (type.isValueType ? valueDeclarations : fullDeclarations).push({
           code: type.printDeclaration(ctx),
           namespace: ctx.namespace,
         });
@@ -289,10 +292,11 @@ export default class CppFile {
           usedInterfaces = usedInterfaces.difference(ctx.includedInterfaces);
         // Add them to the collections.
         interfaces = interfaces.union(usedInterfaces);
-        forwardDeclaredInterfaces = forwardDeclaredInterfaces.union(usedInterfaces);
+        forwardDeclaredInterfaces = forwardDeclaredInterfaces.union(
+          new Set(Array.from(usedInterfaces).filter(n => !this.interfaceRegistry.get(n).isValueType)));
       }
     }
-    return [ fullDeclarations, forwardDeclarations ];
+    return [ [ ...valueDeclarations, ...fullDeclarations ], forwardDeclarations ];
   }
 
   /**
@@ -301,17 +305,19 @@ export default class CppFile {
   private printImportHeaders(ctx: PrintContext): NamespaceBlock[] {
     if (this.imports.length == 0 || (ctx.mode == 'impl' && this.hasExports()))
       return [];
-    // Include the headers of imported files.
-    const headers = this.imports.map(i => <IncludeDirective>{
+    // Include the headers of imported files, the builtin modules are included
+    // with runtime headers.
+    const headers = this.imports.filter(i => !i.feature).map(i => <IncludeDirective>{
       type: 'quoted',
       path: i.fileName.replace(/\.ts$/, '.h'),
     });
     // Print the import directives.
     const directives = this.imports.map(i => i.print(ctx)).join('\n');
-    return [
-      printIncludes(headers),
-      {code: directives, namespace: ctx.namespace},
-    ];
+    const blocks: NamespaceBlock[] = [];
+    if (headers.length > 0)
+      blocks.push(printIncludes(headers));
+    blocks.push({code: directives, namespace: ctx.namespace});
+    return blocks;
   }
 
   /**
@@ -328,6 +334,11 @@ export default class CppFile {
     // Interfaces requires object header.
     if (ctx.interfaces.size > 0)
       ctx.features.add('object');
+    // Imported builtin modules.
+    for (const i of this.imports) {
+      if (i.feature)
+        ctx.features.add(i.feature);
+    }
     // Remove included headers.
     let features = ctx.features;
     if (ctx.includedFeatures)
@@ -350,12 +361,28 @@ export default class CppFile {
         case 'union':
         case 'math':
         case 'number':
+        case 'map':
+        case 'set':
+        case 'record':
+        case 'generator':
+        case 'promise':
+        case 'timers':
+        case 'buffer':
+        case 'fs':
+        case 'readline':
+        case 'json':
         case 'runtime':
           headers.push({type: 'quoted', path: `runtime/${feature}.h`});
           break;
         case 'converters':
           headers.push({type: 'quoted', path: `runtime/node/${feature}.h`});
           break;
+        case 'array-buffer':
+          headers.push({type: 'quoted', path: 'runtime/array_buffer.h'});
+          break;
+        case 'allocation-scope':
+          headers.push({type: 'quoted', path: 'runtime/allocation_scope.h'});
+          break;
       }
     }
     let allFeatures = ctx.features;
@@ -568,6 +595,17 @@ function hasHeadersUsingObject(features: Set<Feature>) {
       case 'function':
       case 'process':
       case 'console':
+      case 'map':
+      case 'set':
+      case 'record':
+      case 'generator':
+      case 'promise':
+      case 'timers':
+      case 'array-buffer':
+      case 'buffer':
+      case 'fs':
+      case 'readline':
+      case 'json':
         return true;
     }
   }
@@ -586,6 +624,17 @@ function hasHeadersUsingTypeTraits(features: Set<Feature>) {
       case 'string':
       case 'union':
       case 'number':
+      case 'map':
+      case 'set':
+      case 'record':
+      case 'generator':
+      case 'promise':
+      case 'timers':
+      case 'array-buffer':
+      case 'buffer':
+      case 'fs':
+      case 'readline':
+      case 'json':
         return true;
     }
   }
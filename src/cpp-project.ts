@@ -3,6 +3,7 @@ import path from 'node:path';
 import * as ts from 'typescript';
 
 import CppFile from './cpp-file';
+import TranslationCache, {PrintedFile} from './translation-cache';
 import {PrintContext} from './print-utils';
 import {downloadNodeHeaders} from './gn-utils';
 import * as syntax from './cpp-syntax';
@@ -19,9 +20,10 @@ export default class CppProject {
   fileNames: string[] = [];
   compilerOptions: ts.CompilerOptions;
   skipPreEmitDiagnostics = false;
+  cache?: TranslationCache;
 
   // Key is filename without suffix - both .h and .cpp use the same CppFile.
-  private cppFiles = new Map<string, CppFile>();
+  private cppFiles = new Map<string, CppFile | PrintedFile>();
 
   constructor(rootDir: string) {
     this.rootDir = rootDir;
@@ -66,9 +68,10 @@ export default class CppProject {
    * Add the result of a parsed TypeScript file.
    *
    * The `name` has not .cpp/.h extension, as both header and impl files are
-   * printed using the same CppFile instance.
+   * printed using the same CppFile instance. The file can also be a
+   * PrintedFile with the code printed by last generation.
    */
-  addParsedFile(name: string, file: CppFile) {
+  addParsedFile(name: string, file: CppFile | PrintedFile) {
     if (this.cppFiles.has(name))
       throw new Error(`The file "${name}" already exists in project`);
     this.cppFiles.set(name, file);
@@ -94,8 +97,8 @@ export default class CppProject {
    * The result is a tuple with first value being the actual filename with the
    * .cpp/.h extension.
    */
-  getFiles(): [string, CppFile][] {
-    const result: [string, CppFile][] = [];
+  getFiles(): [string, CppFile | PrintedFile][] {
+    const result: [string, CppFile | PrintedFile][] = [];
     for (const [ name, file ] of this.cppFiles) {
       if (file.hasExports())
         result.push([ name + '.h', file ]);
@@ -130,23 +133,55 @@ export default class CppProject {
 
   /**
    * Create a C++ project at `target` directory.
+   *
+   * Copying the C++ dependencies can be skipped when they are known to be
+   * up to date. Returns the names of the printed files that have changed.
    */
-  async writeTo(target: string) {
+  async writeTo(target: string, {copyDependencies = true} = {}): Promise<string[]> {
     await fs.ensureDir(target);
     const tasks: Promise<void>[] = [];
-    tasks.push(this.writeGnFiles(target));
+    tasks.push(this.writeGnFiles(target, copyDependencies));
+    const changedFiles: string[] = [];
     for (const [ name, content ] of this.getPrintedFiles()) {
       const filepath = `${target}/${name}`;
       await fs.ensureFile(filepath);
-      await writeFile(filepath, content);
+      if (await writeFile(filepath, content))
+        changedFiles.push(name);
+      this.cache?.setPrintedFile(name, content);
     }
-    return Promise.all(tasks);
+    if (this.cache)
+      tasks.push(this.cache.save());
+    await Promise.all(tasks);
+    return changedFiles;
+  }
+
+  /**
+   * Return the GN targets that should be rebuilt when the printed files have
+   * changed.
+   */
+  getTargetsOfFiles(fileNames: string[]): string[] {
+    const targets = new Set<string>();
+    for (const fileName of fileNames) {
+      // Headers and shared files can affect every target.
+      const type = this.getFileType(fileName.replace(/\.(h|cpp)$/, '.ts'));
+      if (type == 'lib' || fileName.endsWith('.h'))
+        return [ 'default' ];
+      if (type == 'napi') {
+        targets.add(this.name);
+      } else {
+        for (const name in this.executables) {
+          if (this.executables[name] == fileName.replace(/\.cpp$/, '.ts'))
+            targets.add(name);
+        }
+      }
+    }
+    return Array.from(targets);
   }
 
   /**
    * Create a minimal GN project at the `target` directory.
    */
-  private async writeGnFiles(target: string) {
+  private async writeGnFiles(target: string, copyDependencies: boolean) {
     // The common config that every target should have.
     const commonConfig = `
   configs -= [
@@ -239,10 +274,12 @@ ${commonConfig}
 ${targets.map(t => `    ":${t}",`).join('\n')}
   ]
 }`);
+    await writeFile(`${target}/BUILD.gn`, buildgn.join('\n\n'));
+    if (!copyDependencies)
+      return;
     // Copy C++ dependencies.
     await fs.ensureDir(`${target}/cpp`);
     const tasks = [
-      writeFile(`${target}/BUILD.gn`, buildgn.join('\n\n')),
       fs.copy(`${__dirname}/../cpp`, `${target}/cpp`, {filter}),
       fs.copy(`${__dirname}/../cpp/.gn`, `${target}/.gn`, {filter}),
     ];
@@ -293,14 +330,15 @@ ${targets.map(t => `    ":${t}",`).join('\n')}
   }
 }
 
-// Only write file when content has changed.
-async function writeFile(target: string, content: string) {
+// Only write file when content has changed, and return whether written.
+async function writeFile(target: string, content: string): Promise<boolean> {
   try {
     const oldContent = await fs.readFile(target);
     if (oldContent.toString() == content)
-      return;
+      return false;
   } catch {}
   await fs.writeFile(target, content);
+  return true;
 }
 
 // Filter function used by fs.copy to only write when content has changed.
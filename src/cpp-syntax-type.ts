@@ -8,6 +8,7 @@ import {
 import {
   notTriviallyDestructible,
   createTraceMethod,
+  createVisitPropertiesMethod,
 } from './cpp-syntax-utils';
 import {
   PrintContext,
@@ -60,6 +61,11 @@ export class Type {
     return new Type('double', 'primitive', modifiers);
   }
 
+  // BigInt values are limited to 64 bits.
+  static createBigIntType(modifiers?: TypeModifier[]) {
+    return new Type('int64_t', 'primitive', modifiers);
+  }
+
   static createVoidType(name = 'void', modifiers?: TypeModifier[]) {
     return new Type(name, 'void', modifiers);
   }
@@ -294,12 +300,35 @@ export class Type {
         ctx.features.add('math');
       if (this.name == 'Number' || this.name == 'NumberConstructor')
         ctx.features.add('number');
+      if (this.name == 'Map')
+        ctx.features.add('map');
+      else if (this.name == 'Set')
+        ctx.features.add('set');
+      else if (this.name == 'Record' || this.name == 'ObjectConstructor')
+        ctx.features.add('record');
+      else if (this.name == 'Generator')
+        ctx.features.add('generator');
+      else if (this.name == 'Promise')
+        ctx.features.add('promise');
+      else if (this.name == 'ArrayBuffer' || this.name == 'Uint8Array')
+        ctx.features.add('array-buffer');
+      this.templateArguments?.forEach(a => a.markUsed(ctx));
     } else if (this.namespace == 'compilets::nodejs') {
       ctx.features.add('runtime');
       if (this.name == 'Console')
         ctx.features.add('console');
-      else if (this.name == 'Process')
+      else if ([ 'Process', 'Performance', 'HRTime' ].includes(this.name))
         ctx.features.add('process');
+      else if ([ 'Timeout', 'setTimeout', 'setInterval', 'clearTimeout', 'clearInterval' ].includes(this.name))
+        ctx.features.add('timers');
+      else if (this.name == 'Buffer')
+        ctx.features.add('buffer');
+    } else if (this.namespace == 'compilets::nodejs::fs') {
+      ctx.features.add('fs');
+    } else if (this.namespace == 'compilets::nodejs::readline') {
+      ctx.features.add('readline');
+    } else if (this.namespace == 'compilets::JSON') {
+      ctx.features.add('json');
     }
     for (const type of this.types) {
       type.markUsed(ctx);
@@ -329,6 +358,23 @@ export class Type {
            this.category == 'primitive';
   }
 
+  /**
+   * Whether copying a value of this type costs more than passing a reference,
+   * which is the case for refcounted strings and variants holding them.
+   */
+  isExpensiveToCopy(): boolean {
+    if (this.category == 'union')
+      return this.types.some(t => t.isExpensiveToCopy());
+    return this.category == 'string';
+  }
+
+  /**
+   * Whether this is the 64-bit integer representing bigint.
+   */
+  isBigInt() {
+    return this.category == 'primitive' && this.name == 'int64_t';
+  }
+
   /**
    * Whether this type inherits from Object.
    */
@@ -340,6 +386,25 @@ export class Type {
            this.category == 'super';
   }
 
+  /**
+   * Whether this is an object used as dictionary.
+   */
+  isRecord() {
+    return this.category == 'class' &&
+           this.namespace == 'compilets' &&
+           this.name == 'Record';
+  }
+
+  /**
+   * Whether this is a view of bytes whose elements can be accessed.
+   */
+  isByteArray() {
+    if (this.category != 'class')
+      return false;
+    return (this.namespace == 'compilets' && this.name == 'Uint8Array') ||
+           (this.namespace == 'compilets::nodejs' && this.name == 'Buffer');
+  }
+
   /**
    * Whether this type or the types it contains inherit from Object.
    */
@@ -448,6 +513,15 @@ export class FunctionType extends Type {
  */
 export class InterfaceType extends Type {
   properties = new Map<string, Type>;
+  /**
+   * Whether the interface is printed as a plain struct passed by value.
+   */
+  isValueType = false;
+  /**
+   * Whether the interface is used by JSON.parse or JSON.stringify, which
+   * requires a method visiting its properties.
+   */
+  usesJSON = false;
 
   constructor(name: string, modifiers?: TypeModifier[]) {
     super(name, 'interface', modifiers);
@@ -476,9 +550,24 @@ export class InterfaceType extends Type {
   override overwriteWith(other: InterfaceType): this {
     super.overwriteWith(other);
     this.properties = cloneMap(other.properties, (p) => p.clone());
+    this.isValueType = other.isValueType;
+    this.usesJSON = other.usesJSON;
     return this;
   }
 
+  override isObject() {
+    return !this.isValueType;
+  }
+
+  override isTriviallyDestructible() {
+    return this.isValueType &&
+           Array.from(this.properties.values()).every(t => t.isTriviallyDestructible());
+  }
+
+  override isExpensiveToCopy() {
+    return this.isValueType && !this.isTriviallyDestructible();
+  }
+
   override clone(): InterfaceType {
     const newType = new InterfaceType(this.name);
     newType.overwriteWith(this);
@@ -510,14 +599,19 @@ export class InterfaceType extends Type {
     for (const [name, type] of this.properties) {
       members.push(new PropertyDeclaration(name, [ 'abstract' ], type));
     }
-    if (notTriviallyDestructible(members)) {
+    // Value types are never traced by GC.
+    if (!this.isValueType && notTriviallyDestructible(members)) {
       const trace = createTraceMethod(this, members);
       if (trace)
         members.push(trace);
-      members.push(new DestructorDeclaration(this.name, [ 'virtual' ]));
+      // Nothing derives from the generated structs.
+      members.push(new DestructorDeclaration(this.name, []));
     }
+    if (this.usesJSON)
+      members.push(createVisitPropertiesMethod(members));
     // Print.
-    let result = `${ctx.prefix}struct ${this.name} : public compilets::Object {\n`;
+    const base = this.isValueType ? 'compilets::Struct' : 'compilets::Object';
+    let result = `${ctx.prefix}struct ${this.name} final : public ${base} {\n`;
     ctx.level++;
     result += joinArray(
       members,
@@ -564,15 +658,17 @@ export class InterfaceType extends Type {
  */
 export class InterfaceRegistry {
   types: InterfaceType[] = [];
+  // The number in the name of the last registered interface.
+  private lastId = 0;
 
   register(type: InterfaceType): InterfaceType {
     // Find the same interface or save it.
     let existing = this.types.find(t => t.equal(type));
     if (!existing) {
-      const len = this.types.push(type);
+      this.types.push(type);
       // Rename to unique name.
       existing = type;
-      existing.name = `Interface${len}`;
+      existing.name = `Interface${++this.lastId}`;
     }
     // Return a clone as caller may modify type.
     const result = existing.clone();
@@ -587,4 +683,53 @@ export class InterfaceRegistry {
       throw new Error(`Can not find an interface with name of "${name}"`);
     return type;
   }
+
+  /**
+   * Save the interfaces as JSON, or only the ones in `names` when specified.
+   */
+  serialize(names?: Set<string>): string {
+    const types = names ? this.types.filter(t => names.has(t.name)) : this.types;
+    return JSON.stringify(types, (key, value) => {
+      if (value instanceof Map)
+        return {entries: Array.from(value)};
+      if (value instanceof Type)
+        return {class: value.constructor.name, ...value};
+      return value;
+    });
+  }
+
+  /**
+   * Replace the interfaces with the ones saved by serialize, so they keep
+   * their names when new interfaces are registered.
+   *
+   * When `names` is specified, only those interfaces and the ones they refer
+   * to are kept. The usesJSON flags are cleared, and must be set again by the
+   * files converting the interfaces from or to JSON.
+   */
+  restore(json: string, names?: Set<string>) {
+    const classes: Record<string, Function> = {Type, FunctionType, InterfaceType};
+    this.types = JSON.parse(json, (key, value) => {
+      if (value?.class) {
+        const {class: name, ...fields} = value;
+        return Object.assign(Object.create(classes[name].prototype), fields);
+      }
+      if (Array.isArray(value?.entries))
+        return new Map(value.entries);
+      return value;
+    });
+    if (names) {
+      // Keep adding the interfaces referenced by the kept ones.
+      let kept = new Set(names);
+      while (true) {
+        const referenced = new Set(this.serialize(kept).match(/\bInterface\d+\b/g));
+        if (referenced.isSubsetOf(kept))
+          break;
+        kept = kept.union(referenced);
+      }
+      this.types = this.types.filter(t => kept.has(t.name));
+    }
+    for (const type of this.types)
+      type.usesJSON = false;
+    this.lastId = Math.max(0, ...this.types.map(t => Number(t.name.replace('Interface', ''))));
+  }
 }
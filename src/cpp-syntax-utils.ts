@@ -67,6 +67,31 @@ export function createTraceMethod(type: Type, members: ClassElement[]): MethodDe
   return new MethodDeclaration(methodType, 'Trace', [ 'public', 'override', 'const' ], [ visitor ], body);
 }
 
+/**
+ * Create the VisitProperties method passing the name and reference of each
+ * property to the visitor, which is how the JSON runtime reads and writes the
+ * generated interfaces.
+ */
+export function createVisitPropertiesMethod(members: ClassElement[]): MethodDeclaration {
+  const body = new Block();
+  for (const member of members) {
+    if (member instanceof PropertyDeclaration) {
+      body.statements.push(
+        new ExpressionStatement(
+          new RawExpression(Type.createVoidType(),
+                            `visit("${member.name}", self.${member.name})`)));
+    }
+  }
+  // Both parameters are abbreviated templates, so that the method works with
+  // const and non-const structs.
+  const selfType = new Type('auto&', 'external');
+  const visitType = new Type('auto&&', 'external');
+  const self = new ParameterDeclaration('self', selfType);
+  const visit = new ParameterDeclaration('visit', visitType);
+  const methodType = new FunctionType('method', Type.createVoidType(), [ selfType, visitType ]);
+  return new MethodDeclaration(methodType, 'VisitProperties', [ 'public', 'static' ], [ self, visit ], body);
+}
+
 /**
  * Convert the expression of source type to target type if necessary.
  */
@@ -112,12 +137,12 @@ export function castExpression(expr: Expression, target: Type, source?: Type): E
   // We don't support using methods as functors yet.
   if (source.category == 'method' && target.category == 'functor')
     throw new Error('Can not use method as function');
-  // Convert function pointer to functor object.
+  // Convert function pointer to functor object, which is cached per function.
   if (source.category == 'function' && target.category == 'functor') {
     return new CustomExpression(target, (ctx) => {
       ctx.features.add('function');
       const signature = (target as FunctionType).getSignature();
-      return `compilets::MakeFunction<${signature}>(${expr.print(ctx)})`;
+      return `compilets::MakeFunction<${signature}, ${expr.print(ctx)}>()`;
     });
   }
   // Convert between primitive types.
@@ -219,7 +244,7 @@ export function castUnion(expr: Expression, target: Type, source: Type): Express
       throw new Error(`The union "${source.name}" does not contain the target type "${target.name}"`);
     }
     return new CustomExpression(subtype, (ctx) => {
-      return `std::get<${subtype.print(ctx)}>(${expr.print(ctx)})`;
+      return `compilets::Get<${subtype.print(ctx)}>(${expr.print(ctx)})`;
     });
   }
   return expr;
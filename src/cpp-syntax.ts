@@ -11,6 +11,7 @@ import {
   castOptional,
 } from './cpp-syntax-utils';
 import {
+  Feature,
   PrintContext,
   printClassDeclaration,
   printExpressionValue,
@@ -57,12 +58,26 @@ export class NumericLiteral extends RawExpression {
   }
 }
 
-export class StringLiteral extends RawExpression {
+export class BigIntLiteral extends RawExpression {
   constructor(text: string) {
-    super(Type.createStringType(), 'u' + JSON.stringify(text));
+    super(Type.createBigIntType(), text);
+  }
+}
+
+export class StringLiteral extends RawExpression {
+  value: string;
+
+  constructor(value: string) {
+    super(Type.createStringType(), 'u' + JSON.stringify(value));
+    this.value = value;
   }
 }
 
+// Print the interned copy of a string literal, which is created only once.
+function printInternedString(text: string) {
+  return `compilets::InternedString<u${JSON.stringify(text)}>()`;
+}
+
 export class NullKeyword extends RawExpression {
   constructor() {
     super(Type.createNullType(), 'compilets::Null{}');
@@ -91,6 +106,8 @@ export class UndefinedKeyword extends Expression {
 
 export class Identifier extends RawExpression {
   namespace?: string;
+  // The variable is never used after this reference.
+  isLastUse = false;
 
   constructor(type: Type, text: string, namespace?: string) {
     super(type, text);
@@ -102,7 +119,10 @@ export class Identifier extends RawExpression {
     // Add namespace prefix.
     if (this.namespace)
       result = addNamespace(result, this.namespace, ctx);
-    return result + printTypeTemplateArguments(this.type, ctx);
+    result += printTypeTemplateArguments(this.type, ctx);
+    if (this.isLastUse)
+      return `std::move(${result})`;
+    return result;
   }
 }
 
@@ -173,6 +193,21 @@ export class ParenthesizedExpression extends Expression {
   }
 }
 
+// The await in async functions, the awaited promise suspends the coroutine
+// until it is settled.
+export class AwaitExpression extends Expression {
+  expression: Expression;
+
+  constructor(type: Type, expression: Expression) {
+    super(type);
+    this.expression = expression;
+  }
+
+  override print(ctx: PrintContext) {
+    return `co_await ${this.expression.print(ctx)}`;
+  }
+}
+
 export class ExpressionWithTemplateArguments extends Expression {
   expression: Expression;
   templateArguments?: Type[];
@@ -343,6 +378,23 @@ export class ModExpression extends Expression {
   }
 }
 
+// The division of bigint, which checks the divisor.
+export class BigIntDivision extends Expression {
+  left: Expression;
+  right: Expression;
+
+  constructor(left: Expression, right: Expression) {
+    super(Type.createBigIntType());
+    this.left = left;
+    this.right = right;
+  }
+
+  override print(ctx: PrintContext) {
+    ctx.features.add('math');
+    return `compilets::BigIntDivide(${this.left.print(ctx)}, ${this.right.print(ctx)})`;
+  }
+}
+
 export class BinaryExpression extends Expression {
   left: Expression;
   right: Expression;
@@ -377,19 +429,55 @@ export class ArrayLiteralExpression extends Expression {
   }
 }
 
+export class RecordLiteral extends Expression {
+  entries: [ string, Expression ][];
+
+  constructor(type: Type, entries: [ string, Expression ][]) {
+    super(type);
+    const valueType = type.templateArguments![0];
+    this.entries = entries.map(([ key, value ]) => [ key, castExpression(value, valueType) ]);
+  }
+
+  override print(ctx: PrintContext) {
+    ctx.features.add('record');
+    const valueType = printTypeName(this.type.templateArguments![0], ctx);
+    const entries = this.entries.map(([ key, value ]) => `{${printInternedString(key)}, ${value.print(ctx)}}`).join(', ');
+    return `compilets::MakeRecord<${valueType}>({${entries}})`;
+  }
+}
+
+// How the lambda captures an outer variable:
+// * value: copy the variable into the lambda;
+// * reference: refer to the variable, the lambda must not outlive it;
+// * cell: refer to the variable stored in a GC cell owned by the closure.
+export type CaptureMode = 'value' | 'reference' | 'cell';
+
+export interface Capture {
+  name: string;
+  mode: CaptureMode;
+  // Also capture the cell pointer for the nested lambdas.
+  forwardCell: boolean;
+}
+
 export class FunctionExpression extends Expression {
   returnType: Type;
   parameters: ParameterDeclaration[];
+  captures: Capture[];
   closure: Expression[];
   body?: Block;
+  // Create the function object with its concrete type instead of the base
+  // Function type, so calls through it do not go through the function pointer.
+  isKnownType = false;
 
   constructor(type: FunctionType,
               parameters: ParameterDeclaration[],
+              captures: Capture[],
               closure: Expression[],
               body?: Block) {
     super(type);
     this.returnType = type.returnType;
     this.parameters = parameters;
+    this.captures = captures;
     this.closure = closure.map(expr => {
       if (expr.type.isObject())
         return expr;
@@ -401,6 +489,11 @@ export class FunctionExpression extends Expression {
       }
       throw new Error(`Can not store type "${expr.type.name}" as closure`);
     });
+    // The closure keeps the cells alive.
+    for (const {name, mode} of captures) {
+      if (mode == 'cell')
+        this.closure.push(new CustomExpression(new Type('Object', 'class'), (ctx) => `_${name}_cell`));
+    }
     this.body = body;
     this.shouldAddParenthesesForPropertyAccess = true;
   }
@@ -411,9 +504,21 @@ export class FunctionExpression extends Expression {
     const fullParameters = ParameterDeclaration.printParameters(ctx, this.parameters);
     const shortParameters = this.parameters.map(p => p.type.print(ctx)).join(', ');
     const body = this.body?.print(ctx) ?? '{}';
-    const lambda = `[=](${fullParameters}) -> ${returnType} ${body}`;
+    const captures = this.captures.map(({name, mode, forwardCell}) => {
+      const cell = `_${name}_cell`;
+      const result = forwardCell ? [ cell ] : [];
+      if (mode == 'cell')
+        result.push(`&${name} = ${cell}->value`);
+      else if (mode == 'reference')
+        result.push(`&${name}`);
+      else
+        result.push(name);
+      return result;
+    }).flat();
+    const lambda = `[${captures.join(', ')}](${fullParameters}) -> ${returnType} ${body}`;
     const closure = this.closure.map(c => c.print(ctx));
-    return `compilets::MakeFunction<${returnType}(${shortParameters})>(${[ lambda, ...closure ].join(', ')})`;
+    const helper = this.isKnownType ? 'MakeFunctionImpl' : 'MakeFunction';
+    return `compilets::${helper}<${returnType}(${shortParameters})>(${[ lambda, ...closure ].join(', ')})`;
   }
 }
 
@@ -455,16 +560,16 @@ export class MethodCallExpression extends CallExpression {
   }
 
   override print(ctx: PrintContext) {
-    const {expression, member} = this.callee as PropertyAccessExpression;
+    const {expression, member, commonBase} = this.callee as PropertyAccessExpression;
     expression.type.markUsed(ctx);
-    if (expression.type.isObject() || expression.type.category == 'string')
+    if (expression.type.isObject() || expression.type.category == 'string' || commonBase)
       return super.print(ctx);
     if (expression.type.category == 'namespace')
       return `${printTypeName(expression.type, ctx)}::${member}(${this.args.print(ctx)})`;
     if (expression.type.category == 'union') {
-      // Accessing union's method with std::visit.
+      // Accessing union's method with compilets::Visit.
       const returnType = (this.callee.type as FunctionType).returnType.print(ctx);
-      return `std::visit([&](auto&& _obj) -> ${returnType} { return _obj->${member}(${this.args.print(ctx)}); }, ${expression.print(ctx)})`;
+      return `compilets::Visit([&](auto&& _obj) -> ${returnType} { return _obj->${member}(${this.args.print(ctx)}); }, ${expression.print(ctx)})`;
     }
     throw new Error(`Unable to print method call for unsupported type ${expression.type.name}`);
   }
@@ -472,6 +577,11 @@ export class MethodCallExpression extends CallExpression {
 
 export class NewExpression extends Expression {
   args: CallArguments;
+  /**
+   * Name of the stack variable holding the object, set when the object does
+   * not escape its function.
+   */
+  storage?: string;
 
   constructor(type: Type, args: CallArguments) {
     super(type);
@@ -479,12 +589,25 @@ export class NewExpression extends Expression {
   }
 
   override print(ctx: PrintContext) {
+    if (this.storage)
+      return `&${this.storage}`;
     const args = this.args.print(ctx);
     if (this.type.isObject())
       return `compilets::MakeObject<${printTypeName(this.type, ctx)}>(${args})`;
+    else if (this.type.category == 'interface')
+      return `${printTypeName(this.type, ctx)}(${args})`;
     else
       return `new ${printTypeName(this.type, ctx)}(${args})`;
   }
+
+  /**
+   * Print the declaration of the stack variable.
+   */
+  printStorage(ctx: PrintContext) {
+    const args = this.args.print(ctx);
+    const type = printTypeName(this.type, ctx);
+    return args ? `${type} ${this.storage}(${args})` : `${type} ${this.storage}`;
+  }
 }
 
 export class ObjectLiteral extends NewExpression {
@@ -526,6 +649,10 @@ export class BaseResolutionExpression extends Expression {
 export class PropertyAccessExpression extends Expression {
   expression: Expression;
   member: string;
+  /**
+   * The class that all types of a union derive from and declares the member.
+   */
+  commonBase?: Type;
 
   constructor(type: Type, expression: Expression, member: string) {
     super(type);
@@ -540,11 +667,17 @@ export class PropertyAccessExpression extends Expression {
     // Accessing a type's property means we must know the type's declaration.
     const {type} = this.expression;
     type.markUsed(ctx);
-    // Accessing union's property requires using std::visit.
+    // The member declared by a common base is accessed via the base pointer.
+    if (type.category == 'union' && this.commonBase) {
+      this.commonBase.markUsed(ctx);
+      const base = printTypeName(this.commonBase, ctx);
+      return `static_cast<${base}*>(${printExpressionValue(this.expression, ctx)}.GetObject())->${this.member}`;
+    }
+    // Accessing union's property requires using compilets::Visit.
     if (type.category == 'union') {
       const expression = this.expression.print(ctx);
       const returnType = this.type.print(ctx);
-      return `std::visit([](auto&& _obj) -> ${returnType} { return _obj->${this.member}; }, ${expression})`;
+      return `compilets::Visit([](auto&& _obj) -> ${returnType} { return _obj->${this.member}; }, ${expression})`;
     }
     // For other types things fallback to usual C++ property access.
     let dot: string;
@@ -570,22 +703,72 @@ export class PropertyAccessExpression extends Expression {
   }
 }
 
+// Accessing the elements of arrays and strings. The elements of byte arrays
+// are accessed with checked methods, which take the index as double so
+// invalid indices can be detected, and get() is used unless the element is
+// being assigned to.
 export class ElementAccessExpression extends Expression {
   expression: Expression;
   arg: Expression;
+  isAssignmentTarget: boolean;
 
-  constructor(type: Type, expression: Expression, arg: Expression) {
+  constructor(type: Type, expression: Expression, arg: Expression, isAssignmentTarget = false) {
     super(type);
     if (expression instanceof StringLiteral)
       this.expression = new ToStringExpression(expression);
     else
       this.expression = castExpression(expression, expression.type);
-    this.arg = castExpression(arg, new Type('size_t', 'primitive'));
+    const isByteArray = this.expression.type.isByteArray();
+    this.arg = castExpression(arg, isByteArray ? Type.createNumberType() : new Type('size_t', 'primitive'));
+    this.isAssignmentTarget = isAssignmentTarget;
+  }
+
+  override print(ctx: PrintContext) {
+    const {type} = this.expression;
+    const obj = printExpressionValue(this.expression, ctx);
+    if (type.isByteArray() && !this.isAssignmentTarget)
+      return `${obj}->value().get(${this.arg.print(ctx)})`;
+    const accessor = type.category == 'array' || type.isByteArray() ? '->value()' : '';
+    return `${obj}${accessor}[${this.arg.print(ctx)}]`;
+  }
+}
+
+// Accessing the properties of a record, which also implements the in and
+// delete operators. Reading a missing property must not add it, so get() is
+// used unless the property is being assigned to. Literal keys are printed as
+// interned strings, which are hashed once and compared by pointer.
+export type RecordMethod = 'get' | 'at' | 'has' | 'erase';
+export class RecordAccessExpression extends Expression {
+  expression: Expression;
+  key: Expression;
+  method: RecordMethod;
+
+  constructor(type: Type, expression: Expression, key: Expression, method: RecordMethod) {
+    super(type);
+    this.expression = expression;
+    this.key = key;
+    this.method = method;
   }
 
   override print(ctx: PrintContext) {
-    const accessor = this.expression.type.category == 'array' ? '->value()' : '';
-    return `${printExpressionValue(this.expression, ctx)}${accessor}[${this.arg.print(ctx)}]`;
+    const key = this.key instanceof StringLiteral ? printInternedString(this.key.value)
+                                                  : this.key.print(ctx);
+    return `${printExpressionValue(this.expression, ctx)}->${this.method}(${key})`;
+  }
+}
+
+// The object created by the expression is freed when the allocation scope of
+// the block ends.
+export class ScopedAllocation extends Expression {
+  expression: Expression;
+
+  constructor(expression: Expression) {
+    super(expression.type);
+    this.expression = expression;
+  }
+
+  override print(ctx: PrintContext) {
+    return `allocation_scope.Track(${this.expression.print(ctx)})`;
   }
 }
 
@@ -608,6 +791,8 @@ export class CustomExpression extends Expression {
 export class ImportDeclaration {
   fileName: string;
   namespace: string;
+  // The builtin modules like node:fs are provided by runtime headers.
+  feature?: Feature;
   namespaceAlias?: string;
   names?: string[];
   aliases?: [string, string][];
@@ -641,6 +826,10 @@ export class VariableDeclaration extends Declaration {
   identifier: string;
   type: Type;
   initializer?: Expression;
+  // The variable is a reference to the value of a GC cell shared with closures.
+  isSharedCell = false;
+  // The variable holds a function object of known concrete type.
+  isKnownFunction = false;
 
   constructor(identifier: string, type: Type, initializer?: Expression) {
     super();
@@ -657,13 +846,26 @@ export class VariableDeclaration extends Declaration {
     }
   }
 
+  printType(ctx: PrintContext) {
+    return this.isKnownFunction ? 'auto*' : this.type.print(ctx);
+  }
+
   override print(ctx: PrintContext) {
     this.type.markUsed(ctx);
+    if (this.isSharedCell)
+      return `&${this.identifier} = _${this.identifier}_cell->value`;
     if (this.initializer)
       return `${this.identifier} = ${this.initializer.print(ctx)}`;
     else
       return this.identifier;
   }
+
+  printCell(ctx: PrintContext) {
+    ctx.features.add('function');
+    const type = `compilets::Cell<${this.type.print(ctx)}>`;
+    const initializer = this.initializer?.print(ctx) ?? '';
+    return `${type}* _${this.identifier}_cell = compilets::MakeObject<${type}>(${initializer})`;
+  }
 }
 
 export class VariableDeclarationList extends Declaration {
@@ -675,7 +877,7 @@ export class VariableDeclarationList extends Declaration {
   }
 
   override print(ctx: PrintContext) {
-    const type = this.declarations[0].type.print(ctx);
+    const type = this.declarations[0].printType(ctx);
     return `${type} ${this.declarations.map(d => d.print(ctx)).join(', ')}`;
   }
 }
@@ -692,6 +894,10 @@ export abstract class NamedDeclaration extends Declaration {
 export class ParameterDeclaration extends NamedDeclaration {
   type: Type;
   initializer?: Expression;
+  isReadOnly = false;
+  // The parameter is copied into a GC cell shared with closures, and the
+  // variable of the function body refers to the cell's value.
+  isSharedCell = false;
 
   constructor(name: string, type: Type, initializer?: Expression) {
     super(name);
@@ -701,12 +907,34 @@ export class ParameterDeclaration extends NamedDeclaration {
   }
 
   override print(ctx: PrintContext) {
-    let result = `${this.type.print(ctx)} ${this.name}`;
+    let result: string;
+    const name = this.isSharedCell ? `_${this.name}_param` : this.name;
+    // Avoid copying parameters that are never assigned.
+    if (this.isReadOnly && this.type.isExpensiveToCopy())
+      result = `const ${this.type.print(ctx)}& ${name}`;
+    else
+      result = `${this.type.print(ctx)} ${name}`;
     if (this.initializer)
       result += ` = ${this.initializer.print(ctx)}`;
     return result;
   }
 
+  /**
+   * Return the statements declaring the cells of parameters, which are put at
+   * the beginning of function body.
+   */
+  static createCells(parameters: ParameterDeclaration[]): Statement[] {
+    return parameters.filter(p => p.isSharedCell).map(p => {
+      // Like captured variables the cell stores objects in Member, so they
+      // are traced.
+      const type = p.type.clone();
+      type.isProperty = true;
+      const declaration = new VariableDeclaration(p.name, type, new RawExpression(p.type, `_${p.name}_param`));
+      declaration.isSharedCell = true;
+      return new VariableStatement(new VariableDeclarationList([ declaration ]));
+    });
+  }
+
   static printParameters(ctx: PrintContext, parameters: ParameterDeclaration[]) {
     if (parameters.length > 0)
       return parameters.map(p => p.print(ctx)).join(', ');
@@ -904,9 +1132,11 @@ export class ClassDeclaration extends DeclarationStatement {
   protectedMembers: ClassElement[] = [];
   privateMembers: ClassElement[] = [];
   destructor?: ClassElement;
+  isFinal: boolean;
 
-  constructor(type: Type, isExported: boolean, members: ClassElement[]) {
+  constructor(type: Type, isExported: boolean, members: ClassElement[], isFinal = false) {
     super(type, type.name, isExported);
+    this.isFinal = isFinal;
     for (const member of members) {
       if (member.modifiers.includes('private'))
         this.privateMembers.push(member);
@@ -922,8 +1152,8 @@ export class ClassDeclaration extends DeclarationStatement {
         trace.classDeclaration = this;
         this.publicMembers.push(trace);
       }
-      // Add a virtual destructor.
-      const destructor = new DestructorDeclaration(this.name, [ 'virtual' ]);
+      // Add a destructor, which is virtual unless the class is final.
+      const destructor = new DestructorDeclaration(this.name, isFinal ? [] : [ 'virtual' ]);
       destructor.classDeclaration = this;
       this.publicMembers.push(destructor);
     }
@@ -981,7 +1211,22 @@ export class VariableStatement extends DeclarationStatement {
   }
 
   override print(ctx: PrintContext) {
-    return `${ctx.prefix}${this.declarationList.print(ctx)};`;
+    const {declarations} = this.declarationList;
+    const hasStorage = (d: VariableDeclaration) => d.isSharedCell || (d.initializer instanceof NewExpression && !!d.initializer.storage);
+    if (!declarations.some(hasStorage))
+      return `${ctx.prefix}${this.declarationList.print(ctx)};`;
+    // Declare the stack objects and cells right before the variables pointing
+    // to them. As an initializer may use the variables declared before it, the
+    // declarators are split into separate statements.
+    return ctx.prefix + declarations.map((declaration) => {
+      let result = '';
+      const {initializer} = declaration;
+      if (initializer instanceof NewExpression && initializer.storage)
+        result += `${initializer.printStorage(ctx)};\n${ctx.padding}`;
+      if (declaration.isSharedCell)
+        result += `${declaration.printCell(ctx)};\n${ctx.padding}`;
+      return result + `${declaration.printType(ctx)} ${declaration.print(ctx)};`;
+    }).join(`\n${ctx.padding}`);
   }
 }
 
@@ -1004,7 +1249,12 @@ export class Paragraph<T extends Statement> extends Statement {
         return '\n\n';
       else
         return '\n';
-    }, (s) => s.print(ctx));
+    }, (s) => {
+      // Block does not print its own indentation.
+      if (s instanceof Block)
+        return ctx.prefix + s.print(ctx);
+      return s.print(ctx);
+    });
   }
 
   filter(callback: (value: T) => boolean) {
@@ -1027,6 +1277,13 @@ export class Block extends Paragraph<Statement> {
   }
 }
 
+export class AllocationScopeDeclaration extends Statement {
+  override print(ctx: PrintContext) {
+    ctx.features.add('allocation-scope');
+    return `${ctx.prefix}compilets::AllocationScope allocation_scope;`;
+  }
+}
+
 export class ExpressionStatement extends Statement {
   expression: Expression;
 
@@ -1114,8 +1371,81 @@ export class ForStatement extends Statement {
   }
 }
 
+// The for...of loop, which is lowered to plain C++ loops so no iterator object
+// is created: arrays are walked by index, and strings, maps, sets and
+// generators with the C++ iterators of their runtime types.
+export type ForOfKind = 'array' | 'string' | 'set' | 'map' | 'generator' | 'readline';
+export class ForOfStatement extends Statement {
+  kind: ForOfKind;
+  expression: Expression;
+  statement: Statement;
+  // The loop variables, and for maps the key and value.
+  declarations: VariableDeclaration[];
+  // The index of array, or the entry of map and set.
+  iterator: string;
+  // The body can not change the array length, so it is only read once.
+  isFixedLength = false;
+
+  constructor(kind: ForOfKind,
+              names: string[],
+              types: Type[],
+              expression: Expression,
+              statement: Statement) {
+    super();
+    this.kind = kind;
+    this.expression = castExpression(expression, expression.type);
+    this.statement = statement;
+    const iterator = this.iterator = `_${names[0]}_${kind == 'array' ? 'i' : 'entry'}`;
+    if (kind == 'array') {
+      const index = new RawExpression(new Type('size_t', 'primitive'), iterator);
+      this.declarations = [ new VariableDeclaration(names[0], types[0], new ElementAccessExpression(types[0], this.expression, index)) ];
+    } else if (kind == 'map') {
+      this.declarations = [ new VariableDeclaration(names[0], types[0], new RawExpression(types[0], `${iterator}.key`)),
+                            new VariableDeclaration(names[1], types[1], new RawExpression(types[1], `${iterator}.value`)) ];
+    } else if (kind == 'set') {
+      this.declarations = [ new VariableDeclaration(names[0], types[0], new RawExpression(types[0], `${iterator}.key`)) ];
+    } else {
+      this.declarations = [ new VariableDeclaration(names[0], types[0]) ];
+    }
+  }
+
+  override print(ctx: PrintContext) {
+    const expression = printExpressionValue(this.expression, ctx);
+    const [ first ] = this.declarations;
+    let header: string;
+    let declarations = this.declarations;
+    if (this.kind == 'array') {
+      const i = this.iterator;
+      if (this.isFixedLength)
+        header = `size_t ${i} = 0, _${first.identifier}_length = ${expression}->value().size(); ${i} < _${first.identifier}_length; ++${i}`;
+      else
+        header = `size_t ${i} = 0; ${i} < ${expression}->value().size(); ++${i}`;
+    } else if (this.kind == 'string' || this.kind == 'generator' || this.kind == 'readline') {
+      // Strings yield the code points, generators resume the coroutine and
+      // readline interfaces read a line in each step, the values are assigned
+      // to the loop variable directly.
+      first.type.markUsed(ctx);
+      const range = this.kind == 'string' ? expression : `*${expression}`;
+      header = `${first.type.print(ctx)} ${first.identifier} : ${range}`;
+      declarations = [];
+    } else {
+      header = `const auto& ${this.iterator} : *${expression}`;
+    }
+    // Declare the loop variables at the beginning of the loop body.
+    const statements: Statement[] = declarations.map(d => new VariableStatement(new VariableDeclarationList([ d ])));
+    if (this.statement instanceof Block)
+      statements.push(...this.statement.statements);
+    else
+      statements.push(this.statement);
+    return `${ctx.prefix}for (${header}) ${new Block(statements).print(ctx)}`;
+  }
+}
+
 export class ReturnStatement extends Statement {
   expression?: Expression;
+  // Returning from generators and async functions, which are coroutines in
+  // C++.
+  isCoroutine = false;
 
   constructor(expression?: Expression, target?: Type) {
     super();
@@ -1124,22 +1454,48 @@ export class ReturnStatement extends Statement {
   }
 
   override print(ctx: PrintContext) {
+    const keyword = this.isCoroutine ? 'co_return' : 'return';
     if (this.expression)
-      return `${ctx.prefix}return ${this.expression.print(ctx)};`;
+      return `${ctx.prefix}${keyword} ${this.expression.print(ctx)};`;
+    else
+      return `${ctx.prefix}${keyword};`;
+  }
+}
+
+// The yield in generators, or yield* which yields all values of another
+// generator.
+export class YieldStatement extends Statement {
+  expression: Expression;
+  isDelegate: boolean;
+
+  constructor(expression: Expression, yieldType: Type, isDelegate = false) {
+    super();
+    this.isDelegate = isDelegate;
+    if (isDelegate)
+      this.expression = castExpression(expression, expression.type);
     else
-      return `${ctx.prefix}return;`;
+      this.expression = castExpression(expression, yieldType);
+  }
+
+  override print(ctx: PrintContext) {
+    if (this.isDelegate)
+      return `${ctx.prefix}for (const auto& _value : *${printExpressionValue(this.expression, ctx)}) co_yield _value;`;
+    return `${ctx.prefix}co_yield ${this.expression.print(ctx)};`;
   }
 }
 
 // A special declaration for putting the top-level statements of the entry
 // script into the "main" function.
 export class MainFunction extends FunctionDeclaration {
+  // Number of the generated statements after the top-level statements.
+  epilogueLength = 1;
+
   addStatement(...statement: Statement[]) {
-    this.body!.statements.splice(this.body!.statements.length - 1, 0, ...statement);
+    this.body!.statements.splice(this.body!.statements.length - this.epilogueLength, 0, ...statement);
   }
 
   isEmpty() {
-    return this.body!.statements.length <= 2;
+    return this.body!.statements.length <= 1 + this.epilogueLength;
   }
 }
 
@@ -1148,9 +1504,11 @@ export class MainFunctionExe extends MainFunction {
     const intType = new Type('int', 'primitive');
     const argvType = new Type('const char**', 'external');
     const body = new Block([
-      new VariableStatement(new VariableDeclarationList([
-        new VariableDeclaration('_state', new Type('compilets::StateExe', 'external')),
-      ])),
+      // The state is constructed with the arguments for process.argv.
+      new ExpressionStatement(new RawExpression(Type.createVoidType(), 'compilets::StateExe _state(argc, argv)')),
+      // Timers and promises created by the top-level statements keep running
+      // until the event loop has nothing left to do.
+      new ExpressionStatement(new RawExpression(Type.createVoidType(), '_state.RunEventLoop()')),
       new ReturnStatement(new RawExpression(intType, '0')),
     ]);
     super(new FunctionType('function', intType, [ intType, argvType ]),
@@ -1159,6 +1517,7 @@ export class MainFunctionExe extends MainFunction {
           [ new ParameterDeclaration('argc', intType),
             new ParameterDeclaration('argv', argvType) ],
           body);
+    this.epilogueLength = 2;
   }
 }
 
@@ -14,6 +14,7 @@ interface CommonGnOptions {
 
 export interface GnGenOptions extends CommonGnOptions {
   ccWrapper?: string;
+  allocationProfiler?: boolean;
 }
 
 export interface NinjaBuildOptions extends CommonGnOptions {
@@ -34,6 +35,8 @@ export async function gnGen(targetDir: string, options: GnGenOptions) {
   ];
   if (process.platform == 'win32')
     args.push('is_clang=true', 'clang_use_chrome_plugins=false');
+  if (options.allocationProfiler)
+    args.push('compilets_allocation_profiler=true');
   if (options.ccWrapper)
     args.push(`cc_wrapper="${options.ccWrapper}"`);
   else if (hasCcache())
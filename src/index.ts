@@ -1,20 +1,99 @@
 import path from 'node:path';
+import * as ts from 'typescript';
 import CppFile from './cpp-file';
 import CppProject from './cpp-project';
 import Parser from './parser';
-import {GnGenOptions, gnGen} from './gn-utils';
+import TranslationCache from './translation-cache';
+import {GnGenOptions, gnGen, ninjaBuild} from './gn-utils';
 
-export {CppFile, CppProject, Parser};
+export {CppFile, CppProject, Parser, TranslationCache};
 export * from './gn-utils';
 
 /**
  * Create a project from `root`, parser it and generate build files to `target`.
+ *
+ * The translations are cached under the "out" directory of `target`, and only
+ * the changed files and the files depending on them are translated again in
+ * next generation.
  */
 export async function generateCppProject(root: string,
                                          target: string,
                                          options?: GnGenOptions): Promise<CppProject> {
+  const project = createProject(root);
+  project.cache = new TranslationCache(project, getCacheDir(target));
+  const parser = new Parser(project);
+  parser.parse();
+  await project.writeTo(target);
+  await gnGen(target, {...options, config: options?.config ?? 'Release'});
+  return project;
+}
+
+/**
+ * Generate and build the project, and then keep translating and building the
+ * changed files until the returned watcher is closed.
+ *
+ * The TypeScript program is updated incrementally by the watcher, only the
+ * changed files and the files depending on them are translated again, and
+ * only the targets using changed C++ files are rebuilt.
+ */
+export function watchCppProject(root: string,
+                                target: string,
+                                options?: GnGenOptions) {
+  const config = options?.config ?? 'Release';
+  const cacheDir = getCacheDir(target);
+  // The root files are fixed, adding files requires restarting the watcher.
+  const initialProject = createProject(root);
+  const {fileNames} = initialProject;
+  const compilerOptions = new TranslationCache(initialProject, cacheDir).getCompilerOptions();
+  // The build directory is created by the first successful generation, after
+  // which ninja runs "gn gen" by itself if the GN files have changed.
+  let hasBuildDir = false;
+  const generate = async (builder: ts.EmitAndSemanticDiagnosticsBuilderProgram) => {
+    const project = createProject(root);
+    project.cache = new TranslationCache(project, cacheDir, builder);
+    const parser = new Parser(project);
+    parser.parse();
+    const changedFiles = await project.writeTo(target, {copyDependencies: !hasBuildDir});
+    let targets = project.getTargetsOfFiles(changedFiles);
+    if (!hasBuildDir) {
+      await gnGen(target, {...options, config});
+      hasBuildDir = true;
+      targets = [ 'default' ];
+    }
+    if (targets.length > 0)
+      await ninjaBuild(target, {config, stream: options?.stream, targets});
+  };
+  // Generations are serialized, and a program is skipped if there is a newer
+  // one waiting.
+  let queue = Promise.resolve();
+  let latest: ts.EmitAndSemanticDiagnosticsBuilderProgram | undefined;
+  const reportWatchStatus = (diagnostic: ts.Diagnostic) => {
+    console.log(ts.flattenDiagnosticMessageText(diagnostic.messageText, '\n'));
+  };
+  const host = ts.createWatchCompilerHost(fileNames,
+                                          compilerOptions,
+                                          ts.sys,
+                                          ts.createEmitAndSemanticDiagnosticsBuilderProgram,
+                                          undefined,
+                                          reportWatchStatus);
+  host.afterProgramCreate = (builder) => {
+    latest = builder;
+    queue = queue.then(async () => {
+      if (builder != latest)
+        return;
+      try {
+        await generate(builder);
+      } catch (error) {
+        console.error(error instanceof Error ? error.message : error);
+      }
+    });
+  };
+  return ts.createWatchProgram(host);
+}
+
+// Create the project with an executable always generated.
+function createProject(root: string): CppProject {
   const project = new CppProject(root);
-  // Make sure an executable is always generated.
   if (!project.mainFileName && !project.executables) {
     if (project.fileNames.length > 1)
       throw new Error('The directory has multiple files and does not specify a main file');
@@ -22,9 +101,10 @@ export async function generateCppProject(root: string,
       [project.name]: path.relative(project.rootDir, project.fileNames[0]),
     };
   }
-  const parser = new Parser(project);
-  parser.parse();
-  await project.writeTo(target);
-  await gnGen(target, {config: options?.config ?? 'Release', stream: options?.stream});
   return project;
 }
+
+// The translations are cached in the build directory.
+function getCacheDir(target: string): string {
+  return `${target}/out/compilets-cache`;
+}
@@ -14,6 +14,16 @@ import {
   isModuleImports,
   isNodeJsType,
   isBuiltinInterfaceType,
+  isBuiltinCollectionType,
+  isBuiltinByteArrayType,
+  isBuiltinArrayBufferLikeType,
+  isBuiltinGeneratorType,
+  isBuiltinPromiseType,
+  isBuiltinPromiseLikeType,
+  isBuiltinLibDeclaration,
+  isNodeJsDeclaration,
+  isNodeJsModuleDeclaration,
+  isCoroutineFunction,
   isGlobalVariable,
   isConstructor,
   FunctionLikeNode,
@@ -23,6 +33,9 @@ import {
   isInterface,
   filterNode,
   parseHint,
+  isAllocationScope,
+  isOnlyElementAccess,
+  isAssignmentTarget,
   mergeTypes,
 } from './parser-utils';
 import {
@@ -30,6 +43,16 @@ import {
   createMapFromArray,
 } from './js-utils';
 
+/**
+ * How an outer variable is captured by the lambda of function expression.
+ */
+export interface ClosureCapture {
+  node: ts.Identifier | ts.ThisExpression;
+  mode: syntax.CaptureMode;
+  // Also capture the cell pointer for the nested functions.
+  forwardCell: boolean;
+}
+
 /**
  * Utilities around the TypeChecker of typescript.
  */
@@ -37,6 +60,30 @@ export default class Typer {
   project: CppProject;
   typeChecker: ts.TypeChecker;
   interfaceRegistry = new syntax.InterfaceRegistry();
+  /**
+   * Signatures of interfaces whose objects are mutated or compared somewhere
+   * in the program, they must keep reference semantics.
+   */
+  referenceInterfaces = new Set<string>();
+  /**
+   * Names of the interfaces converted from or to JSON by each source file,
+   * which the translation cache restores for the files it reuses.
+   */
+  jsonInterfaces = new Map<string, Set<string>>();
+  /**
+   * Classes that are extended by other classes in the program.
+   */
+  subclassedClasses = new Set<ts.ClassDeclaration>();
+  /**
+   * Methods that are overridden by derived classes, and the methods that
+   * override them.
+   */
+  overriddenMethods = new Set<ts.MethodDeclaration>();
+  overridingMethods = new Set<ts.MethodDeclaration>();
+  /**
+   * Cached results of needsSharedCell.
+   */
+  private sharedCellCache = new Map<ts.VariableDeclaration | ts.ParameterDeclaration, boolean>();
 
   constructor(project: CppProject, typeChecker: ts.TypeChecker) {
     this.project = project;
@@ -107,9 +154,17 @@ export default class Typer {
     // Check Node.js type.
     if (isNodeJsType(type)) {
       const result = this.parseNodeJsType(type, location);
-      if (result)
+      if (result) {
+        // Like other objects, they must be kept alive in coroutine frames.
+        if (result.isObject() && modifiers?.includes('persistent'))
+          result.isPersistent = true;
         return result;
+      }
     }
+    // Check ArrayBuffer and Uint8Array, which must be done before checking
+    // unions as ArrayBufferLike is a union.
+    if (isBuiltinByteArrayType(type) || isBuiltinArrayBufferLikeType(type))
+      return this.parseByteArrayType(type, modifiers);
     // Check literals.
     if (type.isNumberLiteral())
       return syntax.Type.createNumberType(modifiers);
@@ -136,17 +191,31 @@ export default class Typer {
       return syntax.Type.createNumberType(modifiers);
     if (flags & (ts.TypeFlags.String | ts.TypeFlags.StringLiteral))
       return syntax.Type.createStringType(modifiers);
+    if (flags & (ts.TypeFlags.BigInt | ts.TypeFlags.BigIntLiteral))
+      return syntax.Type.createBigIntType(modifiers);
     if (flags & (ts.TypeFlags.Any | ts.TypeFlags.Unknown))
       return new syntax.Type(name, 'any', modifiers);
     // Check array.
     if (this.typeChecker.isArrayType(type))
       return this.parseArrayType(name, type as ts.TypeReference, location, modifiers);
+    // Check objects used as dictionaries.
+    if (this.isRecordType(type))
+      return this.parseRecordType(type, location, modifiers);
     // Check the namespace import and builtin interfaces like Math/Number.
     if (isModuleImports(type) || isBuiltinInterfaceType(type)) {
       const cppType = new syntax.Type(type.symbol.name, 'namespace');
       cppType.namespace = this.getTypeNamespace(type);
       return cppType;
     }
+    // Check builtin Map and Set.
+    if (isBuiltinCollectionType(type))
+      return this.parseCollectionType(type, location, modifiers);
+    // Check the objects returned by generator functions.
+    if (isBuiltinGeneratorType(type))
+      return this.parseGeneratorType(type, location, modifiers);
+    // Check the promises returned by async functions.
+    if (isBuiltinPromiseType(type))
+      return this.parsePromiseType(type, location, modifiers);
     // Check class.
     if (isClass(type) || isConstructor(type))
       return this.parseClassType(type, location, modifiers);
@@ -212,8 +281,9 @@ export default class Typer {
    */
   parseSignatureParameters(parameters: readonly ts.Symbol[], location: ts.Node): syntax.Type[] {
     return parameters.map((parameter) => {
-      // Get the modifiers from the original declaration.
-      const modifiers = this.getTypeModifiers(parameter.valueDeclaration);
+      // Get the modifiers from the original declaration, the cells of
+      // parameters are internal to the function and callers pass plain values.
+      const modifiers = this.getTypeModifiers(parameter.valueDeclaration).filter(m => m != 'property');
       // Inference the type using the symbol and call site.
       return this.parseSymbolType(parameter, location, modifiers);
     });
@@ -253,9 +323,171 @@ export default class Typer {
       const type = this.parseSymbolType(p, location, [ 'property' ]);
       return [ p.name, type ];
     });
+    // Interfaces of only primitive members can be copied as values, when the
+    // program can not tell the copy from the original.
+    cppType.isValueType =
+      Array.from(cppType.properties.values()).every(t => !t.isOptional &&
+                                                        (t.category == 'primitive' ||
+                                                         t.category == 'string')) &&
+      !this.referenceInterfaces.has(this.getInterfaceSignature(type));
     return this.interfaceRegistry.register(cppType);
   }
 
+  /**
+   * Find out the classes that are extended and the methods that are
+   * overridden in the source files, so the rest can be final and non-virtual.
+   */
+  collectClassHierarchy(sourceFiles: readonly ts.SourceFile[]) {
+    for (const sourceFile of sourceFiles) {
+      for (const node of filterNode(sourceFile, ts.isClassDeclaration, () => false)) {
+        const decl = node as ts.ClassDeclaration;
+        const bases = this.getBaseClassDeclarations(decl);
+        if (bases.length == 0)
+          continue;
+        this.subclassedClasses.add(bases[0]);
+        for (const member of decl.members) {
+          if (!ts.isMethodDeclaration(member) || !ts.isIdentifier(member.name))
+            continue;
+          if (member.modifiers?.some(m => m.kind == ts.SyntaxKind.StaticKeyword))
+            continue;
+          // Find the nearest base class that has the method.
+          const name = member.name.text;
+          for (const base of bases) {
+            const overridden = base.members.find(m => ts.isMethodDeclaration(m) &&
+                                                      ts.isIdentifier(m.name) &&
+                                                      m.name.text == name);
+            if (overridden) {
+              this.overriddenMethods.add(overridden as ts.MethodDeclaration);
+              this.overridingMethods.add(member);
+              break;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Return the declarations of base classes, starting from the direct base.
+   */
+  private getBaseClassDeclarations(decl: ts.ClassDeclaration): ts.ClassDeclaration[] {
+    const results: ts.ClassDeclaration[] = [];
+    const symbol = decl.name ? this.typeChecker.getSymbolAtLocation(decl.name) : undefined;
+    if (!symbol)
+      return results;
+    let type: ts.Type | undefined = this.typeChecker.getDeclaredTypeOfSymbol(symbol);
+    while (true) {
+      type = this.typeChecker.getBaseTypes(type as ts.InterfaceType)[0];
+      const base = type?.symbol?.valueDeclaration;
+      if (!base || !ts.isClassDeclaration(base) || isExternalDeclaration(base))
+        return results;
+      results.push(base);
+      type = this.typeChecker.getDeclaredTypeOfSymbol(type.symbol);
+    }
+  }
+
+  /**
+   * For member access on a union of classes, return the nearest class that all
+   * the alternatives derive from and which declares the member, so it can be
+   * accessed through the base class pointer without visiting the union.
+   */
+  getCommonBaseClass(node: ts.PropertyAccessExpression): ts.ClassDeclaration | undefined {
+    const type = this.typeChecker.getTypeAtLocation(node.expression);
+    if (!type.isUnion())
+      return;
+    let common: ts.ClassDeclaration[] | undefined;
+    for (const alternative of type.types) {
+      const decl = alternative.symbol?.valueDeclaration;
+      if (!decl || !ts.isClassDeclaration(decl) || isExternalDeclaration(decl))
+        return;
+      const chain = [ decl, ...this.getBaseClassDeclarations(decl) ];
+      common = common ? common.filter(c => chain.includes(c)) : chain;
+    }
+    const name = node.name.text;
+    for (const base of common ?? []) {
+      const member = base.members.find(m => m.name &&
+                                            ts.isIdentifier(m.name) &&
+                                            m.name.text == name);
+      if (!member)
+        continue;
+      // Generic classes would need the type arguments of each alternative.
+      if (base.typeParameters)
+        return;
+      // Overridden methods are virtual and dispatch to the right class.
+      if (ts.isMethodDeclaration(member))
+        return base;
+      // A property redeclared by a derived class is a different field in C++.
+      const symbol = this.typeChecker.getSymbolAtLocation(node.name);
+      if (symbol?.declarations?.every(d => d == member))
+        return base;
+      return;
+    }
+  }
+
+  /**
+   * Find out the interfaces whose objects are mutated or compared in the
+   * source files, which means the program relies on their identities.
+   */
+  collectReferenceInterfaces(sourceFiles: readonly ts.SourceFile[]) {
+    for (const sourceFile of sourceFiles) {
+      for (const signature of this.getReferenceInterfaces(sourceFile))
+        this.referenceInterfaces.add(signature);
+    }
+  }
+
+  /**
+   * Return the signatures of reference interfaces found in a source file.
+   */
+  getReferenceInterfaces(sourceFile: ts.SourceFile): Set<string> {
+    const result = new Set<string>();
+    const markType = (node: ts.Expression) => {
+      let type = this.typeChecker.getTypeAtLocation(node);
+      if (type.isTypeParameter())
+        type = this.typeChecker.getBaseConstraintOfType(type) ?? type;
+      for (const t of type.isUnion() ? type.types : [ type ]) {
+        if (isInterface(t) && !isClass(t))
+          result.add(this.getInterfaceSignature(t));
+      }
+    };
+    const markTarget = (node: ts.Expression) => {
+      if (ts.isPropertyAccessExpression(node) || ts.isElementAccessExpression(node))
+        markType(node.expression);
+    };
+    for (const node of filterNode(sourceFile, undefined, () => false)) {
+      if (ts.isBinaryExpression(node)) {
+        const {left, right, operatorToken} = node;
+        switch (operatorToken.kind) {
+          case ts.SyntaxKind.EqualsEqualsToken:
+          case ts.SyntaxKind.EqualsEqualsEqualsToken:
+          case ts.SyntaxKind.ExclamationEqualsToken:
+          case ts.SyntaxKind.ExclamationEqualsEqualsToken:
+            markType(left);
+            markType(right);
+            break;
+          default:
+            if (operatorToken.kind >= ts.SyntaxKind.FirstAssignment &&
+                operatorToken.kind <= ts.SyntaxKind.LastAssignment)
+              markTarget(left);
+        }
+      } else if (ts.isPrefixUnaryExpression(node) || ts.isPostfixUnaryExpression(node)) {
+        if (node.operator == ts.SyntaxKind.PlusPlusToken ||
+            node.operator == ts.SyntaxKind.MinusMinusToken)
+          markTarget(node.operand);
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Return a string identifying the structure of the interface.
+   */
+  private getInterfaceSignature(type: ts.Type): string {
+    return type.getProperties().map((p) => {
+      const propertyType = this.typeChecker.getBaseTypeOfLiteralType(this.typeChecker.getTypeOfSymbol(p));
+      return `${p.name}:${this.typeChecker.typeToString(propertyType)}`;
+    }).sort().join(',');
+  }
+
   /**
    * Parse the union type.
    */
@@ -272,8 +504,15 @@ export default class Typer {
       return syntax.Type.createBooleanType(modifiers);
     // Iterate all subtypes and add unique ones to cppType.
     let hasUndefined = false;
+    let hasPromiseLike = false;
     let cppType = new syntax.Type(name, 'union', modifiers);
     for (const t of union.types) {
+      // The resolve function takes "T | PromiseLike<T>", and only resolving
+      // with values is supported.
+      if (isBuiltinPromiseLikeType(t)) {
+        hasPromiseLike = true;
+        continue;
+      }
       const subtype = this.parseType(t, location, modifiers?.filter(m => m == 'property' || m == 'element'));
       if (subtype.category == 'undefined')
         hasUndefined = true;
@@ -289,6 +528,8 @@ export default class Typer {
     // Make sure optional union type does not have undefined in the subtypes.
     if (cppType.category == 'union' && cppType.isOptional)
       cppType.types = cppType.types.filter(t => t.category != 'undefined');
+    if (hasPromiseLike && cppType.category == 'union' && cppType.types.length == 1)
+      return cppType.types[0];
     return cppType;
   }
 
@@ -305,25 +546,173 @@ export default class Typer {
     return cppType;
   }
 
+  /**
+   * Parse the builtin Map and Set, which are implemented by the runtime.
+   */
+  parseCollectionType(type: ts.TypeReference,
+                      location?: ts.Node,
+                      modifiers?: syntax.TypeModifier[]): syntax.Type {
+    const cppType = new syntax.Type(type.symbol.name, 'class', modifiers);
+    cppType.namespace = 'compilets';
+    cppType.isExternal = true;
+    cppType.templateArguments = this.typeChecker.getTypeArguments(type).map(a => this.parseType(a, location));
+    return cppType;
+  }
+
+  /**
+   * Parse ArrayBuffer and Uint8Array, the SharedArrayBuffer is not supported
+   * and is treated as ArrayBuffer.
+   */
+  parseByteArrayType(type: ts.Type, modifiers?: syntax.TypeModifier[]): syntax.Type {
+    const name = type.isUnion() ? 'ArrayBuffer' : type.symbol.name;
+    const cppType = new syntax.Type(name, 'class', modifiers);
+    cppType.namespace = 'compilets';
+    cppType.isExternal = true;
+    return cppType;
+  }
+
+  /**
+   * Parse Generator<T>, which is implemented by the runtime as a coroutine.
+   */
+  parseGeneratorType(type: ts.TypeReference,
+                     location?: ts.Node,
+                     modifiers?: syntax.TypeModifier[]): syntax.Type {
+    const [ yieldType ] = this.typeChecker.getTypeArguments(type);
+    const cppType = new syntax.Type('Generator', 'class', modifiers);
+    cppType.namespace = 'compilets';
+    cppType.isExternal = true;
+    cppType.templateArguments = [ this.parseType(yieldType, location) ];
+    return cppType;
+  }
+
+  /**
+   * Parse Promise<T>, which is resolved by the coroutines of async functions.
+   */
+  parsePromiseType(type: ts.TypeReference,
+                   location?: ts.Node,
+                   modifiers?: syntax.TypeModifier[]): syntax.Type {
+    const [ valueType ] = this.typeChecker.getTypeArguments(type);
+    const cppType = new syntax.Type('Promise', 'class', modifiers);
+    cppType.namespace = 'compilets';
+    cppType.isExternal = true;
+    cppType.templateArguments = [ this.parseType(valueType, location) ];
+    return cppType;
+  }
+
+  /**
+   * Parse Record<string, T> and {[key: string]: T}, which are implemented by
+   * the runtime as hash maps.
+   */
+  parseRecordType(type: ts.Type,
+                  location?: ts.Node,
+                  modifiers?: syntax.TypeModifier[]): syntax.Type {
+    const cppType = new syntax.Type('Record', 'class', modifiers);
+    cppType.namespace = 'compilets';
+    cppType.isExternal = true;
+    const {type: valueType} = this.typeChecker.getIndexInfoOfType(type, ts.IndexKind.String)!;
+    cppType.templateArguments = [ this.parseType(valueType, location) ];
+    return cppType;
+  }
+
+  /**
+   * Return whether the node refers to the builtin Object.
+   */
+  isObjectConstructor(node: ts.Expression): boolean {
+    if (!ts.isIdentifier(node) || node.text != 'Object')
+      return false;
+    return this.getNodeDeclarations(node)?.some(isBuiltinDeclaration) ?? false;
+  }
+
+  /**
+   * Return whether the node refers to the builtin JSON.
+   */
+  isJSON(node: ts.Expression): boolean {
+    if (!ts.isIdentifier(node) || node.text != 'JSON')
+      return false;
+    return this.getNodeDeclarations(node)?.some(isBuiltinLibDeclaration) ?? false;
+  }
+
+  /**
+   * Return whether the node refers to the builtin Promise.
+   */
+  isPromiseConstructor(node: ts.Expression): boolean {
+    if (!ts.isIdentifier(node) || node.text != 'Promise')
+      return false;
+    return this.getNodeDeclarations(node)?.some(isBuiltinLibDeclaration) ?? false;
+  }
+
+  /**
+   * Return whether the node refers to the timer functions of Node.js.
+   */
+  isTimerFunction(node: ts.Expression): node is ts.Identifier {
+    if (!ts.isIdentifier(node) ||
+        ![ 'setTimeout', 'setInterval', 'clearTimeout', 'clearInterval' ].includes(node.text))
+      return false;
+    return this.getNodeDeclarations(node)?.some(isNodeJsDeclaration) ?? false;
+  }
+
+  /**
+   * Return the name of the builtin module's function that the node refers to,
+   * which can be either "fs.readFileSync" or an imported "readFileSync".
+   */
+  getModuleFunctionName(node: ts.Expression, module: string): string | undefined {
+    const name = ts.isPropertyAccessExpression(node) ? node.name : node;
+    if (!ts.isIdentifier(name))
+      return;
+    const decl = this.getOriginalDeclarations(name)?.[0];
+    if (!decl || !ts.isFunctionDeclaration(decl) || !decl.name || !isNodeJsModuleDeclaration(decl, module))
+      return;
+    return decl.name.text;
+  }
+
+  /**
+   * Return whether the type is an object with only a string index signature.
+   */
+  isRecordType(type: ts.Type): boolean {
+    if (!(type.flags & ts.TypeFlags.Object) || type.getProperties().length > 0)
+      return false;
+    if (type.getCallSignatures().length > 0 || type.getConstructSignatures().length > 0)
+      return false;
+    return this.typeChecker.getIndexInfoOfType(type, ts.IndexKind.String) != undefined;
+  }
+
   /**
    * Return a proper type representation for Node.js objects.
    */
   parseNodeJsType(type: ts.Type, location?: ts.Node): syntax.Type | undefined {
     let result: syntax.Type | undefined;
+    let namespace = 'compilets::nodejs';
     const name = type.symbol.name;
-    if (type.isClassOrInterface()) {
+    if (name == 'Buffer') {
+      // Checked before isClassOrInterface as Buffer may be a generic instance.
+      result = new syntax.Type('Buffer', 'class');
+    } else if (name == 'BufferConstructor') {
+      // The static methods like Buffer.alloc.
+      result = new syntax.Type('Buffer', 'namespace');
+    } else if (type.isClassOrInterface()) {
       // Global objects.
       if (name == 'Process')
         result = new syntax.Type('Process', 'class');
       else if (name == 'Console')
         result = new syntax.Type('Console', 'class');
+      else if (name == 'Timeout')
+        result = new syntax.Type('Timeout', 'class');
+      else if (name == 'Performance')
+        result = new syntax.Type('Performance', 'class');
+      else if (name == 'HRTime')
+        result = new syntax.Type('HRTime', 'class');
+      // The readline.Interface.
+      else if (name == 'Interface' && type.symbol.declarations?.some(d => isNodeJsModuleDeclaration(d, 'readline'))) {
+        result = new syntax.Type('Interface', 'class');
+        namespace = 'compilets::nodejs::readline';
+      }
     } else if (isFunction(type)) {
       // The gc function.
       if (location?.getText() == 'gc')
         result = new syntax.FunctionType('function', syntax.Type.createVoidType(), []);
     }
     if (result) {
-      result.namespace = 'compilets::nodejs';
+      result.namespace = namespace;
       result.isExternal = true;
     }
     return result;
@@ -350,8 +739,64 @@ export default class Typer {
     }
   }
 
+  /**
+   * Throws error if the variable of generator or async function can not be
+   * kept alive by cppgc::Persistent while the coroutine is suspended.
+   */
+  forbidUnpinnedCoroutineVariable(decl: ts.VariableDeclaration | ts.ParameterDeclaration, type: syntax.Type) {
+    if (!isCoroutineFunction(ts.findAncestor(decl, isFunctionLikeNode)))
+      return;
+    if (type.category == 'union' && type.hasObject())
+      throw new UnimplementedError(decl, 'Generators and async functions can not store unions of objects in variables');
+    if (this.needsSharedCell(decl))
+      throw new UnimplementedError(decl, 'Generators and async functions can not have variables modified by closures');
+  }
+
+  /**
+   * Throw if an object is evaluated before the await expression in the same
+   * statement, like `f(makeObject(), await p)`, as the temporary holding it
+   * lives in the coroutine frame which is not scanned by GC.
+   */
+  forbidUnpinnedAwaitTemporary(node: ts.AwaitExpression) {
+    // Variables of coroutines are pinned, and other values are not objects.
+    const isUnpinnedObject = (expr: ts.Expression): boolean => {
+      expr = ts.skipParentheses(expr);
+      if (ts.isIdentifier(expr) || expr.kind == ts.SyntaxKind.ThisKeyword)
+        return false;
+      return this.parseNodeType(expr).hasObject();
+    };
+    let child: ts.Node = node;
+    for (let parent = node.parent;
+         (ts.isExpression(parent) || ts.isPropertyAssignment(parent)) && !isFunctionLikeNode(parent);
+         child = parent, parent = parent.parent) {
+      // The right side of assignment is evaluated before the left side.
+      if (ts.isBinaryExpression(parent) &&
+          parent.operatorToken.kind >= ts.SyntaxKind.FirstAssignment &&
+          parent.operatorToken.kind <= ts.SyntaxKind.LastAssignment)
+        continue;
+      const siblings: ts.Node[] = [];
+      ts.forEachChild(parent, (c) => { siblings.push(c); });
+      for (let sibling of siblings) {
+        if (sibling == child)
+          break;
+        if (ts.isPropertyAssignment(sibling))
+          sibling = sibling.initializer;
+        if (!ts.isExpression(sibling))
+          continue;
+        // For method calls the object is what is evaluated.
+        if (ts.isPropertyAccessExpression(sibling) && ts.isCallExpression(parent) && parent.expression == sibling)
+          sibling = sibling.expression;
+        if (isUnpinnedObject(sibling as ts.Expression))
+          throw new UnimplementedError(node, 'The await expression can not be used after objects are evaluated in the same expression');
+      }
+    }
+  }
+
   /**
    * Return the names and types of outer variables referenced by the function.
+   *
+   * References inside nested functions are included, as the closure must
+   * capture them for the nested ones.
    */
   getCapturedIdentifiers(func: FunctionLikeNode) {
     const closure: (ts.Identifier | ts.ThisExpression)[] = [];
@@ -366,7 +811,7 @@ export default class Typer {
       isVariable = (node: ts.Node) => ts.isIdentifier(node) || node.kind == ts.SyntaxKind.ThisKeyword;
     }
     // Iterate through all child nodes of function body.
-    for (const node of filterNode(func.body, isVariable)) {
+    for (const node of filterNode(func.body, isVariable, () => false)) {
       // Keep references to "this".
       if (node.kind == ts.SyntaxKind.ThisKeyword) {
         closure.push(node as ts.ThisExpression);
@@ -376,7 +821,7 @@ export default class Typer {
       if (node.parent && ts.isPropertyAccessExpression(node.parent) && node.parent.name == node)
         continue;
       // Ignore symbols without definition.
-      const symbol = this.typeChecker.getSymbolAtLocation(node);
+      const symbol = this.getVariableSymbol(node as ts.Identifier);
       if (!symbol)
         throw new UnimplementedError(node, `Identifier "${node.getText()}" has no symbol`);
       const {valueDeclaration} = symbol;
@@ -400,6 +845,453 @@ export default class Typer {
     return uniqueArray(closure, (x, y) => x.getText() == y.getText());
   }
 
+  /**
+   * Decide how the lambda of the function expression captures each outer
+   * variable.
+   *
+   * Variables modified after being captured by escaping functions live in a
+   * shared GC cell, non-escaping functions capture by reference unless the
+   * value is as cheap to copy as a reference, and the rest are copied.
+   */
+  getClosureCaptures(func: FunctionLikeNode): ClosureCapture[] {
+    const nonEscaping = this.isNonEscapingFunction(func);
+    return this.getCapturedIdentifiers(func).map((node): ClosureCapture => {
+      if (node.kind == ts.SyntaxKind.ThisKeyword)
+        return {node, mode: 'value', forwardCell: false};
+      const decl = this.getVariableSymbol(node as ts.Identifier)!.valueDeclaration!;
+      if ((ts.isVariableDeclaration(decl) || ts.isParameter(decl)) && this.needsSharedCell(decl)) {
+        // Nested escaping functions need the cell to keep it alive.
+        const forwardCell = this.getVariableReferences(decl.name as ts.Identifier, func.body!)
+                                .some(r => this.isCapturedByEscapingFunction(r, func));
+        return {node, mode: nonEscaping ? 'reference' : 'cell', forwardCell};
+      }
+      if (!nonEscaping)
+        return {node, mode: 'value', forwardCell: false};
+      if (this.isModifiedVariable(decl))
+        return {node, mode: 'reference', forwardCell: false};
+      const type = this.parseNodeType(node);
+      const isCheapCopy = type.category == 'primitive' || type.isObject();
+      return {node, mode: isCheapCopy ? 'value' : 'reference', forwardCell: false};
+    });
+  }
+
+  /**
+   * Return whether the local variable or parameter must be stored in a GC
+   * cell, which happens when it is modified and captured by an escaping
+   * function. Parameters are copied into the cell when the function starts.
+   */
+  needsSharedCell(decl: ts.VariableDeclaration | ts.ParameterDeclaration): boolean {
+    let result = this.sharedCellCache.get(decl);
+    if (result === undefined) {
+      result = false;
+      const func = ts.findAncestor(decl, isFunctionLikeNode);
+      const isLocal = ts.isParameter(decl) ||
+                      (ts.isVariableStatement(decl.parent.parent) &&
+                       !parseHint(decl.parent).includes('persistent'));
+      if (func?.body &&
+          ts.isIdentifier(decl.name) &&
+          isLocal &&
+          this.isModifiedVariable(decl)) {
+        result = this.getVariableReferences(decl.name, func.body)
+                     .some(r => this.isCapturedByEscapingFunction(r, func));
+      }
+      this.sharedCellCache.set(decl, result);
+    }
+    return result;
+  }
+
+  /**
+   * Return whether the function object can never be called after the function
+   * creating it returns.
+   *
+   * This is true for immediately invoked functions, and for functions assigned
+   * to local variables that are only ever called directly.
+   */
+  isNonEscapingFunction(func: FunctionLikeNode): boolean {
+    if (!ts.isArrowFunction(func) && !ts.isFunctionExpression(func))
+      return false;
+    let node: ts.Node = func;
+    while (ts.isParenthesizedExpression(node.parent))
+      node = node.parent;
+    const {parent} = node;
+    if (ts.isCallExpression(parent) && parent.expression == node)
+      return true;
+    if (!ts.isVariableDeclaration(parent) ||
+        parent.initializer != node ||
+        !ts.isIdentifier(parent.name) ||
+        !ts.isVariableStatement(parent.parent.parent) ||
+        isGlobalVariable(parent) ||
+        parseHint(parent.parent).includes('persistent')) {
+      return false;
+    }
+    const scope = ts.findAncestor(parent, isFunctionLikeNode);
+    if (!scope?.body)
+      return false;
+    return this.getVariableReferences(parent.name, scope.body).every(r => {
+      return ts.findAncestor(r.parent, isFunctionLikeNode) == scope &&
+             ts.isCallExpression(r.parent) &&
+             r.parent.expression == r;
+    });
+  }
+
+  /**
+   * Return whether the parameter can be passed by const reference, which
+   * requires that it is never assigned.
+   *
+   * Parameters of overridden methods keep being passed by value, so the
+   * signatures of virtual methods always match.
+   */
+  isReadOnlyParameter(decl: ts.ParameterDeclaration): boolean {
+    const func = decl.parent;
+    if (ts.isMethodDeclaration(func) &&
+        (this.overriddenMethods.has(func) || this.overridingMethods.has(func))) {
+      return false;
+    }
+    // The coroutine keeps running after the caller's argument is gone.
+    if (isCoroutineFunction(func))
+      return false;
+    return !this.isModifiedVariable(decl);
+  }
+
+  /**
+   * Return whether the reference is the last use of a local variable, and is
+   * passed to a call, assigned, or used as initializer, so the value can be
+   * moved instead of copied.
+   *
+   * References inside loops are never the last use, and neither are ones
+   * sharing a statement with other references to the variable, as C++ does
+   * not specify the evaluation order of arguments.
+   */
+  isLastUseOfLocal(node: ts.Identifier): boolean {
+    const {parent} = node;
+    if ((ts.isCallExpression(parent) || ts.isNewExpression(parent)) && parent.arguments?.includes(node)) {
+      // Moving into a parameter taken by const reference still copies.
+      if (!this.isArgumentTakenByValue(parent, parent.arguments.indexOf(node)))
+        return false;
+    } else if (!(ts.isBinaryExpression(parent) && parent.right == node && parent.operatorToken.kind == ts.SyntaxKind.EqualsToken) &&
+               !(ts.isVariableDeclaration(parent) && parent.initializer == node)) {
+      return false;
+    }
+    const decl = this.getVariableSymbol(node)?.valueDeclaration;
+    if (!decl ||
+        !ts.isVariableDeclaration(decl) ||
+        !ts.isIdentifier(decl.name) ||
+        !ts.isVariableStatement(decl.parent.parent) ||
+        isGlobalVariable(decl) ||
+        parseHint(decl.parent).includes('persistent')) {
+      return false;
+    }
+    const func = ts.findAncestor(decl, isFunctionLikeNode);
+    if (!func?.body)
+      return false;
+    // The next iteration of a loop would read the moved value.
+    const block = decl.parent.parent.parent;
+    for (let n = node.parent; n != block && n != func; n = n.parent) {
+      if (ts.isIterationStatement(n, false))
+        return false;
+    }
+    // Find the statement, or the condition of if, containing the reference.
+    let statement: ts.Node = node;
+    while (!ts.isBlock(statement.parent) &&
+           !ts.isSourceFile(statement.parent) &&
+           !ts.isCaseOrDefaultClause(statement.parent) &&
+           !ts.isIfStatement(statement.parent)) {
+      statement = statement.parent;
+    }
+    // Closures referencing the variable may read it later.
+    return this.getVariableReferences(decl.name, func.body).every(r => {
+      return ts.findAncestor(r.parent, isFunctionLikeNode) == func &&
+             (r == node || r.end <= statement.getStart());
+    });
+  }
+
+  /**
+   * Return whether the argument at `index` is passed to a parameter taken by
+   * value, which is only known for the functions translated in the project.
+   */
+  private isArgumentTakenByValue(call: ts.CallExpression | ts.NewExpression, index: number): boolean {
+    const decl = this.typeChecker.getResolvedSignature(call)?.getDeclaration();
+    if (!decl || !isFunctionLikeNode(decl) || !decl.body)
+      return false;
+    const param = decl.parameters[index];
+    if (!param || param.dotDotDotToken)
+      return false;
+    return !this.isReadOnlyParameter(param);
+  }
+
+  /**
+   * Return whether the identifier references a local variable or parameter of
+   * the current function that is never assigned, so reading it again always
+   * gives the same value.
+   */
+  isReadOnlyLocal(node: ts.Identifier): boolean {
+    const decl = this.getVariableSymbol(node)?.valueDeclaration;
+    if (!decl || !(ts.isVariableDeclaration(decl) || ts.isParameter(decl)))
+      return false;
+    if (ts.isVariableDeclaration(decl) && isGlobalVariable(decl))
+      return false;
+    if (ts.findAncestor(decl, isFunctionLikeNode) != ts.findAncestor(node, isFunctionLikeNode))
+      return false;
+    return !this.isModifiedVariable(decl);
+  }
+
+  /**
+   * Return whether the body of the for...of loop can not change the length of
+   * the array being iterated.
+   *
+   * This is conservative: any call or yield, which might modify the array
+   * through another reference, and any accessor, which runs code, make it
+   * false.
+   */
+  isFixedLengthLoop(node: ts.ForOfStatement): boolean {
+    return filterNode(node.statement, (n) => {
+      if (ts.isCallExpression(n) ||
+          ts.isNewExpression(n) ||
+          ts.isYieldExpression(n) ||
+          ts.isAwaitExpression(n) ||
+          ts.isTaggedTemplateExpression(n) ||
+          ts.isDeleteExpression(n)) {
+        return true;
+      }
+      if (ts.isPropertyAccessExpression(n)) {
+        if (n.name.text == 'length' && isAssignmentTarget(n))
+          return true;
+        const decl = this.typeChecker.getSymbolAtLocation(n.name)?.valueDeclaration;
+        return decl != undefined && (ts.isGetAccessor(decl) || ts.isSetAccessor(decl));
+      }
+      return false;
+    }).length == 0;
+  }
+
+  /**
+   * Return whether the variable or parameter is assigned after declaration.
+   */
+  private isModifiedVariable(decl: ts.Declaration): boolean {
+    const {name} = decl as ts.VariableDeclaration | ts.ParameterDeclaration;
+    if (!ts.isIdentifier(name))
+      return false;
+    const scope = ts.findAncestor(decl, isFunctionLikeNode) ?? decl.getSourceFile();
+    return this.getVariableReferences(name, scope).some(r => {
+      let node: ts.Node = r;
+      while (ts.isParenthesizedExpression(node.parent))
+        node = node.parent;
+      const {parent} = node;
+      if (ts.isBinaryExpression(parent))
+        return parent.left == node &&
+               parent.operatorToken.kind >= ts.SyntaxKind.FirstAssignment &&
+               parent.operatorToken.kind <= ts.SyntaxKind.LastAssignment;
+      if (ts.isPrefixUnaryExpression(parent) || ts.isPostfixUnaryExpression(parent))
+        return parent.operator == ts.SyntaxKind.PlusPlusToken ||
+               parent.operator == ts.SyntaxKind.MinusMinusToken;
+      return false;
+    });
+  }
+
+  /**
+   * Return whether the reference is inside an escaping function that is
+   * nested in |func|.
+   */
+  private isCapturedByEscapingFunction(node: ts.Node, func: ts.Node): boolean {
+    for (let f = ts.findAncestor(node.parent, isFunctionLikeNode);
+         f && f != func;
+         f = ts.findAncestor(f.parent, isFunctionLikeNode)) {
+      if (!this.isNonEscapingFunction(f))
+        return true;
+    }
+    return false;
+  }
+
+  /**
+   * Return all the references to the variable inside |scope|, including the
+   * ones in nested functions.
+   */
+  private getVariableReferences(name: ts.Identifier, scope: ts.Node): ts.Identifier[] {
+    const symbol = this.typeChecker.getSymbolAtLocation(name);
+    return filterNode(scope, (node) => {
+      return ts.isIdentifier(node) &&
+             node != name &&
+             this.getVariableSymbol(node) == symbol;
+    }, () => false) as ts.Identifier[];
+  }
+
+  /**
+   * Return the symbol of the variable referenced by the identifier.
+   */
+  private getVariableSymbol(node: ts.Identifier): ts.Symbol | undefined {
+    // The {name} shorthand does not resolve to the variable directly.
+    if (ts.isShorthandPropertyAssignment(node.parent))
+      return this.typeChecker.getShorthandAssignmentValueSymbol(node.parent);
+    return this.typeChecker.getSymbolAtLocation(node);
+  }
+
+  /**
+   * Return whether the object created by the variable's initializer can never
+   * be referenced after the function returns.
+   *
+   * This is conservative: the variable must only be used for accessing its
+   * members, and for class instances no method or constructor may leak "this".
+   */
+  isNonEscapingAllocation(decl: ts.VariableDeclaration): boolean {
+    const {name, initializer} = decl;
+    if (!initializer || !ts.isIdentifier(name) || isGlobalVariable(decl))
+      return false;
+    // Only handle variable statements, which are always inside a block.
+    if (!ts.isVariableStatement(decl.parent.parent))
+      return false;
+    if (parseHint(decl.parent).includes('persistent'))
+      return false;
+    // Objects on the stack of coroutines would live in the coroutine frame.
+    if (isCoroutineFunction(ts.findAncestor(decl, isFunctionLikeNode)))
+      return false;
+    if (ts.isNewExpression(initializer)) {
+      if (!this.isThisContainedInClass(initializer))
+        return false;
+    } else if (ts.isObjectLiteralExpression(initializer)) {
+      if (!initializer.properties.every(ts.isPropertyAssignment))
+        return false;
+    } else {
+      return false;
+    }
+    // The stack is not scanned by precise GC, so the objects referenced by a
+    // stack object's members could be freed while it still uses them.
+    if (this.hasTracedProperties(this.typeChecker.getTypeAtLocation(initializer), initializer))
+      return false;
+    const func = ts.findAncestor(decl, isFunctionLikeNode);
+    if (!func)
+      return false;
+    // Being referenced in closures is also escaping.
+    return this.getVariableReferences(name, func.body!).every(r => ts.findAncestor(r.parent, isFunctionLikeNode) == func &&
+                                 this.isOnlyMemberAccess(r));
+  }
+
+  /**
+   * Return whether the objects of type have properties holding GCed objects,
+   * which must be traced by the GC.
+   */
+  private hasTracedProperties(type: ts.Type, location: ts.Node): boolean {
+    return type.getProperties().some((property) => {
+      if (property.flags & (ts.SymbolFlags.Method | ts.SymbolFlags.Accessor))
+        return false;
+      const cppType = this.parseSymbolType(property, location, [ 'property' ]);
+      return cppType.hasObject() || cppType.hasTemplate();
+    });
+  }
+
+  /**
+   * Return whether the variable is a const bound to a function expression and
+   * only ever called, so it can keep the concrete type of the function object
+   * and be called without going through the function pointer.
+   */
+  isKnownFunction(decl: ts.VariableDeclaration): boolean {
+    const {name, initializer} = decl;
+    if (!initializer || !ts.isIdentifier(name) || isGlobalVariable(decl))
+      return false;
+    if (!ts.isArrowFunction(initializer) && !ts.isFunctionExpression(initializer))
+      return false;
+    // The concrete type is printed as auto, which can not be shared with other
+    // declarators or be used by the initializer itself.
+    const list = decl.parent as ts.VariableDeclarationList;
+    if (!(list.flags & ts.NodeFlags.Const) || list.declarations.length != 1)
+      return false;
+    if (!ts.isVariableStatement(list.parent) || parseHint(list).includes('persistent'))
+      return false;
+    const func = ts.findAncestor(decl, isFunctionLikeNode);
+    if (!func || isCoroutineFunction(func))
+      return false;
+    return this.getVariableReferences(name, func.body!).every(r => ts.isCallExpression(r.parent) &&
+                                                                   r.parent.expression == r &&
+                                                                   !ts.findAncestor(r, n => n == initializer));
+  }
+
+  /**
+   * Return whether the object created by the variable's initializer can be
+   * freed when the enclosing allocation scope ends.
+   *
+   * The variable must be declared in the scope but not inside loops, and only
+   * be used for accessing members or elements inside the scope.
+   */
+  isScopedAllocation(decl: ts.VariableDeclaration): boolean {
+    const {name, initializer} = decl;
+    if (!initializer || !ts.isIdentifier(name))
+      return false;
+    if (!ts.isVariableStatement(decl.parent.parent))
+      return false;
+    const scope = ts.findAncestor(decl, (n) => isFunctionLikeNode(n) || isAllocationScope(n));
+    if (!scope || !ts.isBlock(scope))
+      return false;
+    // Objects allocated in loops would be kept alive until the scope ends.
+    if (ts.findAncestor(decl, (n) => n == scope || ts.isIterationStatement(n, false)) != scope)
+      return false;
+    let isAccess: (node: ts.Node) => boolean;
+    if (ts.isArrayLiteralExpression(initializer) ||
+        (ts.isNewExpression(initializer) &&
+         this.typeChecker.isArrayType(this.typeChecker.getTypeAtLocation(initializer)))) {
+      isAccess = isOnlyElementAccess;
+    } else if (ts.isNewExpression(initializer)) {
+      if (!this.isThisContainedInClass(initializer))
+        return false;
+      isAccess = this.isOnlyMemberAccess.bind(this);
+    } else if (ts.isObjectLiteralExpression(initializer)) {
+      if (!initializer.properties.every(ts.isPropertyAssignment))
+        return false;
+      isAccess = this.isOnlyMemberAccess.bind(this);
+    } else {
+      return false;
+    }
+    const func = ts.findAncestor(scope, isFunctionLikeNode);
+    return this.getVariableReferences(name, scope).every(r => ts.findAncestor(r.parent, isFunctionLikeNode) == func &&
+                                                              isAccess(r));
+  }
+
+  /**
+   * Return whether "this" is only used for accessing members in the class of
+   * the new expression and all its base classes.
+   */
+  private isThisContainedInClass(node: ts.NewExpression): boolean {
+    let type: ts.Type | undefined = this.typeChecker.getTypeAtLocation(node);
+    while (type) {
+      const decl = type.symbol?.valueDeclaration;
+      if (!decl || !ts.isClassDeclaration(decl) || isExternalDeclaration(decl))
+        return false;
+      for (const member of decl.members) {
+        if ((member as ts.PropertyDeclaration).modifiers?.some(m => m.kind == ts.SyntaxKind.StaticKeyword))
+          continue;
+        // Objects with destructors must be managed by GC.
+        if (parseHint(member).includes('destructor'))
+          return false;
+        const thisNodes = filterNode(member, (n) => n.kind == ts.SyntaxKind.ThisKeyword, () => false);
+        for (const t of thisNodes) {
+          const owner = ts.findAncestor(t.parent, (n) => n == member || isFunctionLikeNode(n));
+          if (owner != member || !this.isOnlyMemberAccess(t))
+            return false;
+        }
+      }
+      const classType = this.typeChecker.getDeclaredTypeOfSymbol(type.symbol) as ts.InterfaceType;
+      type = this.typeChecker.getBaseTypes(classType)[0];
+    }
+    return true;
+  }
+
+  /**
+   * Return whether the node is only used as the object of a property access,
+   * or as the "this" of a method call.
+   */
+  private isOnlyMemberAccess(node: ts.Node): boolean {
+    const {parent} = node;
+    if (!ts.isPropertyAccessExpression(parent) || parent.expression != node)
+      return false;
+    if (ts.isCallExpression(parent.parent) && parent.parent.expression == parent) {
+      // The methods have been checked by isThisContainedInClass, and calling a
+      // function stored in property does not pass the object.
+      const decl = this.typeChecker.getSymbolAtLocation(parent.name)?.valueDeclaration;
+      return decl != undefined && (ts.isMethodDeclaration(decl) ||
+                                   ts.isPropertyDeclaration(decl) ||
+                                   ts.isPropertyAssignment(decl) ||
+                                   ts.isPropertySignature(decl));
+    }
+    return true;
+  }
+
   /**
    * Get the type modifiers from the declaration.
    */
@@ -418,6 +1310,11 @@ export default class Typer {
         ts.isPropertySignature(decl)) {
       modifiers.push('property');
     }
+    // Variables and parameters stored in GC cells are referenced like
+    // properties.
+    if ((ts.isVariableDeclaration(decl) || ts.isParameter(decl)) && this.needsSharedCell(decl)) {
+      modifiers.push('property');
+    }
     if (ts.isPropertyDeclaration(decl) ||
         ts.isPropertySignature(decl) ||
         ts.isMethodDeclaration(decl) ||
@@ -428,6 +1325,12 @@ export default class Typer {
     if (ts.isParameter(decl) && decl.dotDotDotToken) {
       modifiers.push('variadic');
     }
+    // The coroutine frames of generators and async functions are not scanned
+    // by GC.
+    if ((ts.isVariableDeclaration(decl) || ts.isParameter(decl)) &&
+        isCoroutineFunction(ts.findAncestor(decl, isFunctionLikeNode))) {
+      modifiers.push('persistent');
+    }
     // For variable declaration, the comments are in the declarationList.
     const hintNode = ts.isVariableDeclaration(decl) ? decl.parent : decl;
     // Parse the hints in comments.
@@ -469,6 +1372,10 @@ export default class Typer {
           return [ initializer ];
         return decls.map(d => this.getTypeNodes(d))
                     .reduce((r, i) => r.concat(i), []);
+      } else if (ts.isParameter(decl) && ts.isArrowFunction(decl.parent)) {
+        // Parameters of arrow functions can be typed by context, for example
+        // the resolve function passed to the executor of Promise.
+        return [ decl ];
       } else {
         throw new Error('Can not find type or initializer in the declaration');
       }
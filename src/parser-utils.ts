@@ -99,6 +99,17 @@ export function getFileNameFromModuleSpecifier(specifier: string): string {
   return specifier;
 }
 
+/**
+ * Return the name of Node.js builtin module, for example "fs" from "node:fs",
+ * or undefined if the module is a local file.
+ */
+export function getBuiltinModuleName(specifier: string): string | undefined {
+  if (specifier.startsWith('node:'))
+    return specifier.substr(5);
+  if (specifier == 'fs' || specifier == 'readline')
+    return specifier;
+}
+
 /**
  * Calculate the node's namespace according to the file it is defined.
  */
@@ -163,7 +174,7 @@ export function isExternalDeclaration(decl: ts.Declaration): boolean {
 }
 
 /**
- * Return whether the declaration is a builtin interface like Math and Number.
+ * Return whether the declaration is a builtin interface like Math and Object.
  */
 export function isBuiltinDeclaration(decl: ts.Declaration): boolean {
   const sourceFile = decl.getSourceFile();
@@ -173,7 +184,8 @@ export function isBuiltinDeclaration(decl: ts.Declaration): boolean {
          ts.isIdentifier(decl.name) &&
          (decl.name.text == 'Array' ||
           decl.name.text == 'Math' ||
-          decl.name.text == 'Number');
+          decl.name.text == 'Number' ||
+          decl.name.text == 'Object');
 }
 
 /**
@@ -203,6 +215,32 @@ export function isNodeJsDeclaration(decl: ts.Declaration): boolean {
          sourceFile.fileName.includes('/node_modules/@types/node/');
 }
 
+/**
+ * Return whether the declaration comes from the builtin module, like node:fs.
+ */
+export function isNodeJsModuleDeclaration(decl: ts.Declaration, module: string): boolean {
+  return isNodeJsDeclaration(decl) &&
+         decl.getSourceFile().fileName.endsWith(`/@types/node/${module}.d.ts`);
+}
+
+/**
+ * Return whether the expression is assigned to or incremented.
+ */
+export function isAssignmentTarget(node: ts.Expression): boolean {
+  const {parent} = node;
+  if (ts.isBinaryExpression(parent)) {
+    const {kind} = parent.operatorToken;
+    return parent.left == node &&
+           kind >= ts.SyntaxKind.FirstAssignment &&
+           kind <= ts.SyntaxKind.LastAssignment;
+  }
+  if (ts.isPrefixUnaryExpression(parent) || ts.isPostfixUnaryExpression(parent)) {
+    return parent.operator == ts.SyntaxKind.PlusPlusToken ||
+           parent.operator == ts.SyntaxKind.MinusMinusToken;
+  }
+  return false;
+}
+
 /**
  * Return whether it is a top-level variable declaration.
  */
@@ -233,6 +271,94 @@ export function isBuiltinInterfaceType(type: ts.Type): type is ts.InterfaceType
   return isBuiltinDeclaration(type.symbol.valueDeclaration);
 }
 
+/**
+ * Return whether the declaration comes from the ECMAScript libs of TypeScript.
+ */
+export function isBuiltinLibDeclaration(decl: ts.Declaration): boolean {
+  const {fileName} = decl.getSourceFile();
+  return /node_modules\/typescript\/lib\/lib\.es.*\.d\.ts$/.test(fileName);
+}
+
+/**
+ * Return if the type is one of the named builtin types of JavaScript.
+ */
+function isBuiltinLibType(type: ts.Type, names: string[]): type is ts.TypeReference {
+  if (!type.symbol || !type.symbol.declarations)
+    return false;
+  if (!names.includes(type.symbol.name))
+    return false;
+  return type.symbol.declarations.some(isBuiltinLibDeclaration);
+}
+
+/**
+ * Return if the type is the builtin Map or Set of JavaScript.
+ */
+export function isBuiltinCollectionType(type: ts.Type): type is ts.TypeReference {
+  return isBuiltinLibType(type, [ 'Map', 'Set' ]);
+}
+
+/**
+ * Return if the type is the object returned by generator functions.
+ */
+export function isBuiltinGeneratorType(type: ts.Type): type is ts.TypeReference {
+  return isBuiltinLibType(type, [ 'Generator' ]);
+}
+
+/**
+ * Return if the node is a function declared with function*.
+ */
+export function isGeneratorFunction(node?: ts.Node): boolean {
+  return node != undefined && ts.isFunctionDeclaration(node) && node.asteriskToken != undefined;
+}
+
+/**
+ * Return if the type is the Promise returned by async functions.
+ */
+export function isBuiltinPromiseType(type: ts.Type): type is ts.TypeReference {
+  return isBuiltinLibType(type, [ 'Promise' ]);
+}
+
+/**
+ * Return if the type is the builtin ArrayBuffer or Uint8Array.
+ */
+export function isBuiltinByteArrayType(type: ts.Type): boolean {
+  return isBuiltinLibType(type, [ 'ArrayBuffer', 'Uint8Array' ]);
+}
+
+/**
+ * Return if the type is ArrayBufferLike, which is a union including the
+ * SharedArrayBuffer that is treated as ArrayBuffer.
+ */
+export function isBuiltinArrayBufferLikeType(type: ts.Type): boolean {
+  return type.isUnion() &&
+         type.types.every(t => isBuiltinLibType(t, [ 'ArrayBuffer', 'SharedArrayBuffer' ]));
+}
+
+/**
+ * Return if the type is the PromiseLike accepted by resolve functions.
+ */
+export function isBuiltinPromiseLikeType(type: ts.Type): boolean {
+  return isBuiltinLibType(type, [ 'PromiseLike' ]);
+}
+
+/**
+ * Return if the node is a function declared with async.
+ */
+export function isAsyncFunction(node?: ts.Node): boolean {
+  return node != undefined &&
+         ts.isFunctionDeclaration(node) &&
+         node.modifiers != undefined &&
+         node.modifiers.some(m => m.kind == ts.SyntaxKind.AsyncKeyword);
+}
+
+/**
+ * Return if the node is a function translated to C++ coroutine, whose frame
+ * is not scanned by GC.
+ */
+export function isCoroutineFunction(node?: ts.Node): boolean {
+  return isGeneratorFunction(node) || isAsyncFunction(node);
+}
+
 /**
  * Return if the type is a constructor function.
  */
@@ -326,6 +452,34 @@ export function parseHint(node: ts.Node): string[] {
   return [];
 }
 
+/**
+ * Return whether the node is a block marked with "// compilets: allocation-scope".
+ */
+export function isAllocationScope(node: ts.Node): node is ts.Block {
+  return ts.isBlock(node) && parseHint(node).includes('allocation-scope');
+}
+
+/**
+ * Return whether the array is only used for reading or writing its elements,
+ * reading its length and calling methods that can not leak the array.
+ *
+ * Methods taking callbacks pass the array to them and methods like `sort`
+ * return the array itself, so only the listed ones are allowed.
+ */
+export function isOnlyElementAccess(node: ts.Node): boolean {
+  const {parent} = node;
+  if (ts.isElementAccessExpression(parent))
+    return parent.expression == node;
+  if (!ts.isPropertyAccessExpression(parent) || parent.expression != node)
+    return false;
+  const member = parent.name.text;
+  if (member == 'length')
+    return true;
+  if (!ts.isCallExpression(parent.parent) || parent.parent.expression != parent)
+    return false;
+  return [ 'at', 'includes', 'indexOf', 'join', 'lastIndexOf', 'pop', 'push', 'shift', 'unshift' ].includes(member);
+}
+
 /**
  * Merge multiple types into one union.
  */
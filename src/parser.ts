@@ -4,6 +4,7 @@ import * as ts from 'typescript';
 import CppFile from './cpp-file';
 import CppProject from './cpp-project';
 import Typer from './parser-typer';
+import {PrintedFile} from './translation-cache';
 import * as syntax from './cpp-syntax';
 
 import {
@@ -12,15 +13,44 @@ import {
   operatorToString,
   modifierToString,
   getFileNameFromModuleSpecifier,
+  getBuiltinModuleName,
   getNamespaceFromFileName,
   isExportedDeclaration,
   isModuleImports,
+  isBuiltinCollectionType,
+  isBuiltinGeneratorType,
+  isBuiltinPromiseType,
+  isGeneratorFunction,
+  isAsyncFunction,
+  isCoroutineFunction,
+  isAssignmentTarget,
   isFunctionLikeNode,
   isTemplateFunctor,
   filterNode,
   parseHint,
+  isAllocationScope,
 } from './parser-utils';
 
+// The binary operators of bigint that are translated to int64_t as they are.
+const bigIntBinaryOperators = [
+  ts.SyntaxKind.PlusToken,
+  ts.SyntaxKind.MinusToken,
+  ts.SyntaxKind.PlusEqualsToken,
+  ts.SyntaxKind.MinusEqualsToken,
+  ts.SyntaxKind.EqualsToken,
+  ts.SyntaxKind.GreaterThanToken,
+  ts.SyntaxKind.GreaterThanEqualsToken,
+  ts.SyntaxKind.LessThanToken,
+  ts.SyntaxKind.LessThanEqualsToken,
+  ts.SyntaxKind.EqualsEqualsToken,
+  ts.SyntaxKind.EqualsEqualsEqualsToken,
+  ts.SyntaxKind.ExclamationEqualsToken,
+  ts.SyntaxKind.ExclamationEqualsEqualsToken,
+  ts.SyntaxKind.AmpersandAmpersandToken,
+  ts.SyntaxKind.BarBarToken,
+  ts.SyntaxKind.CommaToken,
+];
+
 /**
  * Convert TypeScript AST to C++ source code.
  */
@@ -33,7 +63,10 @@ export default class Parser {
     if (project.getFiles().length > 0)
       throw new Error('The project has already been parsed');
     this.project = project;
-    this.program = ts.createProgram(project.fileNames, project.compilerOptions);
+    if (project.cache)
+      this.program = project.cache.createProgram();
+    else
+      this.program = ts.createProgram(project.fileNames, project.compilerOptions);
     this.typer = new Typer(project, this.program.getTypeChecker());
   }
 
@@ -41,16 +74,44 @@ export default class Parser {
     // Run pre-emit diagnostics.
     if (!this.project.skipPreEmitDiagnostics)
       this.runPreEmitDiagnostics();
-    // Start parsing.
-    for (const fileName of this.program.getRootFileNames()) {
-      const sourceFile = this.program.getSourceFile(fileName)!;
-      const cppFile = this.parseSourceFile(fileName, sourceFile);
-      this.project.addParsedFile(cppFile.name, cppFile);
+    // Interfaces are lowered to values unless the program relies on their
+    // identities, which requires knowing all the usages beforehand.
+    const sourceFiles = this.program.getRootFileNames().map(f => this.program.getSourceFile(f)!);
+    const {cache} = this.project;
+    if (cache)
+      cache.collectReferenceInterfaces(this.typer, sourceFiles);
+    else
+      this.typer.collectReferenceInterfaces(sourceFiles);
+    // Classes that are never extended are final, and methods that are never
+    // overridden are not virtual.
+    this.typer.collectClassHierarchy(sourceFiles);
+    // Start parsing, unchanged files reuse the code printed last time.
+    const printedFiles = cache?.getPrintedFiles(sourceFiles);
+    const files = sourceFiles.map(sourceFile => {
+      return printedFiles?.get(sourceFile) ??
+             this.parseSourceFile(sourceFile.fileName, sourceFile);
+    });
+    // Parsing other files can change the interfaces used by the reused files,
+    // for example requiring them to be visitable by JSON, and the reused files
+    // must be parsed again then.
+    let changed = true;
+    while (cache && changed) {
+      changed = false;
+      for (let i = 0; i < files.length; ++i) {
+        const file = files[i];
+        if (file instanceof PrintedFile && !cache.isUpToDate(file)) {
+          files[i] = this.parseSourceFile(sourceFiles[i].fileName, sourceFiles[i]);
+          changed = true;
+        }
+      }
     }
+    for (const file of files)
+      this.project.addParsedFile(file.name, file);
   }
 
   runPreEmitDiagnostics() {
-    const diagnostics = ts.getPreEmitDiagnostics(this.program);
+    const diagnostics = this.project.cache?.getPreEmitDiagnostics() ??
+                        ts.getPreEmitDiagnostics(this.program);
     if (diagnostics.length == 0)
       return;
     const diagnostic = diagnostics[0];
@@ -66,6 +127,8 @@ export default class Parser {
   }
 
   parseSourceFile(fileName: string, sourceFile: ts.SourceFile): CppFile {
+    // A reused file can be parsed again, which marks the interfaces again.
+    this.typer.jsonInterfaces.delete(fileName);
     const fileNameInProject = path.relative(this.project.sourceRootDir, fileName);
     const fileNameInFileSystem = path.relative(this.project.rootDir, fileName);
     const cppFile = new CppFile(fileNameInFileSystem,
@@ -99,6 +162,7 @@ export default class Parser {
         case ts.SyntaxKind.DoStatement:
         case ts.SyntaxKind.WhileStatement:
         case ts.SyntaxKind.ForStatement:
+        case ts.SyntaxKind.ForOfStatement:
         case ts.SyntaxKind.ReturnStatement:
           if (cppFile.type == 'lib')
             throw new UnsupportedError(node, 'In C++ only class and function declarations can be made top-level, unless it is the main script');
@@ -135,14 +199,24 @@ export default class Parser {
         return new syntax.BaseResolutionExpression(this.typer.parseNodeType(node));
       case ts.SyntaxKind.NumericLiteral:
         return new syntax.NumericLiteral(node.getText());
+      case ts.SyntaxKind.BigIntLiteral: {
+        // 123n
+        const text = node.getText().slice(0, -1).replace(/_/g, '');
+        if (BigInt(text) > 0x7fffffffffffffffn)
+          throw new UnimplementedError(node, 'BigInt larger than 64 bits is not supported');
+        return new syntax.BigIntLiteral(text);
+      }
       case ts.SyntaxKind.StringLiteral:
         return new syntax.StringLiteral((node as ts.StringLiteral).text);
       case ts.SyntaxKind.Identifier: {
         const type = this.typer.parseNodeType(node);
         if (type.category == 'undefined')
           return new syntax.UndefinedKeyword();
-        else
-          return new syntax.Identifier(type, node.getText(), this.typer.getNodeNamespace(node))
+        const identifier = new syntax.Identifier(type, node.getText(), this.typer.getNodeNamespace(node));
+        // Move the local into its last use instead of copying it.
+        if (type.isExpensiveToCopy())
+          identifier.isLastUse = this.typer.isLastUseOfLocal(node as ts.Identifier);
+        return identifier;
       }
       case ts.SyntaxKind.TemplateExpression: {
         // `prefix${value}`
@@ -185,15 +259,23 @@ export default class Parser {
       case ts.SyntaxKind.PostfixUnaryExpression: {
         // a++
         const {operand, operator} = node as ts.PostfixUnaryExpression;
+        const cppOperand = this.parseExpression(operand);
+        if (cppOperand.type.isBigInt())
+          throw new UnimplementedError(node, `The ${operatorToString(operator)} operator of bigint is not supported`);
         return new syntax.PostfixUnaryExpression(this.typer.parseNodeType(node),
-                                                 this.parseExpression(operand),
+                                                 cppOperand,
                                                  operatorToString(operator));
       }
       case ts.SyntaxKind.PrefixUnaryExpression: {
         // ++a
         const {operand, operator} = node as ts.PrefixUnaryExpression;
+        const cppOperand = this.parseExpression(operand);
+        if (cppOperand.type.isBigInt() &&
+            operator != ts.SyntaxKind.MinusToken &&
+            operator != ts.SyntaxKind.ExclamationToken)
+          throw new UnimplementedError(node, `The ${operatorToString(operator)} operator of bigint is not supported`);
         return new syntax.PrefixUnaryExpression(this.typer.parseNodeType(node),
-                                                this.parseExpression(operand),
+                                                cppOperand,
                                                 operatorToString(operator));
       }
       case ts.SyntaxKind.ConditionalExpression: {
@@ -229,6 +311,11 @@ export default class Parser {
         const args = newExpression['arguments'];  // arguments is a keyword
         if (!ts.isIdentifier(newExpression.expression))
           throw new UnsupportedError(node, 'The new operator only accepts class name');
+        if (args && args.length > 0 &&
+            isBuiltinCollectionType(this.typer.typeChecker.getTypeAtLocation(node)))
+          throw new UnimplementedError(node, 'Creating Map or Set from iterable is not supported');
+        if (isBuiltinPromiseType(this.typer.typeChecker.getTypeAtLocation(node)))
+          return this.parsePromiseConstructor(newExpression);
         return new syntax.NewExpression(this.typer.parseNodeType(node),
                                         this.parseArguments(newExpression, args));
       }
@@ -245,9 +332,42 @@ export default class Parser {
         const {expression, argumentExpression, questionDotToken} = node as ts.ElementAccessExpression;
         if (questionDotToken)
           throw new UnimplementedError(node, 'The ?.[] operator is not supported');
+        const obj = this.parseExpression(expression);
+        if (obj.type.isRecord()) {
+          return this.parseRecordAccess(node as ts.ElementAccessExpression,
+                                        obj,
+                                        this.parseExpression(argumentExpression));
+        }
         return new syntax.ElementAccessExpression(this.typer.parseNodeType(node),
-                                                  this.parseExpression(expression),
-                                                  this.parseExpression(argumentExpression));
+                                                  obj,
+                                                  this.parseExpression(argumentExpression),
+                                                  isAssignmentTarget(node as ts.ElementAccessExpression));
+      }
+      case ts.SyntaxKind.YieldExpression:
+        // The yield statements are handled by parseStatement.
+        throw new UnimplementedError(node, 'The value of yield expression can not be used');
+      case ts.SyntaxKind.AwaitExpression: {
+        // await promise
+        const {expression} = node as ts.AwaitExpression;
+        if (!isAsyncFunction(ts.findAncestor(node, isFunctionLikeNode)))
+          throw new UnimplementedError(node, 'The await expression can only be used in async functions');
+        // Awaiting a value that is not a promise just gives the value.
+        if (!isBuiltinPromiseType(this.typer.typeChecker.getTypeAtLocation(expression)))
+          return this.parseExpression(expression);
+        this.typer.forbidUnpinnedAwaitTemporary(node as ts.AwaitExpression);
+        return new syntax.AwaitExpression(this.typer.parseNodeType(node),
+                                          this.parseExpression(expression));
+      }
+      case ts.SyntaxKind.DeleteExpression: {
+        // delete record[key]
+        const {expression} = node as ts.DeleteExpression;
+        const access = this.parseExpression(expression);
+        if (!(access instanceof syntax.RecordAccessExpression))
+          throw new UnimplementedError(node, 'The delete operator only works with records');
+        return new syntax.RecordAccessExpression(syntax.Type.createBooleanType(),
+                                                 access.expression,
+                                                 access.key,
+                                                 'erase');
       }
     }
     throw new UnimplementedError(node, 'Unsupported expression');
@@ -267,6 +387,14 @@ export default class Parser {
         return new syntax.StringConcatenation([ cppLeft, cppRight ]);
     }
     const operator = operatorToken.getText();
+    // BigInt is limited to 64 bits, only the operators needed for measuring
+    // time are supported.
+    if (cppLeft.type.isBigInt() || cppRight.type.isBigInt()) {
+      if (operatorToken.kind == ts.SyntaxKind.SlashToken)
+        return new syntax.BigIntDivision(cppLeft, cppRight);
+      if (!bigIntBinaryOperators.includes(operatorToken.kind))
+        throw new UnimplementedError(node, `The ${operator} operator of bigint is not supported`);
+    }
     switch (operatorToken.kind) {
       case ts.SyntaxKind.AmpersandAmpersandToken:
       case ts.SyntaxKind.BarBarToken:
@@ -288,6 +416,14 @@ export default class Parser {
       case ts.SyntaxKind.EqualsToken:
         // a = b
         return new syntax.AssignmentExpression(cppLeft, cppRight);
+      case ts.SyntaxKind.InKeyword:
+        // key in record
+        if (!cppRight.type.isRecord() || cppLeft.type.category != 'string')
+          throw new UnimplementedError(node, 'The in operator only works with string keys of records');
+        return new syntax.RecordAccessExpression(syntax.Type.createBooleanType(),
+                                                 cppRight,
+                                                 cppLeft,
+                                                 'has');
       case ts.SyntaxKind.PercentToken:
         // a % b
         return new syntax.ModExpression(cppLeft, cppRight);
@@ -304,7 +440,15 @@ export default class Parser {
       case ts.SyntaxKind.Block: {
         // { xxx; yyy; zzz; }
         const {statements} = node as ts.Block;
-        return new syntax.Block(statements.map(this.parseStatement.bind(this)));
+        const block = new syntax.Block(statements.map(this.parseStatement.bind(this)));
+        if (isAllocationScope(node)) {
+          // The scopes are nested in the order of calls, which suspended
+          // coroutines would break.
+          if (isCoroutineFunction(ts.findAncestor(node, isFunctionLikeNode)))
+            throw new UnsupportedError(node, 'Allocation scope can not be used in generators or async functions');
+          block.statements.unshift(new syntax.AllocationScopeDeclaration());
+        }
+        return block;
       }
       case ts.SyntaxKind.VariableStatement: {
         // let a = xxx, b = xxx;
@@ -313,8 +457,10 @@ export default class Parser {
       }
       case ts.SyntaxKind.ExpressionStatement: {
         // xxxx;
-        const expr = this.parseExpression((node as ts.ExpressionStatement).expression);
-        return new syntax.ExpressionStatement(expr);
+        const {expression} = node as ts.ExpressionStatement;
+        if (ts.isYieldExpression(expression))
+          return this.parseYieldStatement(expression);
+        return new syntax.ExpressionStatement(this.parseExpression(expression));
       }
       case ts.SyntaxKind.IfStatement: {
         // if (xxx) { yyy } else { zzz }
@@ -354,19 +500,27 @@ export default class Parser {
         // return xxx
         const {expression} = node as ts.ReturnStatement;
         let returnType = syntax.Type.createVoidType();
+        const func = ts.findAncestor(node.parent, isFunctionLikeNode);
         if (expression) {
-          const func = ts.findAncestor(node.parent, isFunctionLikeNode);
           if (!func)
             throw new UnsupportedError(node, 'Can not find the function return type of return statement');
+          if (isGeneratorFunction(func))
+            throw new UnimplementedError(node, 'Returning value from generator is not supported');
           returnType = (this.typer.parseNodeType(func) as syntax.FunctionType).returnType;
+          // Async functions return the value of promise.
+          if (isAsyncFunction(func))
+            returnType = returnType.templateArguments![0];
         }
-        return new syntax.ReturnStatement(expression ? this.parseExpression(expression) : undefined,
-                                          returnType);
+        const statement = new syntax.ReturnStatement(expression ? this.parseExpression(expression) : undefined,
+                                                     returnType);
+        statement.isCoroutine = isCoroutineFunction(func);
+        return statement;
       }
       case ts.SyntaxKind.ForInStatement:
         throw new UnimplementedError(node, 'The for...in loop is not supported');
       case ts.SyntaxKind.ForOfStatement:
-        throw new UnimplementedError(node, 'The for...of loop is not supported');
+        // for (const item of items) { xxx }
+        return this.parseForOfStatement(node as ts.ForOfStatement);
       case ts.SyntaxKind.ClassDeclaration:
         throw new UnsupportedError(node, 'C++ only supports top-level classes');
       case ts.SyntaxKind.FunctionDeclaration:
@@ -379,8 +533,18 @@ export default class Parser {
     const {importClause, moduleSpecifier} = node;
     if (!ts.isStringLiteral(moduleSpecifier))
       throw new UnsupportedError(node, 'Module name must be string literal');
-    const fileName = getFileNameFromModuleSpecifier(moduleSpecifier.text);
-    const decl = new syntax.ImportDeclaration(fileName, getNamespaceFromFileName(fileName));
+    let decl: syntax.ImportDeclaration;
+    const builtinModule = getBuiltinModuleName(moduleSpecifier.text);
+    if (builtinModule) {
+      // import * as fs from 'node:fs'
+      if (builtinModule != 'fs' && builtinModule != 'readline')
+        throw new UnimplementedError(node, `The builtin module "${moduleSpecifier.text}" is not supported`);
+      decl = new syntax.ImportDeclaration(builtinModule, `compilets::nodejs::${builtinModule}`);
+      decl.feature = builtinModule as 'fs' | 'readline';
+    } else {
+      const fileName = getFileNameFromModuleSpecifier(moduleSpecifier.text);
+      decl = new syntax.ImportDeclaration(fileName, getNamespaceFromFileName(fileName));
+    }
     // import 'module'
     if (!importClause)
       return decl;
@@ -406,6 +570,101 @@ export default class Parser {
     return decl;
   }
 
+  parseYieldStatement(node: ts.YieldExpression): syntax.Statement {
+    const {asteriskToken, expression} = node;
+    if (!expression)
+      throw new UnimplementedError(node, 'The yield expression must have a value');
+    const func = ts.findAncestor(node, isFunctionLikeNode)!;
+    const returnType = (this.typer.parseNodeType(func) as syntax.FunctionType).returnType;
+    const yieldType = returnType.templateArguments![0];
+    if (asteriskToken) {
+      // yield* generator
+      if (!isBuiltinGeneratorType(this.typer.typeChecker.getTypeAtLocation(expression)))
+        throw new UnimplementedError(node, 'The yield* expression only works with generators');
+      // Keep the generator alive while this coroutine is suspended.
+      const generator = this.parseExpression(expression);
+      const type = generator.type.noProperty();
+      type.isPersistent = true;
+      const declaration = new syntax.VariableDeclaration('_delegate', type, generator);
+      return new syntax.Block([
+        new syntax.VariableStatement(new syntax.VariableDeclarationList([ declaration ])),
+        new syntax.YieldStatement(new syntax.Identifier(type, '_delegate'), yieldType, true),
+      ]);
+    }
+    return new syntax.YieldStatement(this.parseExpression(expression), yieldType);
+  }
+
+  parseForOfStatement(node: ts.ForOfStatement): syntax.Statement {
+    const {awaitModifier, initializer, expression, statement} = node;
+    if (awaitModifier && this.typer.parseNodeType(expression).namespace != 'compilets::nodejs::readline')
+      throw new UnimplementedError(node, 'The for await...of loop only supports readline interfaces');
+    if (!ts.isVariableDeclarationList(initializer) || initializer.declarations.length != 1)
+      throw new UnimplementedError(initializer, 'The for...of loop must declare one variable');
+    const {name} = initializer.declarations[0];
+    const type = this.typer.typeChecker.getTypeAtLocation(expression);
+    let kind: syntax.ForOfKind;
+    let names: ts.Identifier[];
+    if (isBuiltinCollectionType(type) && type.symbol.name == 'Map') {
+      // for (const [key, value] of map)
+      kind = 'map';
+      if (!ts.isArrayBindingPattern(name) ||
+          name.elements.length != 2 ||
+          !name.elements.every(e => ts.isBindingElement(e) && ts.isIdentifier(e.name) && !e.initializer && !e.dotDotDotToken))
+        throw new UnimplementedError(name, 'Iterating a map must destructure the entries to [key, value]');
+      names = name.elements.map(e => (e as ts.BindingElement).name as ts.Identifier);
+    } else {
+      if (!ts.isIdentifier(name))
+        throw new UnimplementedError(name, 'Destructuring in for...of loop is only supported for maps');
+      names = [ name ];
+      if (awaitModifier)
+        kind = 'readline';
+      else if (this.typer.typeChecker.isArrayType(type))
+        kind = 'array';
+      else if (isBuiltinCollectionType(type))
+        kind = 'set';
+      else if (isBuiltinGeneratorType(type))
+        kind = 'generator';
+      else if (type.flags & ts.TypeFlags.StringLike)
+        kind = 'string';
+      else
+        throw new UnimplementedError(expression, 'The for...of loop only supports arrays, strings, maps, sets and generators');
+    }
+    const types = names.map(n => {
+      const type = this.typer.parseNodeType(n);
+      if (type.category == 'any')
+        throw new UnsupportedError(n, 'Can not declare a variable type as any');
+      this.typer.forbidUnpinnedCoroutineVariable(initializer.declarations[0], type);
+      return type;
+    });
+    let cppExpression = this.parseExpression(expression);
+    // The array is indexed in every iteration, so it must be read from a local
+    // that keeps pointing to the same array. The string iterator points into
+    // the string's storage, which would be released if the body reassigns the
+    // string. In generators and async functions other ranges are also stored
+    // in locals, as the coroutine frame is not scanned by GC and the range
+    // would be freed while suspended.
+    const isCoroutine = isCoroutineFunction(ts.findAncestor(node, isFunctionLikeNode));
+    let array: syntax.VariableStatement | undefined;
+    if ((kind == 'array' || kind == 'string' || (isCoroutine && cppExpression.type.isObject())) &&
+        !(ts.isIdentifier(expression) && this.typer.isReadOnlyLocal(expression))) {
+      const type = cppExpression.type.noProperty();
+      type.isPersistent = isCoroutine;
+      const identifier = `_${names[0].text}_${kind == 'array' ? 'array' : 'range'}`;
+      array = new syntax.VariableStatement(new syntax.VariableDeclarationList([ new syntax.VariableDeclaration(identifier, type, cppExpression) ]));
+      cppExpression = new syntax.Identifier(type, identifier);
+    }
+    const loop = new syntax.ForOfStatement(kind,
+                                           names.map(n => n.text),
+                                           types,
+                                           cppExpression,
+                                           this.parseStatement(statement));
+    if (kind == 'array')
+      loop.isFixedLength = this.typer.isFixedLengthLoop(node);
+    if (array)
+      return new syntax.Block([ array, loop ]);
+    return loop;
+  }
+
   parseVariableDeclarationList(node: ts.VariableDeclarationList): syntax.VariableDeclarationList {
     const decls = node.declarations.map(this.parseVariableDeclaration.bind(this));
     // In C++ all variables in one declaration use the same type.
@@ -427,16 +686,41 @@ export default class Parser {
           throw new UnsupportedError(node, 'Can not declare a variable type as any');
         if (isTemplateFunctor(cppType))
           throw new UnsupportedError(node, 'Can not declare a variable with type of generic function');
+        this.typer.forbidUnpinnedCoroutineVariable(node, cppType);
+        let declaration: syntax.VariableDeclaration;
         if (node.initializer) {
           // let a = 123;
-          const initializer = this.parseExpression(node.initializer);
+          let initializer = this.parseExpression(node.initializer);
           if (isTemplateFunctor(initializer.type))
             throw new UnsupportedError(node, 'Can not assign a generic function to a variable');
-          return new syntax.VariableDeclaration(name.text, cppType, initializer);
+          if (initializer instanceof syntax.NewExpression &&
+              initializer.type.isObject() &&
+              cppType.equal(initializer.type) &&
+              this.typer.isNonEscapingAllocation(node)) {
+            // Put the object on stack if it never leaves the function.
+            initializer.storage = `_${name.text}_storage`;
+          } else if ((initializer instanceof syntax.NewExpression ||
+                      initializer instanceof syntax.ArrayLiteralExpression) &&
+                     initializer.type.isObject() &&
+                     this.typer.isScopedAllocation(node)) {
+            // Free the object when the allocation scope ends.
+            initializer = new syntax.ScopedAllocation(initializer);
+          }
+          declaration = new syntax.VariableDeclaration(name.text, cppType, initializer);
+          if (initializer instanceof syntax.FunctionExpression &&
+              declaration.initializer == initializer &&
+              this.typer.isKnownFunction(node)) {
+            // Keep the concrete function type so calls are direct.
+            initializer.isKnownType = true;
+            declaration.isKnownFunction = true;
+          }
         } else {
           // let a;
-          return new syntax.VariableDeclaration(name.text, cppType);
+          declaration = new syntax.VariableDeclaration(name.text, cppType);
         }
+        // Modified variables captured by closures live in GC cells.
+        declaration.isSharedCell = this.typer.needsSharedCell(node);
+        return declaration;
     }
     throw new UnimplementedError(node, 'Unsupported variable declaration');
   }
@@ -444,29 +728,38 @@ export default class Parser {
   parseFunctionDeclaration(node: ts.FunctionDeclaration): syntax.FunctionDeclaration {
     if (!node.name)
       throw new UnimplementedError(node, 'Empty function name is not supported');
-    if (node.asteriskToken)
-      throw new UnimplementedError(node, 'Generator is not supported');
     if (node.questionToken)
       throw new UnimplementedError(node, 'Question token in function is not supported');
     if (node.exclamationToken)
       throw new UnimplementedError(node, 'Exclamation token in function is not supported');
-    if (node.modifiers?.find(m => m.kind == ts.SyntaxKind.AsyncKeyword))
-      throw new UnimplementedError(node, 'Async function is not supported');
+    if (node.asteriskToken && isAsyncFunction(node))
+      throw new UnimplementedError(node, 'Async generator is not supported');
     if (!ts.isSourceFile(node.parent))
       throw new UnimplementedError(node, 'Local function declaration is not supported');
     const {body, name, parameters} = node;
     this.typer.forbidClosure(node);
+    const cppBody = body ? this.parseStatement(body) as syntax.Block : undefined;
+    // A C++ function is only a coroutine when it has co_yield, co_await or
+    // co_return.
+    if (cppBody && isCoroutineFunction(node) &&
+        !filterNode(body, (n) => ts.isYieldExpression(n) || ts.isAwaitExpression(n) || ts.isReturnStatement(n)).length) {
+      const statement = new syntax.ReturnStatement();
+      statement.isCoroutine = true;
+      cppBody.statements.push(statement);
+    }
+    const cppParameters = this.parseParameters(parameters);
+    cppBody?.statements.unshift(...syntax.ParameterDeclaration.createCells(cppParameters));
     return new syntax.FunctionDeclaration(this.typer.parseNodeType(node) as syntax.FunctionType,
                                           isExportedDeclaration(node),
                                           name.text,
-                                          this.parseParameters(parameters),
-                                          body ? this.parseStatement(body) as syntax.Block : undefined);
+                                          cppParameters,
+                                          cppBody);
   }
 
   parseFunctionExpression(node: ts.FunctionExpression | ts.ArrowFunction): syntax.FunctionExpression {
     const {body, parameters, modifiers, asteriskToken, exclamationToken, questionToken, typeParameters} = node;
     if (asteriskToken)
-      throw new UnimplementedError(node, 'Generator is not supported');
+      throw new UnimplementedError(node, 'Generator function expression is not supported');
     if (questionToken)
       throw new UnimplementedError(node, 'Question token in function is not supported');
     if (exclamationToken)
@@ -474,7 +767,7 @@ export default class Parser {
     if (typeParameters)
       throw new UnimplementedError(node, 'Generic function is not supported');
     if (modifiers?.find(m => m.kind == ts.SyntaxKind.AsyncKeyword))
-      throw new UnimplementedError(node, 'Async function is not supported');
+      throw new UnimplementedError(node, 'Async function expression is not supported');
     let cppBody: undefined | syntax.Block;
     if (body) {
       if (ts.isBlock(body)) {
@@ -486,11 +779,16 @@ export default class Parser {
         ]);
       }
     }
-    const closure = this.typer.getCapturedIdentifiers(node)
-                              .map(n => this.parseExpression(n))
-                              .filter(e => e.type.hasObject());
+    const cppParameters = this.parseParameters(parameters);
+    cppBody?.statements.unshift(...syntax.ParameterDeclaration.createCells(cppParameters));
+    const captures = this.typer.getClosureCaptures(node);
+    // The objects copied into the lambda must be traced by the closure.
+    const closure = captures.filter(c => c.mode == 'value')
+                            .map(c => this.parseExpression(c.node))
+                            .filter(e => e.type.hasObject());
     return new syntax.FunctionExpression(this.typer.parseNodeType(node) as syntax.FunctionType,
-                                         parameters.map(this.parseParameterDeclaration.bind(this)),
+                                         cppParameters,
+                                         captures.map(({node, mode, forwardCell}) => ({name: node.getText(), mode, forwardCell})),
                                          closure,
                                          cppBody);
   }
@@ -506,9 +804,14 @@ export default class Parser {
     const cppType = this.typer.parseNodeType(name);
     if (cppType.category == 'any')
       throw new UnsupportedError(node, 'Can not declare parameter type as any');
-    return new syntax.ParameterDeclaration(name.text,
-                                           cppType,
-                                           initializer ? this.parseExpression(initializer) : undefined);
+    this.typer.forbidUnpinnedCoroutineVariable(node, cppType);
+    // The type of parameter stored in GC cell is the cell's value type.
+    const declaration = new syntax.ParameterDeclaration(name.text,
+                                                       cppType.noProperty(),
+                                                       initializer ? this.parseExpression(initializer) : undefined);
+    declaration.isReadOnly = this.typer.isReadOnlyParameter(node);
+    declaration.isSharedCell = this.typer.needsSharedCell(node);
+    return declaration;
   }
 
   parseClassDeclaration(node: ts.ClassDeclaration): syntax.ClassDeclaration {
@@ -518,7 +821,8 @@ export default class Parser {
     const cppMembers = members.map(this.parseClassElement.bind(this, node));
     const classDeclaration = new syntax.ClassDeclaration(this.typer.parseNodeType(node),
                                                          isExportedDeclaration(node),
-                                                         cppMembers);
+                                                         cppMembers,
+                                                         !this.typer.subclassedClasses.has(node));
     cppMembers.forEach(m => m.classDeclaration = classDeclaration);
     return classDeclaration;
   }
@@ -542,31 +846,40 @@ export default class Parser {
       }
       case ts.SyntaxKind.MethodDeclaration: {
         // method() { xxx }
-        const {modifiers, name, body, parameters, questionToken, typeParameters} = node as ts.MethodDeclaration;
+        const {modifiers, name, body, parameters, asteriskToken, questionToken, typeParameters} = node as ts.MethodDeclaration;
         if (!ts.isIdentifier(name))
           throw new UnsupportedError(name, 'Only identifier can be used as method name');
+        if (asteriskToken)
+          throw new UnimplementedError(node, 'Generator method is not supported');
         if (questionToken)
           throw new UnsupportedError(name, 'Can not use question token in method');
         if (typeParameters)
           throw new UnimplementedError(name, 'Generic method is not supported');
         if (modifiers?.find(m => m.kind == ts.SyntaxKind.AsyncKeyword))
-          throw new UnimplementedError(node, 'Async function is not supported');
+          throw new UnimplementedError(node, 'Async method is not supported');
         this.typer.forbidClosure(node as ts.MethodDeclaration);
         const cppModifiers = modifiers?.map(modifierToString) ?? [];
         cppModifiers.push(...parseHint(node));
-        // In TypeScript every method is "virtual", while it is possible to
-        // lookup all derived classes to decide whether to make the method
-        // virtual, it is not worth the efforts.
+        // In TypeScript every method is "virtual", but in C++ it only needs to
+        // be when derived classes override it.
         if (!cppModifiers.includes('static') &&
-            !cppModifiers.includes('override') &&
             !cppModifiers.includes('destructor')) {
-          cppModifiers.push('virtual');
+          const method = node as ts.MethodDeclaration;
+          if (this.typer.overridingMethods.has(method)) {
+            if (!cppModifiers.includes('override'))
+              cppModifiers.push('override');
+          } else if (this.typer.overriddenMethods.has(method)) {
+            cppModifiers.push('virtual');
+          }
         }
+        const cppParameters = this.parseParameters(parameters);
+        const cppBody = body ? this.parseStatement(body) as syntax.Block : undefined;
+        cppBody?.statements.unshift(...syntax.ParameterDeclaration.createCells(cppParameters));
         return new syntax.MethodDeclaration(this.typer.parseNodeType(node) as syntax.FunctionType,
                                             name.text,
                                             cppModifiers,
-                                            this.parseParameters(parameters),
-                                            body ? this.parseStatement(body) as syntax.Block : undefined);
+                                            cppParameters,
+                                            cppBody);
       }
       case ts.SyntaxKind.SemicolonClassElement:
         return new syntax.SemicolonClassElement();
@@ -596,13 +909,20 @@ export default class Parser {
         throw new UnimplementedError(superCall[1], 'The super call can only be called once');
       }
     }
+    const cppParameters = this.parseParameters(parameters);
+    const cppBody = body ? this.parseStatement(body) as syntax.Block : undefined;
+    cppBody?.statements.unshift(...syntax.ParameterDeclaration.createCells(cppParameters));
     return new syntax.ConstructorDeclaration(classDeclaration.name!.text,
-                                             this.parseParameters(parameters),
-                                             body ? this.parseStatement(body) as syntax.Block : undefined,
+                                             cppParameters,
+                                             cppBody,
                                              baseCall);
   }
 
-  parseObjectLiteral(node: ts.ObjectLiteralExpression): syntax.ObjectLiteral {
+  parseObjectLiteral(node: ts.ObjectLiteralExpression): syntax.Expression {
+    // Object literals assigned to records create dictionaries.
+    const contextualType = this.typer.typeChecker.getContextualType(node);
+    if (contextualType && this.typer.isRecordType(contextualType))
+      return this.parseRecordLiteral(node, contextualType);
     const initializers = new Map<string, syntax.Expression>();
     for (const element of node.properties) {
       if (ts.isMethodDeclaration(element))
@@ -617,6 +937,29 @@ export default class Parser {
                                     initializers);
   }
 
+  parseRecordLiteral(node: ts.ObjectLiteralExpression, type: ts.Type): syntax.RecordLiteral {
+    const entries: [ string, syntax.Expression ][] = [];
+    for (const element of node.properties) {
+      if (!ts.isPropertyAssignment(element))
+        throw new UnsupportedError(element, 'Unsupported property type');
+      if (!ts.isIdentifier(element.name) && !ts.isStringLiteral(element.name))
+        throw new UnsupportedError(element, 'Unsupported property name');
+      entries.push([ element.name.text, this.parseExpression(element.initializer) ]);
+    }
+    return new syntax.RecordLiteral(this.typer.parseTypeWithNode(type, node), entries);
+  }
+
+  parseRecordAccess(node: ts.ElementAccessExpression | ts.PropertyAccessExpression,
+                    obj: syntax.Expression,
+                    key: syntax.Expression): syntax.RecordAccessExpression {
+    if (key.type.category != 'string')
+      throw new UnimplementedError(node, 'Only string keys can be used to access records');
+    return new syntax.RecordAccessExpression(this.typer.parseNodeType(node),
+                                             obj,
+                                             key,
+                                             isAssignmentTarget(node) ? 'at' : 'get');
+  }
+
   parsePropertyAccessExpression(node: ts.PropertyAccessExpression): syntax.Expression {
     const {expression, name, questionDotToken} = node;
     if (questionDotToken)
@@ -638,6 +981,7 @@ export default class Parser {
     // for all types yet.
     const obj = this.parseExpression(expression);
     if (!obj.type.isObject() &&
+        obj.type.category != 'interface' &&
         obj.type.category != 'string' &&
         obj.type.category != 'namespace' &&
         obj.type.category != 'union') {
@@ -645,15 +989,54 @@ export default class Parser {
     }
     if (name.text == '__proto__')
       throw new UnsupportedError(node, 'Can not access prototype of object');
-    return new syntax.PropertyAccessExpression(this.typer.parseNodeType(node),
-                                               obj,
-                                               name.text);
+    if (isBuiltinGeneratorType(this.typer.typeChecker.getTypeAtLocation(expression)))
+      throw new UnimplementedError(node, 'Generators can only be iterated with for...of loop');
+    if (isBuiltinPromiseType(this.typer.typeChecker.getTypeAtLocation(expression)))
+      throw new UnimplementedError(node, 'Promises can only be used with await');
+    if (obj.type.isRecord())
+      return this.parseRecordAccess(node, obj, new syntax.StringLiteral(name.text));
+    // The delete method of Map and Set is named erase in C++.
+    let member = name.text;
+    if (member == 'delete' &&
+        isBuiltinCollectionType(this.typer.typeChecker.getTypeAtLocation(expression)))
+      member = 'erase';
+    const access = new syntax.PropertyAccessExpression(this.typer.parseNodeType(node),
+                                                       obj,
+                                                       member);
+    if (obj.type.category == 'union') {
+      const base = this.typer.getCommonBaseClass(node);
+      if (base)
+        access.commonBase = this.typer.parseNodeType(base);
+    }
+    return access;
   }
 
   parseCallExpression(node: ts.CallExpression): syntax.Expression {
     const {expression, questionDotToken} = node;
     if (questionDotToken)
       throw new UnimplementedError(node, 'The ?. operator is not supported');
+    if (ts.isPropertyAccessExpression(expression) &&
+        this.typer.isObjectConstructor(expression.expression))
+      return this.parseObjectConstructorCall(node, expression.name.text);
+    if (ts.isPropertyAccessExpression(expression) &&
+        this.typer.isPromiseConstructor(expression.expression))
+      return this.parsePromiseConstructorCall(node, expression.name.text);
+    if (ts.isPropertyAccessExpression(expression) &&
+        this.typer.isJSON(expression.expression))
+      return this.parseJSONCall(node, expression.name.text);
+    if (this.typer.isTimerFunction(expression))
+      return this.parseTimerCall(node, expression.text);
+    const fsFunction = this.typer.getModuleFunctionName(expression, 'fs');
+    if (fsFunction)
+      return this.parseFsCall(node, fsFunction);
+    const readlineFunction = this.typer.getModuleFunctionName(expression, 'readline');
+    if (readlineFunction)
+      return this.parseReadlineCall(node, readlineFunction);
+    // The tuple returned by process.hrtime() is not supported.
+    if (ts.isPropertyAccessExpression(expression) &&
+        expression.name.text == 'hrtime' &&
+        this.typer.parseNodeType(expression).name == 'HRTime')
+      throw new UnimplementedError(node, 'Only process.hrtime.bigint() is supported');
     const type = this.typer.parseNodeType(node);
     const callee = this.parseExpression(expression);
     const args = this.parseArguments(node, node['arguments']);
@@ -674,6 +1057,233 @@ export default class Parser {
       return new syntax.CallExpression(type, callee, args);
   }
 
+  parseObjectConstructorCall(node: ts.CallExpression, method: string): syntax.Expression {
+    // The properties of other objects are not known at runtime, so only the
+    // records can be enumerated.
+    if (method != 'keys' && method != 'values')
+      throw new UnimplementedError(node, `Object.${method} is not supported`);
+    const args = node.arguments.map(this.parseExpression.bind(this));
+    if (args.length != 1 || !args[0].type.isRecord())
+      throw new UnimplementedError(node, `Object.${method} only supports records`);
+    const type = this.typer.parseNodeType(node);
+    const parameters = [ args[0].type ];
+    const callee = new syntax.Identifier(new syntax.FunctionType('function', type, parameters),
+                                         method,
+                                         'compilets::ObjectConstructor');
+    return new syntax.CallExpression(type, callee, new syntax.CallArguments(args, parameters));
+  }
+
+  parsePromiseConstructor(node: ts.NewExpression): syntax.Expression {
+    // Only the executor taking the resolve function is supported, which is
+    // typed by itself as the parameters of Promise constructor include any.
+    const executor = node.arguments?.[0];
+    if (!executor || (!ts.isArrowFunction(executor) && !ts.isFunctionExpression(executor)))
+      throw new UnimplementedError(node, 'The executor of Promise must be a function expression');
+    if (executor.parameters.length > 1)
+      throw new UnimplementedError(executor, 'Rejecting promises is not supported');
+    const cppExecutor = this.parseExpression(executor);
+    return new syntax.NewExpression(this.typer.parseNodeType(node),
+                                    new syntax.CallArguments([ cppExecutor ], [ cppExecutor.type ]));
+  }
+
+  parsePromiseConstructorCall(node: ts.CallExpression, method: string): syntax.Expression {
+    if (method != 'resolve')
+      throw new UnimplementedError(node, `Promise.${method} is not supported`);
+    if (node.arguments.length > 0 &&
+        isBuiltinPromiseType(this.typer.typeChecker.getTypeAtLocation(node.arguments[0])))
+      throw new UnimplementedError(node, 'Resolving with a promise is not supported');
+    const type = this.typer.parseNodeType(node);
+    const valueType = type.templateArguments![0];
+    const args = node.arguments.map(this.parseExpression.bind(this));
+    const callee = new syntax.Identifier(new syntax.FunctionType('function', type, args.map(() => valueType)),
+                                         method,
+                                         'compilets::PromiseConstructor');
+    callee.type.templateArguments = [ valueType ];
+    return new syntax.CallExpression(type, callee, new syntax.CallArguments(args, args.map(() => valueType)));
+  }
+
+  parseJSONCall(node: ts.CallExpression, method: string): syntax.Expression {
+    const args = node.arguments.map(this.parseExpression.bind(this));
+    let type: syntax.Type;
+    let valueType: syntax.Type;
+    if (method == 'parse') {
+      if (args.length != 1 || args[0].type.category != 'string')
+        throw new UnimplementedError(node, 'The JSON.parse only accepts a string without reviver');
+      // The result is typed by the context, like "JSON.parse(text) as Type"
+      // or the type annotation of the variable it is assigned to.
+      const contextualType = this.typer.typeChecker.getContextualType(node);
+      if (!contextualType || (contextualType.getFlags() & (ts.TypeFlags.Any | ts.TypeFlags.Unknown)))
+        throw new UnimplementedError(node, 'The type of the result of JSON.parse must be specified');
+      type = this.typer.parseType(contextualType, node);
+      valueType = args[0].type;
+    } else if (method == 'stringify') {
+      if (args.length != 1)
+        throw new UnimplementedError(node, 'The JSON.stringify does not support replacer or indentation');
+      type = syntax.Type.createStringType();
+      valueType = args[0].type;
+    } else {
+      throw new UnimplementedError(node, `JSON.${method} is not supported`);
+    }
+    this.markJSONType(node, method == 'parse' ? type : valueType);
+    const callee = new syntax.Identifier(new syntax.FunctionType('function', type, [ valueType ]),
+                                         method,
+                                         'compilets::JSON');
+    callee.type.name = method;
+    callee.type.namespace = 'compilets::JSON';
+    if (method == 'parse')
+      callee.type.templateArguments = [ type ];
+    return new syntax.CallExpression(type, callee, new syntax.CallArguments(args, [ valueType ]));
+  }
+
+  /**
+   * Check that the type can be converted from and to JSON, and generate the
+   * methods required by the JSON runtime for the interfaces it contains.
+   */
+  markJSONType(node: ts.Node, type: syntax.Type) {
+    if (type.category == 'string' ||
+        (type.category == 'primitive' && (type.name == 'double' || type.name == 'bool')))
+      return;
+    if (type.category == 'array')
+      return this.markJSONType(node, type.getElementType());
+    if (type.category == 'interface') {
+      const {fileName} = node.getSourceFile();
+      let marked = this.typer.jsonInterfaces.get(fileName);
+      if (!marked)
+        this.typer.jsonInterfaces.set(fileName, marked = new Set<string>());
+      if (marked.has(type.name))
+        return;
+      marked.add(type.name);
+      const interfaceType = this.typer.interfaceRegistry.get(type.name);
+      interfaceType.usesJSON = true;
+      for (const property of interfaceType.properties.values())
+        this.markJSONType(node, property);
+      return;
+    }
+    throw new UnimplementedError(node, `The type "${type.name}" can not be converted from or to JSON`);
+  }
+
+  parseTimerCall(node: ts.CallExpression, name: string): syntax.Expression {
+    // The timers run in the event loop of executables, while native modules
+    // only get promises through the microtasks of V8. Files that are not
+    // executables are linked into the native module when there is one.
+    const fileName = path.relative(this.project.rootDir, node.getSourceFile().fileName);
+    if (this.project.mainFileName && this.project.getFileType(fileName) != 'exe')
+      throw new UnimplementedError(node, `The ${name} is not supported in native modules`);
+    const args = node.arguments.map(this.parseExpression.bind(this));
+    let parameters: syntax.Type[];
+    if (name == 'setTimeout' || name == 'setInterval') {
+      // setTimeout(callback, delay)
+      if (args.length == 0 || args.length > 2)
+        throw new UnimplementedError(node, `Passing arguments to the callback of ${name} is not supported`);
+      // The resolve function of Promise<void> takes a void parameter.
+      const callback = args[0].type;
+      if (!(callback instanceof syntax.FunctionType) || callback.parameters.some(p => p.category != 'void'))
+        throw new UnimplementedError(node, `The callback of ${name} must be a function without parameters`);
+      parameters = [ callback, syntax.Type.createNumberType() ];
+    } else {
+      // clearTimeout(timeout)
+      if (args.length != 1 || args[0].type.name != 'Timeout')
+        throw new UnimplementedError(node, `The ${name} only accepts the object returned by timer functions`);
+      parameters = [ args[0].type ];
+    }
+    const type = this.typer.parseNodeType(node);
+    const callee = new syntax.Identifier(new syntax.FunctionType('function', type, parameters),
+                                         name,
+                                         'compilets::nodejs');
+    callee.type.name = name;
+    callee.type.namespace = 'compilets::nodejs';
+    return new syntax.CallExpression(type, callee, new syntax.CallArguments(args, parameters.slice(0, args.length)));
+  }
+
+  parseFsCall(node: ts.CallExpression, name: string): syntax.Expression {
+    const args = node.arguments.map(this.parseExpression.bind(this));
+    const isString = (arg: syntax.Expression) => arg.type.category == 'string';
+    const isNumber = (arg: syntax.Expression) => arg.type.name == 'double';
+    const isBuffer = (arg: syntax.Expression) => arg.type.name == 'Buffer' && arg.type.namespace == 'compilets::nodejs';
+    let valid: boolean;
+    switch (name) {
+      case 'readFileSync':
+        // readFileSync(path, 'utf8')
+        if (args.length == 2) {
+          const encoding = node.arguments[1];
+          if (!ts.isStringLiteral(encoding) || ![ 'utf8', 'utf-8' ].includes(encoding.text))
+            throw new UnimplementedError(node, 'The encoding of readFileSync can only be "utf8"');
+        }
+        valid = (args.length == 1 || args.length == 2) && isString(args[0]);
+        break;
+      case 'writeFileSync':
+        valid = args.length == 2 && isString(args[0]) &&
+                (isString(args[1]) || isBuffer(args[1]));
+        break;
+      case 'readdirSync':
+      case 'existsSync':
+        valid = args.length == 1 && isString(args[0]);
+        break;
+      case 'openSync':
+        valid = (args.length == 1 || args.length == 2) && args.every(isString);
+        break;
+      case 'readSync':
+        // readSync(fd, buffer, offset?, length?, position?)
+        valid = [ 2, 4, 5 ].includes(args.length) && isNumber(args[0]) && isBuffer(args[1]) &&
+                args.slice(2).every(isNumber);
+        break;
+      case 'closeSync':
+        valid = args.length == 1 && isNumber(args[0]);
+        break;
+      default:
+        throw new UnimplementedError(node, `The fs.${name} is not supported`);
+    }
+    if (!valid)
+      throw new UnimplementedError(node, `Unsupported arguments for fs.${name}`);
+    const type = this.typer.parseNodeType(node);
+    const parameters = args.map(a => a.type);
+    const callee = new syntax.Identifier(new syntax.FunctionType('function', type, parameters),
+                                         name,
+                                         'compilets::nodejs::fs');
+    callee.type.name = name;
+    callee.type.namespace = 'compilets::nodejs::fs';
+    return new syntax.CallExpression(type, callee, new syntax.CallArguments(args, parameters));
+  }
+
+  parseReadlineCall(node: ts.CallExpression, name: string): syntax.Expression {
+    if (name != 'createInterface')
+      throw new UnimplementedError(node, `The readline.${name} is not supported`);
+    // createInterface(process.stdin) or createInterface({input: process.stdin})
+    let input: ts.Expression | undefined = node.arguments[0];
+    if (input && ts.isObjectLiteralExpression(input)) {
+      input = undefined;
+      for (const property of (node.arguments[0] as ts.ObjectLiteralExpression).properties) {
+        if (!ts.isPropertyAssignment(property) || !ts.isIdentifier(property.name))
+          throw new UnimplementedError(property, 'The options of readline.createInterface must be property assignments');
+        switch (property.name.text) {
+          case 'input':
+            input = property.initializer;
+            break;
+          // The "\r\n" is always read as one line break, and stdin is never
+          // treated as a terminal.
+          case 'crlfDelay':
+          case 'terminal':
+            break;
+          default:
+            throw new UnimplementedError(property, `The option "${property.name.text}" of readline.createInterface is not supported`);
+        }
+      }
+    }
+    if (node.arguments.length != 1 ||
+        !input ||
+        !ts.isPropertyAccessExpression(input) ||
+        input.name.text != 'stdin' ||
+        this.typer.parseNodeType(input.expression).name != 'Process')
+      throw new UnimplementedError(node, 'The readline.createInterface only supports reading from process.stdin');
+    const type = this.typer.parseNodeType(node);
+    const callee = new syntax.Identifier(new syntax.FunctionType('function', type, []),
+                                         name,
+                                         'compilets::nodejs::readline');
+    callee.type.name = name;
+    callee.type.namespace = 'compilets::nodejs::readline';
+    return new syntax.CallExpression(type, callee, new syntax.CallArguments([], []));
+  }
+
   parseArguments(node: ts.CallLikeExpression,
                  args?: ts.NodeArray<ts.Expression>): syntax.CallArguments {
     if (!args)
@@ -12,7 +12,10 @@ export type PrintMode = 'impl' | 'header' | 'forward';
  */
 export type Feature = 'string' | 'union' | 'array' | 'function' | 'object' |
                       'converters' | 'runtime' | 'type-traits' | 'process' |
-                      'console' | 'math' | 'number';
+                      'console' | 'math' | 'number' | 'map' | 'set' |
+                      'record' | 'generator' | 'promise' | 'timers' |
+                      'array-buffer' | 'buffer' | 'fs' | 'readline' |
+                      'json' | 'allocation-scope';
 
 /**
  * Control indentation and other formating options when printing AST to C++.
@@ -151,7 +154,8 @@ export function printClassDeclaration(decl: syntax.ClassDeclaration, ctx: PrintC
   }
   // Print class name and inheritance.
   const base = decl.type.base ? printTypeName(decl.type.base, ctx) : 'compilets::Object';
-  let result = `${ctx.prefix}class ${decl.name} : public ${base} {\n`;
+  const final = decl.isFinal ? ' final' : '';
+  let result = `${ctx.prefix}class ${decl.name}${final} : public ${base} {\n`;
   if (templateDeclaration)
     result = ctx.prefix + templateDeclaration + '\n' + result;
   // Indent for class content.
@@ -204,13 +208,18 @@ export function printClassDeclaration(decl: syntax.ClassDeclaration, ctx: PrintC
  */
 export function printInterfaceBinding(type: syntax.InterfaceType, ctx: PrintContext) {
   const properties = Array.from(type.properties.keys());
-  const setProps = properties.map(prop => `, "${prop}", obj->${prop}`);
-  const getProps = properties.map(prop => `, "${prop}", &obj->${prop}`);
+  // Value types are converted by copying the struct.
+  const [ cppType, dot, create ] = type.isValueType ?
+    [ type.name, '.', `${type.name} obj;` ] :
+    [ `${type.name}*`, '->', `${type.name}* obj = compilets::MakeObject<${type.name}>();` ];
+  const param = type.isValueType ? `const ${type.name}& obj` : `const ${type.name}* obj`;
+  const setProps = properties.map(prop => `, "${prop}", obj${dot}${prop}`);
+  const getProps = properties.map(prop => `, "${prop}", &obj${dot}${prop}`);
   return `template<>
-struct Type<${type.name}*> {
+struct Type<${cppType}> {
   static constexpr const char* name = "${type.name}";
 
-  static napi_status ToNode(napi_env env, const ${type.name}* obj, napi_value* result) {
+  static napi_status ToNode(napi_env env, ${param}, napi_value* result) {
     napi_status s = napi_create_object(env, result);
     if (s != napi_ok)
       return s;
@@ -219,8 +228,8 @@ struct Type<${type.name}*> {
     return napi_ok;
   }
 
-  static std::optional<${type.name}*> FromNode(napi_env env, napi_value value) {
-    ${type.name}* obj = compilets::MakeObject<${type.name}>();
+  static std::optional<${cppType}> FromNode(napi_env env, napi_value value) {
+    ${create}
     if (!ki::Get(env, value${getProps.join('')}))
       return std::nullopt;
     return obj;
@@ -360,9 +369,9 @@ export function printTypeName(type: Type, ctx: PrintContext): string {
   if (type.category == 'class' && type.templateArguments) {
     name += printTemplateArguments(type.templateArguments, ctx);
   }
-  // Add optional when needed.
+  // Add optional when needed, numbers get the compact representation.
   if (type.isStdOptional()) {
-    return `std::optional<${name}>`;
+    return `compilets::Optional<${name}>`;
   }
   return name;
 }
@@ -0,0 +1,325 @@
+import fs from 'fs-extra';
+import path from 'node:path';
+import crypto from 'node:crypto';
+import * as ts from 'typescript';
+
+import CppProject from './cpp-project';
+import Typer from './parser-typer';
+import {CppFileType} from './cpp-file';
+import {PrintContext} from './print-utils';
+
+/**
+ * The saved translation of a TypeScript file.
+ */
+interface CacheEntry {
+  // Hash of the file and all the files it depends on.
+  key: string;
+  // The result of Typer.getReferenceInterfaces for the file.
+  referenceInterfaces: string[];
+  header?: string;
+  impl?: string;
+  // The interfaces used by the printed code, and the hash of them.
+  interfaces?: string[];
+  interfacesKey?: string;
+  // The interfaces converted from or to JSON by the file.
+  jsonInterfaces?: string[];
+}
+
+interface CacheData {
+  // Hash of the translator and the project configurations, the whole cache is
+  // dropped when it changes.
+  configKey: string;
+  // Hash of the results of the program-wide analyses, the translations are
+  // dropped when it changes.
+  analysesKey?: string;
+  // The serialized InterfaceRegistry.
+  interfaces?: string;
+  files: Record<string, CacheEntry>;
+}
+
+/**
+ * A file whose printed code is reused from last generation.
+ */
+export class PrintedFile {
+  name: string;
+  type: CppFileType;
+  header?: string;
+  impl: string;
+  interfaces: string[];
+  interfacesKey: string;
+
+  constructor(name: string, type: CppFileType, entry: Required<CacheEntry>) {
+    this.name = name;
+    this.type = type;
+    this.header = entry.header;
+    this.impl = entry.impl;
+    this.interfaces = entry.interfaces;
+    this.interfacesKey = entry.interfacesKey;
+  }
+
+  hasExports(): boolean {
+    return this.header !== undefined;
+  }
+
+  print(ctx: PrintContext): string {
+    return ctx.mode == 'header' ? this.header! : this.impl;
+  }
+}
+
+/**
+ * Persistent cache of translations, so unchanged files are not translated
+ * again on each generation.
+ *
+ * A file's translation is reused when neither the file nor any file it
+ * depends on has changed, and the program-wide analyses (the reference
+ * interfaces and class hierarchy) give the same results. As interfaces are
+ * shared between files, the InterfaceRegistry is also saved so interfaces keep
+ * their names, and a file is translated again when the interfaces it uses have
+ * been changed by other files.
+ *
+ * The type checking is made incremental by TypeScript's own .tsbuildinfo.
+ */
+export default class TranslationCache {
+  dir: string;
+
+  private project: CppProject;
+  private data: CacheData;
+  private builder?: ts.EmitAndSemanticDiagnosticsBuilderProgram;
+  private typer?: Typer;
+  // Results of this generation, which will be saved.
+  private analysesKey?: string;
+  private files: Record<string, CacheEntry> = {};
+  // Cached hashes of source files.
+  private hashes = new Map<string, string>();
+
+  /**
+   * The `builder` can be passed when the program is managed by others, for
+   * example by the watch mode.
+   */
+  constructor(project: CppProject,
+              dir: string,
+              builder?: ts.EmitAndSemanticDiagnosticsBuilderProgram) {
+    this.dir = dir;
+    this.project = project;
+    this.builder = builder;
+    const configKey = hash(getTranslatorKey(), JSON.stringify([
+      project.rootDir,
+      project.sourceRootDir,
+      project.fileNames,
+      project.compilerOptions,
+      project.mainFileName,
+      project.executables,
+    ]));
+    this.data = {configKey, files: {}};
+    try {
+      const data = fs.readJsonSync(`${dir}/cache.json`);
+      if (data.configKey == configKey)
+        this.data = data;
+    } catch {}
+  }
+
+  /**
+   * Create the TypeScript program, which reuses the type checking results of
+   * last generation.
+   */
+  createProgram(): ts.Program {
+    this.builder ??= ts.createIncrementalProgram({
+      rootNames: this.project.fileNames,
+      options: this.getCompilerOptions(),
+    });
+    return this.builder.getProgram();
+  }
+
+  /**
+   * Return the options for creating incremental program.
+   */
+  getCompilerOptions(): ts.CompilerOptions {
+    return {
+      ...this.project.compilerOptions,
+      noEmit: true,
+      incremental: true,
+      tsBuildInfoFile: `${this.dir}/.tsbuildinfo`,
+    };
+  }
+
+  /**
+   * Same with ts.getPreEmitDiagnostics, but unchanged files are not checked
+   * again.
+   */
+  getPreEmitDiagnostics(): readonly ts.Diagnostic[] {
+    const builder = this.builder!;
+    const diagnostics = ts.sortAndDeduplicateDiagnostics([
+      ...builder.getConfigFileParsingDiagnostics(),
+      ...builder.getOptionsDiagnostics(),
+      ...builder.getSyntacticDiagnostics(),
+      ...builder.getGlobalDiagnostics(),
+      ...builder.getSemanticDiagnostics(),
+    ]);
+    return diagnostics;
+  }
+
+  /**
+   * Like Typer.collectReferenceInterfaces, but reuse the results of unchanged
+   * files.
+   */
+  collectReferenceInterfaces(typer: Typer, sourceFiles: readonly ts.SourceFile[]) {
+    this.typer = typer;
+    for (const sourceFile of sourceFiles) {
+      const name = this.getCppName(sourceFile.fileName);
+      const key = this.getFileKey(sourceFile);
+      const entry = this.data.files[name];
+      const referenceInterfaces = entry?.key == key ?
+        entry.referenceInterfaces :
+        Array.from(typer.getReferenceInterfaces(sourceFile));
+      for (const signature of referenceInterfaces)
+        typer.referenceInterfaces.add(signature);
+      this.files[name] = {key, referenceInterfaces};
+    }
+  }
+
+  /**
+   * Return the files whose translations can be reused.
+   *
+   * Must be called after the program-wide analyses are done.
+   */
+  getPrintedFiles(sourceFiles: readonly ts.SourceFile[]): Map<ts.SourceFile, PrintedFile> {
+    const typer = this.typer!;
+    const result = new Map<ts.SourceFile, PrintedFile>();
+    // Changes to global declarations can affect any file.
+    const program = this.builder!.getProgram();
+    const globalFiles = program.getSourceFiles().filter(f => !ts.isExternalModule(f) &&
+                                                             !program.isSourceFileDefaultLibrary(f));
+    const describe = (node: ts.ClassDeclaration | ts.MethodDeclaration): string => {
+      if (ts.isMethodDeclaration(node))
+        return `${describe(node.parent as ts.ClassDeclaration)}.${node.name.getText()}`;
+      return `${node.getSourceFile().fileName}:${node.name?.text}`;
+    };
+    this.analysesKey = hash(
+      ...globalFiles.map(f => this.getSourceFileHash(f)),
+      ...Array.from(typer.referenceInterfaces).sort(),
+      ...Array.from(typer.subclassedClasses, describe).sort(),
+      ...Array.from(typer.overriddenMethods, describe).sort(),
+      ...Array.from(typer.overridingMethods, describe).sort());
+    if (this.analysesKey != this.data.analysesKey || !this.data.interfaces)
+      return result;
+    const reused = new Map<ts.SourceFile, CacheEntry>();
+    for (const sourceFile of sourceFiles) {
+      const name = this.getCppName(sourceFile.fileName);
+      const entry = this.data.files[name];
+      if (entry?.key == this.files[name].key && entry.impl !== undefined)
+        reused.set(sourceFile, entry);
+    }
+    // Keep names of interfaces used by the reused translations, and drop the
+    // ones only used by the files translated again.
+    const names = new Set<string>();
+    for (const entry of reused.values()) {
+      for (const name of [...entry.interfaces ?? [], ...entry.jsonInterfaces ?? []])
+        names.add(name);
+    }
+    typer.interfaceRegistry.restore(this.data.interfaces, names);
+    for (const [sourceFile, entry] of reused) {
+      // The reused files still convert their interfaces from or to JSON.
+      const jsonInterfaces = new Set(entry.jsonInterfaces);
+      for (const name of jsonInterfaces)
+        typer.interfaceRegistry.get(name).usesJSON = true;
+      typer.jsonInterfaces.set(sourceFile.fileName, jsonInterfaces);
+      const name = this.getCppName(sourceFile.fileName);
+      const type = this.project.getFileType(path.relative(this.project.rootDir, sourceFile.fileName));
+      result.set(sourceFile, new PrintedFile(name, type, entry as Required<CacheEntry>));
+    }
+    return result;
+  }
+
+  /**
+   * Return whether the interfaces used by the file have not been changed.
+   */
+  isUpToDate(file: PrintedFile): boolean {
+    return file.interfacesKey == this.getInterfacesKey(file.interfaces);
+  }
+
+  /**
+   * Save the printed code of a file in this generation.
+   */
+  setPrintedFile(fileName: string, content: string) {
+    const entry = this.files[fileName.replace(/\.(h|cpp)$/, '')];
+    if (!entry)
+      return;
+    if (fileName.endsWith('.h'))
+      entry.header = content;
+    else
+      entry.impl = content;
+  }
+
+  /**
+   * Write the cache to disk.
+   */
+  async save() {
+    // With noEmit only the .tsbuildinfo file is written, which also records
+    // the type checking results if the diagnostics were requested.
+    this.builder?.emit();
+    const registry = this.typer!.interfaceRegistry;
+    for (const [fileName, names] of this.typer!.jsonInterfaces) {
+      const entry = this.files[this.getCppName(fileName)];
+      if (entry)
+        entry.jsonInterfaces = Array.from(names);
+    }
+    for (const entry of Object.values(this.files)) {
+      // Find the interfaces used by the printed code.
+      const code = (entry.header ?? '') + (entry.impl ?? '');
+      entry.interfaces = Array.from(new Set(code.match(/\bInterface\d+\b/g)));
+      entry.interfacesKey = this.getInterfacesKey(entry.interfaces);
+    }
+    const data: CacheData = {
+      configKey: this.data.configKey,
+      analysesKey: this.analysesKey,
+      interfaces: registry.serialize(),
+      files: this.files,
+    };
+    await fs.outputJson(`${this.dir}/cache.json`, data);
+  }
+
+  private getCppName(fileName: string): string {
+    return path.relative(this.project.rootDir, fileName).replace(/\.ts$/, '');
+  }
+
+  private getFileKey(sourceFile: ts.SourceFile): string {
+    const program = this.builder!.getProgram();
+    const dependencies = this.builder!.getAllDependencies(sourceFile);
+    return hash(this.getSourceFileHash(sourceFile),
+                ...dependencies.map(f => {
+                  const dependency = program.getSourceFile(f);
+                  return dependency ? this.getSourceFileHash(dependency) : f;
+                }));
+  }
+
+  private getSourceFileHash(sourceFile: ts.SourceFile): string {
+    let result = this.hashes.get(sourceFile.fileName);
+    if (!result) {
+      result = hash(sourceFile.fileName, sourceFile.text);
+      this.hashes.set(sourceFile.fileName, result);
+    }
+    return result;
+  }
+
+  private getInterfacesKey(names: string[]): string {
+    return hash(this.typer!.interfaceRegistry.serialize(new Set(names)));
+  }
+}
+
+// Return the hash of the strings.
+function hash(...contents: string[]): string {
+  const result = crypto.createHash('sha256');
+  for (const content of contents)
+    result.update(content).update('\0');
+  return result.digest('hex');
+}
+
+// The translation changes with the code of translator.
+let translatorKey: string | undefined;
+function getTranslatorKey(): string {
+  if (!translatorKey) {
+    const files = fs.readdirSync(__dirname).filter(f => /\.(js|ts)$/.test(f)).sort();
+    translatorKey = hash(...files.map(f => fs.readFileSync(`${__dirname}/${f}`).toString()));
+  }
+  return translatorKey;
+}
@@ -18,6 +18,12 @@ function testDir(root: string) {
   const project = new CppProject(root);
   // Parse the TypeScript files.
   const parser = new Parser(project);
+  // The error.txt file contains the error expected for unsupported code.
+  if (fs.existsSync(`${root}/error.txt`)) {
+    const message = fs.readFileSync(`${root}/error.txt`).toString().trim();
+    assert.throws(() => parser.parse(), {message});
+    return;
+  }
   parser.parse();
   // Compare the compiled results with the .h/.cpp files in dir.
   const result = Array.from(project.getPrintedFiles()).sort();
@@ -4,7 +4,9 @@ import path from 'node:path';
 import {execFileSync} from 'node:child_process';
 import {tempDirSync} from '@compilets/using-temp-dir';
 
-import {generateCppProject, ninjaBuild} from '../src/index.ts';
+import {CppProject, Parser, TranslationCache, generateCppProject, ninjaBuild} from '../src/index.ts';
+import {PrintedFile} from '../src/translation-cache.ts';
+import {InterfaceRegistry, InterfaceType, Type} from '../src/cpp-syntax-type.ts';
 
 // Do not include cwd in ccache hash, as tests are built in temp dirs.
 process.env.CCACHE_NOHASHDIR = 'true';
@@ -55,8 +57,153 @@ describe('CppProject', function() {
       it(dir, () => runNodeDir(`${__dirname}/data-node-module/${dir}`));
     }
   });
+
+  describe('translation-cache', () => {
+    const data = `${__dirname}/data-cpp-project/translation-cache`;
+
+    it('reuses unchanged files', async () => {
+      using root = tempDirSync(`${__dirname}/build-`);
+      using target = tempDirSync(`${__dirname}/build-`);
+      fs.cpSync(data, root.path, {recursive: true});
+      const cold = await generate(root.path, target.path);
+      const warm = await generate(root.path, target.path);
+      assert.deepStrictEqual(warm.reparsed, []);
+      assert.deepStrictEqual(warm.files, cold.files);
+    });
+
+    it('translates changed files and their dependents', async () => {
+      using root = tempDirSync(`${__dirname}/build-`);
+      using target = tempDirSync(`${__dirname}/build-`);
+      fs.cpSync(data, root.path, {recursive: true});
+      await generate(root.path, target.path);
+      fs.appendFileSync(`${root.path}/math.ts`, 'export const zero = 0;\n');
+      const warm = await generate(root.path, target.path);
+      assert.deepStrictEqual(warm.reparsed, [ 'app', 'math' ]);
+      await assertSameAsColdBuild(root.path, warm.files);
+    });
+
+    it('translates again when used interfaces are changed', async () => {
+      using root = tempDirSync(`${__dirname}/build-`);
+      using target = tempDirSync(`${__dirname}/build-`);
+      fs.cpSync(data, root.path, {recursive: true});
+      await generate(root.path, target.path);
+      // The Point in shape.ts becomes visitable by JSON.
+      const app = fs.readFileSync(`${root.path}/app.ts`).toString();
+      fs.appendFileSync(`${root.path}/app.ts`, 'const json = JSON.stringify(shape.points[0]);\n');
+      let warm = await generate(root.path, target.path);
+      assert.deepStrictEqual(warm.reparsed, [ 'app', 'shape' ]);
+      await assertSameAsColdBuild(root.path, warm.files);
+      // The Point is no longer visitable when the code is removed.
+      fs.writeFileSync(`${root.path}/app.ts`, app);
+      warm = await generate(root.path, target.path);
+      assert.deepStrictEqual(warm.reparsed, [ 'app', 'shape' ]);
+      await assertSameAsColdBuild(root.path, warm.files);
+    });
+
+    it('drops interfaces only used by removed code', async () => {
+      using root = tempDirSync(`${__dirname}/build-`);
+      using target = tempDirSync(`${__dirname}/build-`);
+      fs.cpSync(data, root.path, {recursive: true});
+      const math = fs.readFileSync(`${root.path}/math.ts`).toString();
+      fs.appendFileSync(`${root.path}/math.ts`, 'export function name(): {name: string} { return {name: "math"}; }\n');
+      await generate(root.path, target.path);
+      fs.writeFileSync(`${root.path}/math.ts`, math);
+      const warm = await generate(root.path, target.path);
+      assert.deepStrictEqual(warm.reparsed, [ 'app', 'math' ]);
+      const cold = await assertSameAsColdBuild(root.path, warm.files);
+      assert.deepStrictEqual(warm.interfaces, cold.interfaces);
+    });
+
+    it('translates everything when analyses are changed', async () => {
+      using root = tempDirSync(`${__dirname}/build-`);
+      using target = tempDirSync(`${__dirname}/build-`);
+      fs.cpSync(data, root.path, {recursive: true});
+      await generate(root.path, target.path);
+      // Subclassing makes Shape's methods virtual.
+      fs.appendFileSync(`${root.path}/math.ts`, 'import {Shape} from "./shape";\nclass Square extends Shape {}\n');
+      const warm = await generate(root.path, target.path);
+      assert.deepStrictEqual(warm.reparsed, [ 'app', 'math', 'shape' ]);
+      await assertSameAsColdBuild(root.path, warm.files);
+    });
+
+    it('writes build info without diagnostics', async () => {
+      using target = tempDirSync(`${__dirname}/build-`);
+      const project = new CppProject(data);
+      project.skipPreEmitDiagnostics = true;
+      project.cache = new TranslationCache(project, `${target.path}/out/compilets-cache`);
+      const parser = new Parser(project);
+      parser.parse();
+      await project.writeTo(target.path, {copyDependencies: false});
+      assert.ok(fs.existsSync(`${target.path}/out/compilets-cache/.tsbuildinfo`));
+    });
+
+    it('finds targets of changed files', () => {
+      const project = new CppProject(data);
+      assert.deepStrictEqual(project.getTargetsOfFiles([]), []);
+      assert.deepStrictEqual(project.getTargetsOfFiles([ 'app.cpp' ]), [ 'app' ]);
+      // Library files and headers are used by every target.
+      assert.deepStrictEqual(project.getTargetsOfFiles([ 'app.cpp', 'math.cpp' ]), [ 'default' ]);
+      assert.deepStrictEqual(project.getTargetsOfFiles([ 'shape.h' ]), [ 'default' ]);
+      const module = new CppProject(`${__dirname}/data-node-module/pi`);
+      assert.deepStrictEqual(module.getTargetsOfFiles([ 'pi.cpp' ]), [ 'pi' ]);
+    });
+
+    it('restores interface registry', () => {
+      const registry = new InterfaceRegistry();
+      const point = new InterfaceType('Point');
+      point.properties.set('x', new Type('double', 'primitive'));
+      const line = new InterfaceType('Line');
+      line.properties.set('start', registry.register(point));
+      registry.register(line);
+      const label = new InterfaceType('Label');
+      label.properties.set('text', new Type('compilets::String', 'string'));
+      registry.register(label);
+      registry.get('Interface1').usesJSON = true;
+      const json = registry.serialize();
+      // Names are kept and JSON marks are cleared.
+      const restored = new InterfaceRegistry();
+      restored.restore(json);
+      assert.deepStrictEqual(restored.types.map(t => t.name),
+                             [ 'Interface1', 'Interface2', 'Interface3' ]);
+      assert.ok(restored.types.every(t => !t.usesJSON));
+      assert.ok(restored.get('Interface2').equal(registry.get('Interface2')));
+      // Pruning keeps the referenced interfaces, and new interfaces do not
+      // reuse the names of kept ones.
+      const pruned = new InterfaceRegistry();
+      pruned.restore(json, new Set([ 'Interface2' ]));
+      assert.deepStrictEqual(pruned.types.map(t => t.name),
+                             [ 'Interface1', 'Interface2' ]);
+      assert.strictEqual(pruned.register(point.clone()).name, 'Interface1');
+      assert.strictEqual(pruned.register(label.clone()).name, 'Interface3');
+    });
+  });
 });
 
+// Generate the project with translation cache, and return the printed files
+// and the files translated in this generation.
+async function generate(root: string, target: string) {
+  const project = new CppProject(root);
+  project.cache = new TranslationCache(project, `${target}/out/compilets-cache`);
+  const parser = new Parser(project);
+  parser.parse();
+  await project.writeTo(target, {copyDependencies: false});
+  const files = Object.fromEntries(project.getPrintedFiles());
+  const reparsed = project.getFiles().filter(([ name, file ]) => name.endsWith('.cpp') &&
+                                                                 !(file instanceof PrintedFile))
+                                     .map(([ name, file ]) => name.replace(/\.cpp$/, ''))
+                                     .sort();
+  const {interfaces} = JSON.parse(fs.readFileSync(`${target}/out/compilets-cache/cache.json`).toString());
+  return {files, reparsed, interfaces};
+}
+
+// Assert the printed files are the same with a generation without cache.
+async function assertSameAsColdBuild(root: string, files: Record<string, string>) {
+  using target = tempDirSync(`${__dirname}/build-`);
+  const cold = await generate(root, target.path);
+  assert.deepStrictEqual(files, cold.files);
+  return cold;
+}
+
 async function runDir(root: string) {
   using target = tempDirSync(`${__dirname}/build-`);
   const project = await generateCppProject(root, target.path, {config: 'Debug'});
@@ -64,7 +211,10 @@ async function runDir(root: string) {
   let exe = `${target.path}/out/Debug/${project.name}`;
   if (process.platform == 'win32')
     exe += '.exe';
-  assert.doesNotThrow(() => execFileSync(exe));
+  // Pipe the stdin.txt to the executable when there is one.
+  const stdin = `${root}/stdin.txt`;
+  const input = fs.existsSync(stdin) ? fs.readFileSync(stdin) : undefined;
+  assert.doesNotThrow(() => execFileSync(exe, {input}));
 }
 
 async function runNodeDir(root: string) {
@@ -0,0 +1,7 @@
+function* TestAllocationScope() {
+  // compilets: allocation-scope
+  {
+    const values = [1, 2, 3];
+    yield values[0];
+  }
+}
@@ -0,0 +1,28 @@
+#include "runtime/allocation_scope.h"
+#include "runtime/array.h"
+
+namespace {
+
+void TakeArray(compilets::Array<double>* arr) {}
+
+void TestAllocationScope() {
+  {
+    compilets::AllocationScope allocation_scope;
+    compilets::Array<double>* values = allocation_scope.Track(compilets::MakeArray<double>({1, 2, 3}));
+    double first = values->value()[0] + values->length;
+    values->push(first);
+    double index = values->indexOf(first);
+    compilets::Array<double>* zeros = allocation_scope.Track(compilets::MakeObject<compilets::Array<double>>(10));
+    zeros->value()[0] = index;
+    compilets::Array<double>* passed = compilets::MakeArray<double>({4, 5});
+    TakeArray(passed);
+    compilets::Array<double>* reversed = compilets::MakeArray<double>({6, 7});
+    reversed->reverse();
+    for (double i = 0; i < 2; ++i) {
+      compilets::Array<double>* item = compilets::MakeArray<double>({i});
+      item->value()[0] = i;
+    }
+  }
+}
+
+}  // namespace
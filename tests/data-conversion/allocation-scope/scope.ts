@@ -0,0 +1,21 @@
+function TakeArray(arr: number[]) {}
+
+function TestAllocationScope() {
+  // compilets: allocation-scope
+  {
+    let values = [1, 2, 3];
+    let first = values[0] + values.length;
+    values.push(first);
+    let index = values.indexOf(first);
+    let zeros = new Array<number>(10);
+    zeros[0] = index;
+    let passed = [4, 5];
+    TakeArray(passed);
+    let reversed = [6, 7];
+    reversed.reverse();
+    for (let i = 0; i < 2; ++i) {
+      let item = [i];
+      item[0] = i;
+    }
+  }
+}
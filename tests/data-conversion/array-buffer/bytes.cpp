@@ -0,0 +1,16 @@
+#include "runtime/array_buffer.h"
+
+namespace {
+
+void TestBytes() {
+  compilets::ArrayBuffer* buffer = compilets::MakeObject<compilets::ArrayBuffer>(8);
+  compilets::Uint8Array* bytes = compilets::MakeObject<compilets::Uint8Array>(buffer, 2, 4);
+  bytes->value()[0] = 255;
+  bytes->value()[1] += 2;
+  bytes->value()[2]++;
+  double first = bytes->value().get(0);
+  compilets::Uint8Array* tail = bytes->subarray(1);
+  double length = tail->length + buffer->byteLength;
+}
+
+}  // namespace
@@ -0,0 +1,10 @@
+function TestBytes() {
+  const buffer = new ArrayBuffer(8);
+  const bytes = new Uint8Array(buffer, 2, 4);
+  bytes[0] = 255;
+  bytes[1] += 2;
+  bytes[2]++;
+  const first = bytes[0];
+  const tail = bytes.subarray(1);
+  const length = tail.length + buffer.byteLength;
+}
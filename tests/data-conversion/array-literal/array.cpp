@@ -3,10 +3,10 @@
 
 namespace {
 
-class Item : public compilets::Object {
+class Item final : public compilets::Object {
 };
 
-class Collection : public compilets::Object {
+class Collection final : public compilets::Object {
  public:
   cppgc::Member<compilets::Array<cppgc::Member<Item>>> items = compilets::MakeArray<cppgc::Member<Item>>({});
   cppgc::Member<compilets::Array<cppgc::Member<Item>>> maybeItems = compilets::MakeArray<cppgc::Member<Item>>({nullptr});
@@ -18,17 +18,17 @@ class Collection : public compilets::Object {
     compilets::TraceMember(visitor, multiItems);
   }
 
-  virtual ~Collection() = default;
+  ~Collection() = default;
 };
 
 void TestArray() {
   compilets::Array<double>* a = nullptr;
   a = compilets::MakeArray<double>({8964});
   double element = a->value()[0];
-  std::optional<double> indexOptional = 0;
+  compilets::Optional<double> indexOptional = 0;
   element = a->value()[static_cast<size_t>(indexOptional.value())];
   compilets::Union<double, bool> indexUnion = static_cast<double>(0);
-  element = a->value()[static_cast<size_t>(std::get<double>(indexUnion))];
+  element = a->value()[static_cast<size_t>(compilets::Get<double>(indexUnion))];
   compilets::Array<double>* numArr = compilets::MakeArray<double>({1, 2, 3, 4});
   compilets::Array<cppgc::Member<Item>>* eleArr = compilets::MakeArray<cppgc::Member<Item>>({compilets::MakeObject<Item>(), compilets::MakeObject<Item>()});
   double multiElement = (a->value()[0] == 1984 ? a : numArr)->value()[0];
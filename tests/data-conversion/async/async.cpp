@@ -0,0 +1,32 @@
+#include "runtime/array.h"
+#include "runtime/promise.h"
+
+namespace {
+
+compilets::Promise<double>* twice(double n) {
+  co_return n * 2;
+}
+
+compilets::Promise<double>* sum(cppgc::Persistent<compilets::Array<double>> values) {
+  double total = 0;
+  for (size_t _value_i = 0; _value_i < values->value().size(); ++_value_i) {
+    double value = values->value()[_value_i];
+    total += co_await twice(value);
+  }
+  co_return total;
+}
+
+compilets::Promise<void>* TestAwait() {
+  double one = co_await compilets::PromiseConstructor::resolve<double>(1);
+  double two = co_await twice(one);
+}
+
+double count(compilets::Array<double>* values, double extra) {
+  return values->length + extra;
+}
+
+compilets::Promise<void>* TestAwaitArgument(cppgc::Persistent<compilets::Array<double>> values) {
+  double total = count(values, co_await twice(1));
+}
+
+}  // namespace
@@ -0,0 +1,24 @@
+async function twice(n: number) {
+  return n * 2;
+}
+
+async function sum(values: number[]) {
+  let total = 0;
+  for (const value of values) {
+    total += await twice(value);
+  }
+  return total;
+}
+
+async function TestAwait() {
+  const one = await Promise.resolve(1);
+  const two = await twice(one);
+}
+
+function count(values: number[], extra: number) {
+  return values.length + extra;
+}
+
+async function TestAwaitArgument(values: number[]) {
+  const total = count(values, await twice(1));
+}
@@ -3,11 +3,11 @@
 
 namespace {
 
-class Item : public compilets::Object {
+class Item final : public compilets::Object {
 };
 
 template<typename T, typename U>
-class Wrapper : public compilets::Object {
+class Wrapper final : public compilets::Object {
  public:
   compilets::CppgcMemberType<T> member;
   compilets::OptionalCppgcMemberType<T> optionalMember;
@@ -15,15 +15,15 @@ class Wrapper : public compilets::Object {
   compilets::Union<std::monostate, compilets::CppgcMemberType<T>, compilets::CppgcMemberType<U>> optionalUnionMember;
   cppgc::Member<compilets::Array<compilets::CppgcMemberType<T>>> arrayMember = compilets::MakeArray<compilets::CppgcMemberType<T>>({});
 
-  virtual void method() {
+  void method() {
     compilets::ValueType<T> m = this->member;
     m = compilets::GetOptionalValue(this->optionalMember);
-    m = std::get<compilets::CppgcMemberType<T>>(this->unionMember);
-    m = std::get<compilets::CppgcMemberType<T>>(this->optionalUnionMember);
+    m = compilets::Get<compilets::CppgcMemberType<T>>(this->unionMember);
+    m = compilets::Get<compilets::CppgcMemberType<T>>(this->optionalUnionMember);
     m = this->arrayMember->value()[0];
   }
 
-  virtual void take(compilets::ValueType<T> value) {
+  void take(compilets::ValueType<T> value) {
     this->member = value;
     this->optionalMember = value;
     this->unionMember = value;
@@ -39,7 +39,7 @@ class Wrapper : public compilets::Object {
     compilets::TraceMember(visitor, arrayMember);
   }
 
-  virtual ~Wrapper() = default;
+  ~Wrapper() = default;
 };
 
 void TestGenericClass() {
@@ -48,11 +48,11 @@ void TestGenericClass() {
   primitive->method();
   double n = primitive->member;
   n = primitive->optionalMember.value();
-  n = std::get<double>(primitive->unionMember);
-  n = std::get<double>(primitive->optionalUnionMember);
+  n = compilets::Get<double>(primitive->unionMember);
+  n = compilets::Get<double>(primitive->optionalUnionMember);
   n = primitive->arrayMember->value()[0];
   primitive->take(n);
-  std::optional<double> optionalNumber = primitive->optionalMember;
+  compilets::Optional<double> optionalNumber = primitive->optionalMember;
   compilets::Union<double, bool> numberOrBool = primitive->unionMember;
   compilets::Union<std::monostate, double, bool> numberOrBoolOrNull = primitive->optionalUnionMember;
   compilets::Array<double>* numberArray = primitive->arrayMember;
@@ -61,8 +61,8 @@ void TestGenericClass() {
   nested->method();
   Item* item = nested->member;
   item = nested->optionalMember;
-  item = std::get<cppgc::Member<Item>>(nested->unionMember);
-  item = std::get<cppgc::Member<Item>>(nested->optionalUnionMember);
+  item = compilets::Get<cppgc::Member<Item>>(nested->unionMember);
+  item = compilets::Get<cppgc::Member<Item>>(nested->optionalUnionMember);
   item = nested->arrayMember->value()[0];
   nested->take(item);
   Item* optionalItem = nested->optionalMember;
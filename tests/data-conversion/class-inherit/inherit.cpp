@@ -2,7 +2,7 @@
 
 namespace {
 
-class Prop : public compilets::Object {
+class Prop final : public compilets::Object {
 };
 
 class Base : public compilets::Object {
@@ -22,7 +22,7 @@ class Base : public compilets::Object {
   virtual ~Base() = default;
 };
 
-class Derived : public Base {
+class Derived final : public Base {
  public:
   cppgc::Member<Prop> childProp;
 
@@ -37,10 +37,10 @@ class Derived : public Base {
     Base::Trace(visitor);
   }
 
-  virtual ~Derived() = default;
+  ~Derived() = default;
 };
 
-class NotDerived : public compilets::Object {
+class NotDerived final : public compilets::Object {
 };
 
 void TestInheritance() {
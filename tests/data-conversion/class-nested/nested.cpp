@@ -2,10 +2,10 @@
 
 namespace {
 
-class Prop : public compilets::Object {
+class Prop final : public compilets::Object {
 };
 
-class Owner : public compilets::Object {
+class Owner final : public compilets::Object {
  public:
   cppgc::Member<Prop> prop1;
   cppgc::Member<Prop> prop2;
@@ -15,8 +15,8 @@ class Owner : public compilets::Object {
     this->prop2 = prop;
   }
 
-  virtual compilets::Function<Prop*()>* method() {
-    return compilets::MakeFunction<Prop*()>([=]() -> Prop* {
+  compilets::Function<Prop*()>* method() {
+    return compilets::MakeFunction<Prop*()>([this]() -> Prop* {
       return this->prop1;
     }, this);
   }
@@ -26,7 +26,7 @@ class Owner : public compilets::Object {
     compilets::TraceMember(visitor, prop2);
   }
 
-  virtual ~Owner() = default;
+  ~Owner() = default;
 };
 
 void TestNested() {
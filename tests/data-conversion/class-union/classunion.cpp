@@ -4,62 +4,91 @@
 
 namespace {
 
-class Member : public compilets::Object {
+class Member final : public compilets::Object {
 };
 
 void TakeMember(Member* c) {}
 
-class WithNumber : public compilets::Object {
+class WithNumber final : public compilets::Object {
  public:
   compilets::Union<double, cppgc::Member<Member>> member;
 
-  virtual void method() {}
+  void method() {}
 
   void Trace(cppgc::Visitor* visitor) const override {
     compilets::TraceMember(visitor, member);
   }
 
-  virtual ~WithNumber() = default;
+  ~WithNumber() = default;
 };
 
 void TestMemberUnion() {
   compilets::Union<bool, Member*> memberInUnion = compilets::MakeObject<Member>();
-  TakeMember(std::get<Member*>(memberInUnion));
-  Member* member = std::get<Member*>(memberInUnion);
+  TakeMember(compilets::Get<Member*>(memberInUnion));
+  Member* member = compilets::Get<Member*>(memberInUnion);
   TakeMember(member);
   compilets::Union<bool, Member*> copy = memberInUnion;
-  TakeMember(std::get<Member*>(copy));
+  TakeMember(compilets::Get<Member*>(copy));
   WithNumber* wrapper = compilets::MakeObject<WithNumber>();
   wrapper->member = member;
-  member = std::get<cppgc::Member<Member>>(wrapper->member);
+  member = compilets::Get<cppgc::Member<Member>>(wrapper->member);
 }
 
-class StringMember : public compilets::Object {
+class StringMember final : public compilets::Object {
  public:
   compilets::String member;
 
-  virtual void method() {}
+  void method() {}
 
-  virtual ~StringMember() = default;
+  ~StringMember() = default;
 };
 
-class MemberMember : public compilets::Object {
+class MemberMember final : public compilets::Object {
  public:
   cppgc::Member<Member> member;
 
-  virtual void method() {}
+  void method() {}
 
   void Trace(cppgc::Visitor* visitor) const override {
     compilets::TraceMember(visitor, member);
   }
 
-  virtual ~MemberMember() = default;
+  ~MemberMember() = default;
 };
 
 void TestClassUnion() {
   compilets::Union<WithNumber*, StringMember*, MemberMember*> common = compilets::MakeObject<StringMember>();
-  compilets::Union<double, Member*, compilets::String> commonMember = std::visit([](auto&& _obj) -> compilets::Union<double, cppgc::Member<Member>, compilets::String> { return _obj->member; }, common);
-  std::visit([&](auto&& _obj) -> void { return _obj->method(); }, common);
+  compilets::Union<double, Member*, compilets::String> commonMember = compilets::Visit([](auto&& _obj) -> compilets::Union<double, cppgc::Member<Member>, compilets::String> { return _obj->member; }, common);
+  compilets::Visit([&](auto&& _obj) -> void { return _obj->method(); }, common);
+}
+
+class Shape : public compilets::Object {
+ public:
+  double area;
+
+  virtual void describe() {}
+
+  virtual ~Shape() = default;
+};
+
+class Circle final : public Shape {
+ public:
+  void describe() override {}
+
+  ~Circle() = default;
+};
+
+class Square final : public Shape {
+ public:
+  double side;
+
+  ~Square() = default;
+};
+
+void TestCommonBase() {
+  compilets::Union<Circle*, Square*> shape = compilets::MakeObject<Square>();
+  double area = static_cast<Shape*>(shape.GetObject())->area;
+  static_cast<Shape*>(shape.GetObject())->describe();
 }
 
 }  // namespace
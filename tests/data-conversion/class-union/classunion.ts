@@ -40,3 +40,23 @@ function TestClassUnion() {
   let commonMember = common.member;
   common.method();
 }
+
+class Shape {
+  area: number;
+
+  describe() {}
+}
+
+class Circle extends Shape {
+  override describe() {}
+}
+
+class Square extends Shape {
+  side: number;
+}
+
+function TestCommonBase() {
+  let shape: Circle | Square = new Square();
+  let area = shape.area;
+  shape.describe();
+}
@@ -3,15 +3,15 @@
 
 namespace {
 
-class Empty : public compilets::Object {
+class Empty final : public compilets::Object {
 };
 
-class EmptyConstructor : public compilets::Object {
+class EmptyConstructor final : public compilets::Object {
  public:
   EmptyConstructor() {}
 };
 
-class NonSimple : public compilets::Object {
+class NonSimple final : public compilets::Object {
  public:
   static double count;
 
@@ -20,11 +20,11 @@ class NonSimple : public compilets::Object {
     NonSimple::count++;
   }
 
-  virtual compilets::String method() {
+  compilets::String method() {
     return this->prop;
   }
 
-  virtual ~NonSimple() = default;
+  ~NonSimple() = default;
 
  private:
   compilets::String prop = u"For a breath I tarry.";
@@ -33,7 +33,8 @@ class NonSimple : public compilets::Object {
 double NonSimple::count = 0;
 
 void TestClass() {
-  NonSimple* s = compilets::MakeObject<NonSimple>(false);
+  NonSimple _s_storage(false);
+  NonSimple* s = &_s_storage;
   if (NonSimple::count != 1) return;
   compilets::String r = s->method();
 }
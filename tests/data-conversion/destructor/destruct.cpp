@@ -2,7 +2,7 @@
 
 namespace {
 
-class Finalizer : public compilets::Object {
+class Finalizer final : public compilets::Object {
   CPPGC_USING_PRE_FINALIZER(Finalizer, Dispose);
  public:
   void Dispose() {}
@@ -9,7 +9,7 @@ View::View() {
   View::count++;
 }
 
-void View::redraw(compilets::generated::Interface1* options) {}
+void View::redraw(compilets::generated::Interface1 options) {}
 
 void View::Trace(cppgc::Visitor* visitor) const {
   compilets::TraceMember(visitor, children);
@@ -5,14 +5,14 @@
 
 namespace compilets::generated {
 
-struct Interface1 : public compilets::Object {
+struct Interface1 final : public compilets::Struct {
   Interface1() = default;
   Interface1(bool force) : force(force) {}
 
   bool force;
 };
 
-struct Interface2 : public compilets::Object {
+struct Interface2 final : public compilets::Struct {
   Interface2() = default;
   Interface2(bool redraw) : redraw(redraw) {}
 
@@ -23,7 +23,7 @@ struct Interface2 : public compilets::Object {
 
 namespace app::base_ts {
 
-class View : public compilets::Object {
+class View final : public compilets::Object {
  public:
   static double count;
 
@@ -31,25 +31,25 @@ class View : public compilets::Object {
 
   View();
 
-  virtual void redraw(compilets::generated::Interface1* options);
+  void redraw(compilets::generated::Interface1 options);
 
   void Trace(cppgc::Visitor* visitor) const override;
 
-  virtual ~View();
+  ~View();
 };
 
 template<typename T>
-class Container : public compilets::Object {
+class Container final : public compilets::Object {
  public:
   cppgc::Member<compilets::Array<compilets::CppgcMemberType<T>>> children = compilets::MakeArray<compilets::CppgcMemberType<T>>({});
 
-  virtual void layout(compilets::generated::Interface2* options) {}
+  void layout(compilets::generated::Interface2 options) {}
 
   void Trace(cppgc::Visitor* visitor) const override {
     compilets::TraceMember(visitor, children);
   }
 
-  virtual ~Container() = default;
+  ~Container() = default;
 };
 
 }  // namespace app::base_ts
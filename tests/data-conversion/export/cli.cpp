@@ -13,8 +13,9 @@ using app::base_ts::View;
 using namespace app::cli_ts;
 
 int main(int argc, const char** argv) {
-  compilets::StateExe _state;
+  compilets::StateExe _state(argc, argv);
   View* view = gui::createView();
   app::base_ts::Container<View>* container = gui::createContainer<View>();
+  _state.RunEventLoop();
   return 0;
 }
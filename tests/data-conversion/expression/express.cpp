@@ -4,7 +4,7 @@ namespace {
 
 void TestExpression() {
   if (true) {}
-  std::optional<bool> optionalBoolean;
+  compilets::Optional<bool> optionalBoolean;
   if (compilets::IsTrue(optionalBoolean)) {}
   if (compilets::IsTrue(optionalBoolean) || 2 > 1) {}
   if (1 > 2) {}
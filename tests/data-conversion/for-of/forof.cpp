@@ -0,0 +1,77 @@
+#include "runtime/array.h"
+#include "runtime/map.h"
+#include "runtime/set.h"
+#include "runtime/string.h"
+
+namespace {
+
+class Item final : public compilets::Object {
+ public:
+  double value = 1;
+};
+
+class Bag final : public compilets::Object {
+ public:
+  cppgc::Member<compilets::Array<cppgc::Member<Item>>> items = compilets::MakeArray<cppgc::Member<Item>>({});
+
+  double sum() {
+    double total = 0;
+    {
+      compilets::Array<cppgc::Member<Item>>* _item_array = this->items;
+      for (size_t _item_i = 0, _item_length = _item_array->value().size(); _item_i < _item_length; ++_item_i) {
+        Item* item = _item_array->value()[_item_i];
+        total += item->value;
+      }
+    }
+    return total;
+  }
+
+  void Trace(cppgc::Visitor* visitor) const override {
+    compilets::TraceMember(visitor, items);
+  }
+
+  ~Bag() = default;
+};
+
+void TestArray(compilets::Array<double>* numbers) {
+  double sum = 0;
+  for (size_t _n_i = 0, _n_length = numbers->value().size(); _n_i < _n_length; ++_n_i) {
+    double n = numbers->value()[_n_i];
+    sum += n;
+  }
+  for (size_t _n_i = 0; _n_i < numbers->value().size(); ++_n_i) {
+    double n = numbers->value()[_n_i];
+    numbers->push(n);
+  }
+}
+
+void TestString(const compilets::String& str) {
+  for (compilets::String c : str) {
+    c.length;
+  }
+}
+
+void TestModifiedString(compilets::String text) {
+  {
+    compilets::String _c_range = text;
+    for (compilets::String c : _c_range) {
+      text = c;
+    }
+  }
+}
+
+void TestMapSet() {
+  compilets::Map<compilets::String, double>* map = compilets::MakeObject<compilets::Map<compilets::String, double>>();
+  for (const auto& _key_entry : *map) {
+    compilets::String key = _key_entry.key;
+    double value = _key_entry.value;
+    key.length + value;
+  }
+  compilets::Set<double>* set = compilets::MakeObject<compilets::Set<double>>();
+  for (const auto& _value_entry : *set) {
+    double value = _value_entry.key;
+    value;
+  }
+}
+
+}  // namespace
@@ -0,0 +1,46 @@
+class Item {
+  value = 1;
+}
+
+class Bag {
+  items: Item[] = [];
+
+  sum() {
+    let total = 0;
+    for (const item of this.items)
+      total += item.value;
+    return total;
+  }
+}
+
+function TestArray(numbers: number[]) {
+  let sum = 0;
+  for (const n of numbers) {
+    sum += n;
+  }
+  for (let n of numbers) {
+    numbers.push(n);
+  }
+}
+
+function TestString(str: string) {
+  for (const c of str) {
+    c.length;
+  }
+}
+
+function TestModifiedString(text: string) {
+  for (const c of text) {
+    text = c;
+  }
+}
+
+function TestMapSet() {
+  const map = new Map<string, number>();
+  for (const [key, value] of map) {
+    key.length + value;
+  }
+  const set = new Set<number>();
+  for (const value of set)
+    value;
+}
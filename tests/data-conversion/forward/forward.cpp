@@ -13,7 +13,7 @@ class Item;
 
 namespace compilets::generated {
 
-struct Interface1 : public compilets::Object {
+struct Interface1 final : public compilets::Object {
   Interface1() = default;
   Interface1(bool success, Holder* result) : success(success), result(result) {}
 
@@ -24,10 +24,10 @@ struct Interface1 : public compilets::Object {
     compilets::TraceMember(visitor, result);
   }
 
-  virtual ~Interface1() = default;
+  ~Interface1() = default;
 };
 
-struct Interface2 : public compilets::Object {
+struct Interface2 final : public compilets::Object {
   Interface2() = default;
   Interface2(Holder* fallback) : fallback(fallback) {}
 
@@ -37,10 +37,10 @@ struct Interface2 : public compilets::Object {
     compilets::TraceMember(visitor, fallback);
   }
 
-  virtual ~Interface2() = default;
+  ~Interface2() = default;
 };
 
-struct Interface3 : public compilets::Object {
+struct Interface3 final : public compilets::Object {
   Interface3() = default;
   Interface3(double id, Item* item) : id(id), item(item) {}
 
@@ -51,7 +51,7 @@ struct Interface3 : public compilets::Object {
     compilets::TraceMember(visitor, item);
   }
 
-  virtual ~Interface3() = default;
+  ~Interface3() = default;
 };
 
 }  // namespace compilets::generated
@@ -70,7 +70,7 @@ compilets::generated::Interface1* find(compilets::generated::Interface2* options
   }
 }
 
-class Holder : public compilets::Object {
+class Holder final : public compilets::Object {
  public:
   cppgc::Member<compilets::generated::Interface3> data;
 
@@ -78,10 +78,10 @@ class Holder : public compilets::Object {
     compilets::TraceMember(visitor, data);
   }
 
-  virtual ~Holder() = default;
+  ~Holder() = default;
 };
 
-class Item : public compilets::Object {
+class Item final : public compilets::Object {
 };
 
 }  // namespace
@@ -0,0 +1,25 @@
+#include "runtime/array.h"
+#include "runtime/buffer.h"
+#include "runtime/fs.h"
+#include "runtime/string.h"
+
+namespace fs = compilets::nodejs::fs;
+
+namespace {
+
+void TestFs() {
+  fs::writeFileSync(u"output.txt", u"text");
+  compilets::String text = fs::readFileSync(u"output.txt", u"utf8");
+  compilets::nodejs::Buffer* buffer = fs::readFileSync(u"output.txt");
+  compilets::Array<compilets::String>* names = fs::readdirSync(u".");
+  bool exists = fs::existsSync(u"output.txt");
+}
+
+void TestReadSync() {
+  compilets::nodejs::Buffer* chunk = compilets::nodejs::Buffer::alloc(16);
+  double fd = fs::openSync(u"output.txt", u"r");
+  double length = fs::readSync(fd, chunk, 0, chunk->length);
+  fs::closeSync(fd);
+}
+
+}  // namespace
@@ -0,0 +1,16 @@
+import * as fs from 'node:fs';
+
+function TestFs() {
+  fs.writeFileSync('output.txt', 'text');
+  const text = fs.readFileSync('output.txt', 'utf8');
+  const buffer = fs.readFileSync('output.txt');
+  const names = fs.readdirSync('.');
+  const exists = fs.existsSync('output.txt');
+}
+
+function TestReadSync() {
+  const chunk = Buffer.alloc(16);
+  const fd = fs.openSync('output.txt', 'r');
+  const length = fs.readSync(fd, chunk, 0, chunk.length);
+  fs.closeSync(fd);
+}
@@ -1,15 +1,16 @@
 #include "runtime/array.h"
 #include "runtime/function.h"
+#include "runtime/string.h"
 #include "runtime/union.h"
 
 namespace {
 
-class MethodClosure : public compilets::Object {
+class MethodClosure final : public compilets::Object {
  public:
   double prop = 8964;
 
-  virtual compilets::Function<double()>* method() {
-    return compilets::MakeFunction<double()>([=]() -> double {
+  compilets::Function<double()>* method() {
+    return compilets::MakeFunction<double()>([this]() -> double {
       return this->prop;
     }, this);
   }
@@ -17,17 +18,56 @@ class MethodClosure : public compilets::Object {
 
 void TestFunctionClosure() {
   double n = 123;
-  compilets::Function<double()>* takeNumber = compilets::MakeFunction<double()>([=]() -> double {
+  compilets::Function<double()>* takeNumber = compilets::MakeFunction<double()>([n]() -> double {
     return n;
   });
   compilets::Array<double>* arr = compilets::MakeArray<double>({1, 2, 3});
-  compilets::Function<compilets::Array<double>*()>* takeArray = compilets::MakeFunction<compilets::Array<double>*()>([=]() -> compilets::Array<double>* {
+  compilets::Function<compilets::Array<double>*()>* takeArray = compilets::MakeFunction<compilets::Array<double>*()>([arr]() -> compilets::Array<double>* {
     return arr;
   }, arr);
   compilets::Union<double, compilets::Array<double>*> uni;
-  compilets::Function<compilets::Array<double>*()>* takeUnion = compilets::MakeFunction<compilets::Array<double>*()>([=]() -> compilets::Array<double>* {
-    return std::get<compilets::Array<double>*>(uni);
+  compilets::Function<compilets::Array<double>*()>* takeUnion = compilets::MakeFunction<compilets::Array<double>*()>([uni]() -> compilets::Array<double>* {
+    return compilets::Get<compilets::Array<double>*>(uni);
   }, uni.GetObject());
 }
 
+compilets::Function<double()>* MakeCounter() {
+  compilets::Cell<double>* _count_cell = compilets::MakeObject<compilets::Cell<double>>(0);
+  double &count = _count_cell->value;
+  return compilets::MakeFunction<double()>([&count = _count_cell->value]() -> double {
+    return ++count;
+  }, _count_cell);
+}
+
+compilets::Function<double(double)>* MakeAdder(double _start_param) {
+  compilets::Cell<double>* _start_cell = compilets::MakeObject<compilets::Cell<double>>(_start_param);
+  double &start = _start_cell->value;
+  return compilets::MakeFunction<double(double)>([&start = _start_cell->value](double n) -> double {
+    return start += n;
+  }, _start_cell);
+}
+
+class Box final : public compilets::Object {
+};
+
+compilets::Function<Box*(Box*)>* MakeSwapper(Box* _box_param) {
+  compilets::Cell<cppgc::Member<Box>>* _box_cell = compilets::MakeObject<compilets::Cell<cppgc::Member<Box>>>(_box_param);
+  cppgc::Member<Box> &box = _box_cell->value;
+  return compilets::MakeFunction<Box*(Box*)>([&box = _box_cell->value](Box* other) -> Box* {
+    Box* old = box;
+    box = other;
+    return old;
+  }, _box_cell);
+}
+
+void TestNonEscapingClosure() {
+  compilets::String text = u"text";
+  double total = 0;
+  compilets::Function<compilets::String(double)>* add = compilets::MakeFunction<compilets::String(double)>([&total, &text](double n) -> compilets::String {
+    total += n;
+    return text;
+  });
+  add->value()(1);
+}
+
 }  // namespace
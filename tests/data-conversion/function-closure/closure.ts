@@ -16,3 +16,32 @@ function TestFunctionClosure() {
   let uni: number | number[];
   let takeUnion = () => { return uni as number[] };
 }
+
+function MakeCounter() {
+  let count = 0;
+  return () => ++count;
+}
+
+function MakeAdder(start: number) {
+  return (n: number) => start += n;
+}
+
+class Box {}
+
+function MakeSwapper(box: Box) {
+  return (other: Box) => {
+    const old = box;
+    box = other;
+    return old;
+  };
+}
+
+function TestNonEscapingClosure() {
+  let text = 'text';
+  let total = 0;
+  const add = (n: number) => {
+    total += n;
+    return text;
+  };
+  add(1);
+}
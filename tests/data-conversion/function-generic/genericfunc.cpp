@@ -6,7 +6,7 @@
 namespace {
 
 template<typename T>
-class Item : public compilets::Object {
+class Item final : public compilets::Object {
  public:
   compilets::OptionalCppgcMemberType<T> value;
 
@@ -14,7 +14,7 @@ class Item : public compilets::Object {
     compilets::TracePossibleMember(visitor, value);
   }
 
-  virtual ~Item() = default;
+  ~Item() = default;
 };
 
 template<typename T>
@@ -33,16 +33,16 @@ compilets::Array<cppgc::Member<Item<U>>>* CreateItems() {
 }
 
 void TestGenericFunction() {
-  compilets::Function<compilets::String(compilets::String)>* passStr = compilets::MakeFunction<compilets::String(compilets::String)>(Passthrough<compilets::String>);
+  compilets::Function<compilets::String(compilets::String)>* passStr = compilets::MakeFunction<compilets::String(compilets::String), Passthrough<compilets::String>>();
   compilets::String str = Passthrough<compilets::String>(u"text");
   str = passStr->value()(str);
   compilets::Union<std::monostate, double, bool> onion;
   onion = Passthrough<compilets::Union<std::monostate, double, bool>>(onion);
-  std::optional<double> optional;
-  optional = Passthrough<std::optional<double>>(optional);
+  compilets::Optional<double> optional;
+  optional = Passthrough<compilets::Optional<double>>(optional);
   compilets::Array<cppgc::Member<Item<compilets::String>>>* items = CreateItems<compilets::String>();
   Item<compilets::String>* item = compilets::MakeObject<Item<compilets::String>>();
-  item->value = Passthrough<std::optional<compilets::String>>(item->value);
+  item->value = Passthrough<compilets::Optional<compilets::String>>(item->value);
   item->value = GetValue<compilets::String>(item);
   compilets::Array<cppgc::Member<Item<Item<compilets::String>>>>* itemItems = CreateItems<Item<compilets::String>>();
   Item<Item<compilets::String>>* itemItem = compilets::MakeObject<Item<Item<compilets::String>>>();
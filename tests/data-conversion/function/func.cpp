@@ -6,7 +6,7 @@ double Simple(double i) {
   return i;
 }
 
-double OptionalArg(std::optional<double> arg) {
+double OptionalArg(compilets::Optional<double> arg) {
   if (compilets::IsTrue(arg)) {
     return arg.value();
   } else {
@@ -15,12 +15,12 @@ double OptionalArg(std::optional<double> arg) {
 }
 
 compilets::Function<double()>* TakeCallback(double input, compilets::Function<double(double)>* callback) {
-  return compilets::MakeFunction<double()>([=]() -> double {
+  return compilets::MakeFunction<double()>([callback, input]() -> double {
     return callback->value()(input);
   }, callback);
 }
 
-class SaveCallback : public compilets::Object {
+class SaveCallback final : public compilets::Object {
  public:
   cppgc::Member<compilets::Function<double(double)>> callback;
 
@@ -32,21 +32,25 @@ class SaveCallback : public compilets::Object {
     compilets::TraceMember(visitor, callback);
   }
 
-  virtual ~SaveCallback() = default;
+  ~SaveCallback() = default;
 };
 
 void TestLocalFunction() {
-  compilets::Function<double(double)>* add = compilets::MakeFunction<double(double)>([=](double a) -> double {
+  compilets::Function<double(double)>* add = compilets::MakeFunction<double(double)>([](double a) -> double {
     return a + 1;
   });
-  compilets::Function<void()>* arrow = compilets::MakeFunction<void()>([=]() -> void {});
+  compilets::Function<void()>* arrow = compilets::MakeFunction<void()>([]() -> void {});
+  auto* twice = compilets::MakeFunctionImpl<double(double)>([](double a) -> double {
+    return a * 2;
+  });
   Simple(1234);
   add->value()(8963);
   arrow->value()();
+  twice->value()(4);
   compilets::Function<double()>* passLambda = TakeCallback(1234, add);
-  compilets::Function<double()>* passFunction = TakeCallback(1234, compilets::MakeFunction<double(double)>(Simple));
+  compilets::Function<double()>* passFunction = TakeCallback(1234, compilets::MakeFunction<double(double), Simple>());
   SaveCallback* saveLambda = compilets::MakeObject<SaveCallback>(add);
-  SaveCallback* saveFunction = compilets::MakeObject<SaveCallback>(compilets::MakeFunction<double(double)>(Simple));
+  SaveCallback* saveFunction = compilets::MakeObject<SaveCallback>(compilets::MakeFunction<double(double), Simple>());
   saveLambda->callback->value()(0x8964);
 }
 
@@ -25,10 +25,12 @@ class SaveCallback {
 function TestLocalFunction() {
   let add = function(a: number) { return a + 1 };
   let arrow = () => {};
+  const twice = (a: number) => a * 2;
 
   Simple(1234);
   add(8963);
   arrow();
+  twice(4);
 
   const passLambda = TakeCallback(1234, add);
   const passFunction = TakeCallback(1234, Simple);
@@ -0,0 +1,49 @@
+#include "runtime/array.h"
+#include "runtime/generator.h"
+#include "runtime/string.h"
+
+namespace {
+
+class Item final : public compilets::Object {
+ public:
+  double value = 1;
+};
+
+compilets::Generator<double>* Range(double n) {
+  for (double i = 0; i < n; ++i) {
+    co_yield i;
+  }
+}
+
+compilets::Generator<double>* Values(cppgc::Persistent<compilets::Array<cppgc::Member<Item>>> items) {
+  for (size_t _item_i = 0; _item_i < items->value().size(); ++_item_i) {
+    cppgc::Persistent<Item> item = items->value()[_item_i];
+    co_yield item->value;
+  }
+  {
+    cppgc::Persistent<compilets::Generator<double>> _delegate = Range(2);
+    for (const auto& _value : *_delegate) co_yield _value;
+  }
+}
+
+compilets::Generator<double>* Squares(double n) {
+  {
+    cppgc::Persistent<compilets::Generator<double>> _value_range = Range(n);
+    for (double value : *_value_range) {
+      co_yield value * value;
+    }
+  }
+}
+
+compilets::Generator<compilets::String>* Empty() {
+  co_return;
+}
+
+void TestGenerator() {
+  double sum = 0;
+  for (double value : *Values(compilets::MakeArray<cppgc::Member<Item>>({compilets::MakeObject<Item>()}))) {
+    sum += value;
+  }
+}
+
+}  // namespace
@@ -0,0 +1,30 @@
+class Item {
+  value = 1;
+}
+
+function* Range(n: number) {
+  for (let i = 0; i < n; ++i) {
+    yield i;
+  }
+}
+
+function* Values(items: Item[]) {
+  for (const item of items)
+    yield item.value;
+  yield* Range(2);
+}
+
+function* Squares(n: number) {
+  for (const value of Range(n))
+    yield value * value;
+}
+
+function* Empty(): Generator<string> {
+  return;
+}
+
+function TestGenerator() {
+  let sum = 0;
+  for (const value of Values([new Item()]))
+    sum += value;
+}
@@ -1,4 +1,5 @@
 #include "runtime/console.h"
+#include "runtime/math.h"
 #include "runtime/process.h"
 #include "runtime/runtime.h"
 
@@ -11,4 +12,14 @@ void TestGlobals() {
   compilets::nodejs::console->log(u"text", 123, compilets::nodejs::process);
 }
 
+void TestTiming() {
+  compilets::nodejs::console->time();
+  double start = compilets::nodejs::performance->now();
+  int64_t begin = compilets::nodejs::process->hrtime->bigint();
+  int64_t elapsed = compilets::nodejs::process->hrtime->bigint() - begin;
+  int64_t ms = compilets::BigIntDivide(elapsed, 1000000);
+  bool slow = elapsed > 1000;
+  compilets::nodejs::console->timeEnd();
+}
+
 }  // namespace
@@ -4,3 +4,13 @@ function TestGlobals() {
   processRef.exit();
   console.log('text', 123, process);
 }
+
+function TestTiming() {
+  console.time();
+  const start = performance.now();
+  const begin = process.hrtime.bigint();
+  const elapsed = process.hrtime.bigint() - begin;
+  const ms = elapsed / 1000000n;
+  const slow = elapsed > 1000n;
+  console.timeEnd();
+}
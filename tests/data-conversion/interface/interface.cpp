@@ -3,71 +3,57 @@
 
 namespace compilets::generated {
 
-struct Interface5;
-
-struct Interface1 : public compilets::Object {
+struct Interface1 final : public compilets::Struct {
   Interface1() = default;
   Interface1(double n) : n(n) {}
 
   double n;
 };
 
-struct Interface2 : public compilets::Object {
-  Interface2() = default;
-  Interface2(Interface1* i) : i(i) {}
-
-  cppgc::Member<Interface1> i;
-
-  void Trace(cppgc::Visitor* visitor) const override {
-    compilets::TraceMember(visitor, i);
-  }
+struct Interface4 final : public compilets::Struct {
+  Interface4() = default;
+  Interface4(double m, double n) : m(m), n(n) {}
 
-  virtual ~Interface2() = default;
+  double m;
+  double n;
 };
 
-struct Interface3 : public compilets::Object {
-  Interface3() = default;
-  Interface3(compilets::Function<Interface1*()>* method, compilets::Function<double(Interface1*)>* func) : method(method), func(func) {}
-
-  cppgc::Member<compilets::Function<Interface1*()>> method;
-  cppgc::Member<compilets::Function<double(Interface1*)>> func;
-
-  void Trace(cppgc::Visitor* visitor) const override {
-    compilets::TraceMember(visitor, method);
-    compilets::TraceMember(visitor, func);
-  }
+struct Interface5 final : public compilets::Struct {
+  Interface5() = default;
+  Interface5(compilets::String name) : name(std::move(name)) {}
 
-  virtual ~Interface3() = default;
+  compilets::String name;
 };
 
-struct Interface4 : public compilets::Object {
-  Interface4() = default;
-  Interface4(double m, double n) : m(m), n(n) {}
+struct Interface2 final : public compilets::Object {
+  Interface2() = default;
+  Interface2(Interface1 i) : i(i) {}
 
-  double m;
-  double n;
+  Interface1 i;
 };
 
-struct Interface6 : public compilets::Object {
-  Interface6() = default;
-  Interface6(Interface5* obj) : obj(obj) {}
+struct Interface3 final : public compilets::Object {
+  Interface3() = default;
+  Interface3(compilets::Function<Interface1()>* method, compilets::Function<double(Interface1)>* func) : method(method), func(func) {}
 
-  cppgc::Member<Interface5> obj;
+  cppgc::Member<compilets::Function<Interface1()>> method;
+  cppgc::Member<compilets::Function<double(Interface1)>> func;
 
   void Trace(cppgc::Visitor* visitor) const override {
-    compilets::TraceMember(visitor, obj);
+    compilets::TraceMember(visitor, method);
+    compilets::TraceMember(visitor, func);
   }
 
-  virtual ~Interface6() = default;
+  ~Interface3() = default;
 };
 
-struct Interface5 : public compilets::Object {
-  Interface5() = default;
-  Interface5(compilets::String name) : name(std::move(name)) {}
+struct Interface6 final : public compilets::Object {
+  Interface6() = default;
+  Interface6(Interface5 obj) : obj(obj) {}
 
-  compilets::String name;
+  Interface5 obj;
 
-  virtual ~Interface5() = default;
+  ~Interface6() = default;
 };
 
 }  // namespace compilets::generated
@@ -75,15 +61,17 @@ struct Interface5 : public compilets::Object {
 namespace {
 
 void TestInterface() {
-  compilets::generated::Interface1* hasNumber = compilets::MakeObject<compilets::generated::Interface1>(1);
-  compilets::generated::Interface2* hasObject = compilets::MakeObject<compilets::generated::Interface2>(hasNumber);
-  compilets::generated::Interface3* hasFunction = compilets::MakeObject<compilets::generated::Interface3>(compilets::MakeFunction<compilets::generated::Interface1*()>([=]() -> compilets::generated::Interface1* {
+  compilets::generated::Interface1 hasNumber = compilets::generated::Interface1(1);
+  compilets::generated::Interface2 _hasObject_storage(hasNumber);
+  compilets::generated::Interface2* hasObject = &_hasObject_storage;
+  compilets::generated::Interface3* hasFunction = compilets::MakeObject<compilets::generated::Interface3>(compilets::MakeFunction<compilets::generated::Interface1()>([hasNumber]() -> compilets::generated::Interface1 {
     return hasNumber;
-  }, hasNumber), compilets::MakeFunction<double(compilets::generated::Interface1*)>([=](compilets::generated::Interface1* m) -> double {
-    return m->n;
+  }), compilets::MakeFunction<double(compilets::generated::Interface1)>([](compilets::generated::Interface1 m) -> double {
+    return m.n;
   }));
-  compilets::generated::Interface4* twoNumber = compilets::MakeObject<compilets::generated::Interface4>(89, 64);
-  compilets::generated::Interface6* hasLiteral = compilets::MakeObject<compilets::generated::Interface6>(compilets::MakeObject<compilets::generated::Interface5>(u"tiananmen"));
+  compilets::generated::Interface4 twoNumber = compilets::generated::Interface4(89, 64);
+  compilets::generated::Interface6 _hasLiteral_storage(compilets::generated::Interface5(u"tiananmen"));
+  compilets::generated::Interface6* hasLiteral = &_hasLiteral_storage;
 }
 
 }  // namespace
@@ -0,0 +1,50 @@
+#include "runtime/array.h"
+#include "runtime/json.h"
+#include "runtime/string.h"
+
+namespace compilets::generated {
+
+struct Interface1 final : public compilets::Struct {
+  Interface1() = default;
+  Interface1(double x, double y) : x(x), y(y) {}
+
+  double x;
+  double y;
+
+  static void VisitProperties(auto& self, auto&& visit) {
+    visit("x", self.x);
+    visit("y", self.y);
+  }
+};
+
+struct Interface2 final : public compilets::Object {
+  Interface2() = default;
+  Interface2(compilets::String name, compilets::Array<Interface1>* points) : name(std::move(name)), points(points) {}
+
+  compilets::String name;
+  cppgc::Member<compilets::Array<Interface1>> points;
+
+  void Trace(cppgc::Visitor* visitor) const override {
+    compilets::TraceMember(visitor, points);
+  }
+
+  ~Interface2() = default;
+
+  static void VisitProperties(auto& self, auto&& visit) {
+    visit("name", self.name);
+    visit("points", self.points);
+  }
+};
+
+}  // namespace compilets::generated
+
+namespace {
+
+void TestJSON(const compilets::String& text) {
+  compilets::generated::Interface2* shape = compilets::JSON::parse<compilets::generated::Interface2>(text);
+  compilets::Array<compilets::generated::Interface1>* points = compilets::JSON::parse<compilets::Array<compilets::generated::Interface1>>(text);
+  double count = compilets::JSON::parse<double>(u"1");
+  compilets::String json = compilets::JSON::stringify(shape);
+}
+
+}  // namespace
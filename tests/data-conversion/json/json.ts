@@ -0,0 +1,16 @@
+interface Point {
+  x: number;
+  y: number;
+}
+
+interface Shape {
+  name: string;
+  points: Point[];
+}
+
+function TestJSON(text: string) {
+  const shape = JSON.parse(text) as Shape;
+  const points: Point[] = JSON.parse(text);
+  const count = JSON.parse('1') as number;
+  const json = JSON.stringify(shape);
+}
@@ -0,0 +1,43 @@
+#include "runtime/map.h"
+#include "runtime/set.h"
+#include "runtime/string.h"
+
+namespace {
+
+class Item final : public compilets::Object {
+};
+
+class Registry final : public compilets::Object {
+ public:
+  cppgc::Member<compilets::Map<compilets::String, Item>> items = compilets::MakeObject<compilets::Map<compilets::String, Item>>();
+
+  void add(const compilets::String& name, Item* item) {
+    this->items->set(name, item);
+  }
+
+  void Trace(cppgc::Visitor* visitor) const override {
+    compilets::TraceMember(visitor, items);
+  }
+
+  ~Registry() = default;
+};
+
+void TestMap() {
+  compilets::Map<compilets::String, double>* map = compilets::MakeObject<compilets::Map<compilets::String, double>>();
+  map->set(u"a", 1)->set(u"b", 2);
+  compilets::Optional<double> a = map->get(u"a");
+  bool hasB = map->has(u"b");
+  map->erase(u"a");
+  double size = map->size;
+  map->clear();
+}
+
+void TestSet() {
+  compilets::Set<double>* set = compilets::MakeObject<compilets::Set<double>>();
+  set->add(1)->add(2);
+  bool hasOne = set->has(1);
+  set->erase(1);
+  double size = set->size;
+}
+
+}  // namespace
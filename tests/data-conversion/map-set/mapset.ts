@@ -0,0 +1,27 @@
+class Item {}
+
+class Registry {
+  items = new Map<string, Item>();
+
+  add(name: string, item: Item) {
+    this.items.set(name, item);
+  }
+}
+
+function TestMap() {
+  const map = new Map<string, number>();
+  map.set('a', 1).set('b', 2);
+  const a = map.get('a');
+  const hasB = map.has('b');
+  map.delete('a');
+  const size = map.size;
+  map.clear();
+}
+
+function TestSet() {
+  const set = new Set<number>();
+  set.add(1).add(2);
+  const hasOne = set.has(1);
+  set.delete(1);
+  const size = set.size;
+}
@@ -4,9 +4,9 @@ namespace {
 
 void TakeNumber(double n);
 
-class LinkNode : public compilets::Object {
+class LinkNode final : public compilets::Object {
  public:
-  std::optional<double> item;
+  compilets::Optional<double> item;
   cppgc::Member<LinkNode> next;
 
   LinkNode(double item) {
@@ -17,7 +17,7 @@ class LinkNode : public compilets::Object {
     compilets::TraceMember(visitor, next);
   }
 
-  virtual ~LinkNode() = default;
+  ~LinkNode() = default;
 };
 
 void TestQuestionTokenInClass() {
@@ -25,7 +25,7 @@ void TestQuestionTokenInClass() {
   if (!head->next) {
     head->next = compilets::MakeObject<LinkNode>(1);
   }
-  std::optional<double> i = head->item;
+  compilets::Optional<double> i = head->item;
   head->next->item = 3;
   TakeNumber(head->item.value());
   double n = true ? head->item.value() : 0;
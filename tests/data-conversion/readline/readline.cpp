@@ -0,0 +1,27 @@
+#include "runtime/array.h"
+#include "runtime/process.h"
+#include "runtime/promise.h"
+#include "runtime/readline.h"
+#include "runtime/runtime.h"
+#include "runtime/string.h"
+
+namespace readline = compilets::nodejs::readline;
+
+namespace {
+
+compilets::Promise<void>* TestReadline() {
+  cppgc::Persistent<readline::Interface> rl = readline::createInterface();
+  double count = 0;
+  for (compilets::String line : *rl) {
+    count += line.length;
+  }
+  rl->close();
+  co_return;
+}
+
+void TestArgv() {
+  compilets::Array<compilets::String>* args = compilets::nodejs::process->argv;
+  compilets::String first = compilets::nodejs::process->argv->value()[2];
+}
+
+}  // namespace
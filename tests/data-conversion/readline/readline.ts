@@ -0,0 +1,14 @@
+import * as readline from 'node:readline';
+
+async function TestReadline() {
+  const rl = readline.createInterface({input: process.stdin, crlfDelay: Infinity});
+  let count = 0;
+  for await (const line of rl)
+    count += line.length;
+  rl.close();
+}
+
+function TestArgv() {
+  const args: string[] = process.argv;
+  const first = process.argv[2];
+}
@@ -0,0 +1,28 @@
+#include "runtime/array.h"
+#include "runtime/record.h"
+#include "runtime/string.h"
+
+namespace {
+
+class Item final : public compilets::Object {
+};
+
+void TakeRecord(compilets::Record<Item>* record) {}
+
+void TestRecord() {
+  compilets::Record<double>* counts = compilets::MakeRecord<double>({{compilets::InternedString<u"one">(), 1}, {compilets::InternedString<u"two">(), 2}});
+  counts->at(compilets::InternedString<u"three">()) = 3;
+  counts->at(compilets::InternedString<u"one">()) += 10;
+  compilets::String key = u"two";
+  double two = counts->get(key);
+  if (counts->has(compilets::InternedString<u"one">())) counts->erase(compilets::InternedString<u"one">());
+  compilets::Array<compilets::String>* keys = compilets::ObjectConstructor::keys(counts);
+  compilets::Array<double>* values = compilets::ObjectConstructor::values(counts);
+  compilets::Record<bool>* flags = compilets::MakeRecord<bool>({});
+  flags->at(compilets::InternedString<u"enabled">()) = true;
+  compilets::Record<Item>* items = compilets::MakeRecord<Item>({});
+  items->at(compilets::InternedString<u"first">()) = compilets::MakeObject<Item>();
+  TakeRecord(items);
+}
+
+}  // namespace
@@ -0,0 +1,25 @@
+interface Dictionary {
+  [key: string]: boolean;
+}
+
+class Item {}
+
+function TakeRecord(record: Record<string, Item>) {}
+
+function TestRecord() {
+  const counts: Record<string, number> = {one: 1, 'two': 2};
+  counts['three'] = 3;
+  counts.one += 10;
+  const key = 'two';
+  const two = counts[key];
+  if ('one' in counts)
+    delete counts.one;
+  const keys = Object.keys(counts);
+  const values = Object.values(counts);
+
+  const flags: Dictionary = {};
+  flags['enabled'] = true;
+  const items: {[name: string]: Item} = {};
+  items['first'] = new Item();
+  TakeRecord(items);
+}
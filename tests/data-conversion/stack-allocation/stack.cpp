@@ -0,0 +1,45 @@
+#include "runtime/object.h"
+
+namespace {
+
+class Point final : public compilets::Object {
+ public:
+  double x;
+  double y;
+
+  Point(double x, double y) {
+    this->x = x;
+    this->y = y;
+  }
+};
+
+class Line final : public compilets::Object {
+ public:
+  cppgc::Member<Point> start;
+
+  Line(Point* start) {
+    this->start = start;
+  }
+
+  void Trace(cppgc::Visitor* visitor) const override {
+    compilets::TraceMember(visitor, start);
+  }
+
+  ~Line() = default;
+};
+
+void Keep(Point* point) {}
+
+void TestStackAllocation() {
+  Point _a_storage(1, 2);
+  Point* a = &_a_storage;
+  Point _b_storage(a->x, a->y);
+  Point* b = &_b_storage;
+  Point* escaped = compilets::MakeObject<Point>(3, 4);
+  Keep(escaped);
+  double sum = a->x + b->y;
+  Line* line = compilets::MakeObject<Line>(escaped);
+  double start = line->start->x;
+}
+
+}  // namespace
@@ -0,0 +1,28 @@
+class Point {
+  x: number;
+  y: number;
+
+  constructor(x: number, y: number) {
+    this.x = x;
+    this.y = y;
+  }
+}
+
+class Line {
+  start: Point;
+
+  constructor(start: Point) {
+    this.start = start;
+  }
+}
+
+function Keep(point: Point) {}
+
+function TestStackAllocation() {
+  const a = new Point(1, 2), b = new Point(a.x, a.y);
+  const escaped = new Point(3, 4);
+  Keep(escaped);
+  const sum = a.x + b.y;
+  const line = new Line(escaped);
+  const start = line.start.x;
+}
@@ -6,7 +6,7 @@
 
 namespace {
 
-void TakeString(compilets::String str) {}
+void TakeString(const compilets::String& str) {}
 
 void TestString() {
   compilets::String str = u"string";
@@ -16,11 +16,11 @@ void TestString() {
   TakeString(str);
   TakeString(u"literal");
   compilets::nodejs::console->log(str, u"literal");
-  std::optional<compilets::String> optionalStr;
+  compilets::Optional<compilets::String> optionalStr;
   optionalStr = str;
   str = optionalStr.value();
   compilets::Union<compilets::String, double> unionString = u"unionString";
-  str = std::get<compilets::String>(unionString);
+  str = compilets::Get<compilets::String>(unionString);
   double strLength = str.length;
   double literalLength = compilets::String(u"literal").length;
   compilets::String charactar = str[0];
@@ -31,4 +31,18 @@ void TestString() {
   compilets::String addLiteralToNumber = compilets::StringBuilder().Append(123).Append(u"456").Take();
 }
 
+compilets::String AppendSuffix(compilets::String str) {
+  str = compilets::StringBuilder().Append(str).Append(u"suffix").Take();
+  return str;
+}
+
+void TestLastUse() {
+  compilets::String value = u"value";
+  compilets::String copied = value;
+  compilets::String moved = AppendSuffix(std::move(copied));
+  moved = AppendSuffix(moved);
+  TakeString(value);
+  TakeString(moved);
+}
+
 }  // namespace
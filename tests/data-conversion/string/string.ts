@@ -32,3 +32,17 @@ function TestString() {
 
   let addLiteralToNumber = 123 + "456";
 }
+
+function AppendSuffix(str: string) {
+  str = str + "suffix";
+  return str;
+}
+
+function TestLastUse() {
+  let value = "value";
+  let copied = value;
+  let moved = AppendSuffix(copied);
+  moved = AppendSuffix(moved);
+  TakeString(value);
+  TakeString(moved);
+}
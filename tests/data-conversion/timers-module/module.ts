@@ -0,0 +1,3 @@
+export function Wait(callback: () => void) {
+  setTimeout(callback, 100);
+}
@@ -3,7 +3,7 @@
 
 namespace {
 
-class LinkNode : public compilets::Object {
+class LinkNode final : public compilets::Object {
  public:
   compilets::Union<std::monostate, double, bool> item;
   cppgc::Member<LinkNode> next;
@@ -12,12 +12,12 @@ class LinkNode : public compilets::Object {
     compilets::TraceMember(visitor, next);
   }
 
-  virtual ~LinkNode() = default;
+  ~LinkNode() = default;
 };
 
 void TestUndefined() {
   std::nullopt_t undef = std::nullopt;
-  std::optional<double> orUndefined = 123;
+  compilets::Optional<double> orUndefined = 123;
   orUndefined = std::nullopt;
   orUndefined = std::nullopt;
   compilets::Union<compilets::Null, double> orNull;
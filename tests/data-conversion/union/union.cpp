@@ -21,9 +21,9 @@ void TestUnion() {
   compilets::Union<double, bool> nb = ReturnUnion();
   bn = ReturnUnion();
   bn = nb;
-  bool b = std::get<bool>(bn);
-  TakeNumber(std::get<double>(bn));
-  double numberCast = std::get<double>(bn);
+  bool b = compilets::Get<bool>(bn);
+  TakeNumber(compilets::Get<double>(bn));
+  double numberCast = compilets::Get<double>(bn);
 }
 
 }  // namespace
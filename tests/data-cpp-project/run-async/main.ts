@@ -0,0 +1,37 @@
+function sleep(ms: number) {
+  return new Promise<void>((resolve) => {
+    setTimeout(resolve, ms);
+  });
+}
+
+async function worker(log: number[], id: number, delay: number) {
+  for (let i = 0; i < 2; ++i) {
+    await sleep(delay);
+    log.push(id);
+  }
+  return id * 10;
+}
+
+async function run(log: number[]) {
+  const first = worker(log, 1, 10);
+  const second = worker(log, 2, 15);
+  const sum = await first + await second;
+  // Resolved promises and plain values do not wait for timers.
+  const value = await Promise.resolve(3) + await 4;
+  log.push(sum, value);
+}
+
+const log: number[] = [];
+run(log);
+
+let ticks = 0;
+const interval = setInterval(() => { ++ticks; }, 5);
+const timeout = setTimeout(() => { process.exit(3); }, 1000);
+setTimeout(() => {
+  clearInterval(interval);
+  clearTimeout(timeout);
+  if (log.join() != '1,2,1,2,30,7' || ticks == 0) {
+    console.error('async:', log.join(), ticks);
+    process.exit(1);
+  }
+}, 500);
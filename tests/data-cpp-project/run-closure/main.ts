@@ -6,9 +6,17 @@ function Add(i: number) {
   return i + 1;
 }
 
+function Counter() {
+  let count = 0;
+  const increase = () => ++count;
+  return increase;
+}
+
 const wrapped = Wrap(Add, 8963);
 const result = wrapped();
-if (result == 8964)
+const counter = Counter();
+counter();
+if (result == 8964 && counter() == 2)
   process.exit(0);
 else
   process.exit(1);
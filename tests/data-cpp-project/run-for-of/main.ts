@@ -0,0 +1,47 @@
+const numbers = [1, 2, 3];
+let sum = 0;
+for (const n of numbers)
+  sum += n;
+if (sum != 6) {
+  console.error('array sum:', sum);
+  process.exit(1);
+}
+
+// Elements pushed during the loop are visited, as the length is read again.
+for (const n of numbers) {
+  if (n < 3)
+    numbers.push(n + 10);
+}
+if (numbers.length != 5 || numbers[4] != 12) {
+  console.error('array push in loop:', numbers.length);
+  process.exit(2);
+}
+
+let chars = 0;
+for (const c of 'a\u{1F600}b')
+  chars++;
+if (chars != 3) {
+  console.error('string code points:', chars);
+  process.exit(3);
+}
+
+const map = new Map<string, number>();
+map.set('a', 1).set('b', 2).set('c', 3);
+let keys = '';
+for (const [key, value] of map) {
+  keys = `${keys}${key}${value}`;
+  map.delete('b');
+  if (key == 'a')
+    map.set('d', 4);
+}
+if (keys != 'a1c3d4') {
+  console.error('map entries:', keys);
+  process.exit(4);
+}
+
+const set = new Set<number>();
+set.add(3).add(1).add(2);
+let order = 0;
+for (const value of set)
+  order = order * 10 + value;
+process.exit(order == 312 ? 0 : 5);
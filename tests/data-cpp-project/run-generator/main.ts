@@ -0,0 +1,47 @@
+function* Range(n: number) {
+  for (let i = 0; i < n; ++i) {
+    yield i;
+  }
+}
+
+function* Filter(values: Generator<number>, divisor: number) {
+  for (const value of values) {
+    if (value % divisor == 0)
+      yield value;
+  }
+}
+
+let sum = 0;
+for (const value of Filter(Range(10), 3))
+  sum += value;
+if (sum != 18) {
+  console.error('generator pipeline:', sum);
+  process.exit(1);
+}
+
+class Item {
+  value: number;
+
+  constructor(value: number) {
+    this.value = value;
+  }
+}
+
+function* Items(count: number) {
+  const first = new Item(1);
+  for (let i = 0; i < count; ++i) {
+    // Objects referenced by the suspended frame must survive GC.
+    gc!();
+    yield new Item(first.value + i);
+  }
+}
+
+function* Twice(count: number) {
+  yield* Items(count);
+  yield* Items(count);
+}
+
+let total = 0;
+for (const item of Twice(3))
+  total += item.value;
+process.exit(total == 12 ? 0 : 2);
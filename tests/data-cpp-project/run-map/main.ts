@@ -0,0 +1,52 @@
+const map = new Map<string, number>();
+map.set('a', 1).set('b', 2).set('a', 3);
+if (map.size != 2 || map.get('a') != 3) {
+  console.error('map set:', map.size, map.get('a'));
+  process.exit(1);
+}
+
+if (map.get('c') !== undefined || map.has('c')) {
+  console.error('map missing key');
+  process.exit(2);
+}
+
+if (!map.delete('a') || map.delete('a') || map.has('a') || map.size != 1) {
+  console.error('map delete');
+  process.exit(3);
+}
+
+const numbers = new Set<number>();
+for (let i = 0; i < 100000; ++i)
+  numbers.add(i % 1000);
+if (numbers.size != 1000 || !numbers.has(999) || numbers.has(1000)) {
+  console.error('set add:', numbers.size);
+  process.exit(4);
+}
+
+numbers.add(0 / 0).add(0 / 0).add(-0);
+if (numbers.size != 1001 || !numbers.has(0 / 0)) {
+  console.error('set SameValueZero:', numbers.size);
+  process.exit(5);
+}
+
+class Item {
+  static count = 0;
+
+  // compilets: destructor
+  destructor() {
+    Item.count++;
+  }
+}
+
+// compilets: persistent
+const items = new Map<number, Item>();
+items.set(1, new Item());
+gc!();
+if (Item.count != 0) {
+  console.error('map value collected');
+  process.exit(6);
+}
+
+items.delete(1);
+gc!();
+process.exit(Item.count == 1 ? 0 : 7);
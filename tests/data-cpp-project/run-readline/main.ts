@@ -0,0 +1,14 @@
+import * as readline from 'node:readline';
+
+async function readLines() {
+  const rl = readline.createInterface({input: process.stdin});
+  const lines: string[] = [];
+  for await (const line of rl)
+    lines.push(line);
+  if (lines.length != 3 || lines[0] != 'first' || lines[1] != '' || lines[2] != 'café')
+    process.exit(1);
+}
+
+if (process.argv.length != 2)
+  process.exit(2);
+readLines();
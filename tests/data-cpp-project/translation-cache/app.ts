@@ -0,0 +1,5 @@
+import {Shape} from './shape';
+import {add} from './math';
+
+const shape = new Shape();
+shape.points.push({x: add(1, 2), y: 0});
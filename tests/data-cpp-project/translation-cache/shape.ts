@@ -0,0 +1,8 @@
+export interface Point {
+  x: number;
+  y: number;
+}
+
+export class Shape {
+  points: Point[] = [];
+}
@@ -0,0 +1,26 @@
+export function sum(bytes: Uint8Array) {
+  let total = 0;
+  for (let i = 0; i < bytes.length; ++i)
+    total += bytes[i];
+  return total;
+}
+
+export function invert(bytes: Uint8Array) {
+  for (let i = 0; i < bytes.length; ++i)
+    bytes[i] = 255 - bytes[i];
+}
+
+export function createBuffer(size: number) {
+  const buffer = Buffer.alloc(size);
+  for (let i = 0; i < size; ++i)
+    buffer[i] = i;
+  return buffer;
+}
+
+export function getArrayBuffer(bytes: Uint8Array) {
+  return bytes.buffer;
+}
+
+export function skipFirst(buffer: Buffer) {
+  return buffer.subarray(1);
+}
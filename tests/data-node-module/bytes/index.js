@@ -0,0 +1,22 @@
+const assert = require('node:assert');
+const {sum, invert, createBuffer, getArrayBuffer, skipFirst} = require(process.argv[2]);
+
+const bytes = new Uint8Array([1, 2, 3]);
+assert.strictEqual(sum(bytes), 6);
+assert.strictEqual(sum(Buffer.from('abc')), 294);
+
+// The memory is shared with native code without copying.
+invert(bytes.subarray(1));
+assert.deepStrictEqual(Array.from(bytes), [1, 253, 252]);
+assert.strictEqual(getArrayBuffer(bytes), bytes.buffer);
+
+const buffer = createBuffer(4);
+assert.ok(Buffer.isBuffer(buffer));
+assert.deepStrictEqual(Array.from(buffer), [0, 1, 2, 3]);
+
+// Buffers coming from JS are returned as views of the same memory.
+const text = Buffer.from('hello');
+const rest = skipFirst(text);
+assert.ok(Buffer.isBuffer(rest));
+assert.strictEqual(rest.buffer, text.buffer);
+assert.strictEqual(rest.toString(), 'ello');